@@ -5757,6 +5757,9 @@ int _ipa_init_hdr_v3_0(void)
 	int num_cmds = 0;
 	int i;
 
+	/* the apps SRAM header table is zeroed below, rewrite it on commit */
+	ipa3_hdr_lcl_tbl_invalidate();
+
 	mem.size = IPA_MEM_PART(modem_hdr_size) + IPA_MEM_PART(apps_hdr_size);
 	mem.base = dma_alloc_coherent(ipa3_ctx->pdev, mem.size, &mem.phys_base,
 		GFP_KERNEL);
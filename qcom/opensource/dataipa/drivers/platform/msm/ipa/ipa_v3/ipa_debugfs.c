@@ -3976,6 +3976,8 @@ void ipa3_debugfs_init(void)
 	debugfs_create_u32("clk_rate", IPA_READ_ONLY_MODE,
 		dent, &ipa3_ctx->curr_ipa_clk_rate);
 
+	ipa_pm_debugfs_init_predict(dent);
+
 	ipa_debugfs_init_stats(dent);
 
 	ipa3_wigig_init_debugfs_i(dent);
@@ -98,6 +98,12 @@
 
 #define IPA_SEND_MAX_DESC (20)
 
+/* scratch descriptors for non-linear skb tx, used with BH disabled */
+struct ipa3_tx_desc_cache {
+	struct ipa3_desc desc[IPA_SEND_MAX_DESC];
+};
+static DEFINE_PER_CPU(struct ipa3_tx_desc_cache, ipa3_tx_desc_cache);
+
 #define IPA_EOT_THRESH 32
 
 #define IPA_QMAP_ID_BYTE 0
@@ -624,6 +630,7 @@ int ipa3_send(struct ipa3_sys_context *sys,
 	u32 mem_flag = GFP_ATOMIC;
 	const struct ipa_gsi_ep_config *gsi_ep_cfg;
 	bool send_nop = false;
+	bool ring_db = true;
 	unsigned int max_desc;
 
 	if (unlikely(!in_atomic))
@@ -776,6 +783,14 @@ int ipa3_send(struct ipa3_sys_context *sys,
 			} else {
 				send_nop = true;
 			}
+			/*
+			 * caller expects another send shortly, leave the
+			 * doorbell to it; the NOP timer rings it otherwise
+			 */
+			if (desc[i].skip_db_ring && sys->db_defer) {
+				ring_db = false;
+				send_nop = true;
+			}
 			gsi_xfer[i].xfer_user_data =
 				tx_pkt_first;
 		} else {
@@ -786,7 +801,7 @@ int ipa3_send(struct ipa3_sys_context *sys,
 
 	IPADBG_LOW("ch:%lu queue xfer\n", sys->ep->gsi_chan_hdl);
 	result = gsi_queue_xfer(sys->ep->gsi_chan_hdl, num_desc,
-			gsi_xfer, true);
+			gsi_xfer, ring_db);
 	if (result != GSI_STATUS_SUCCESS) {
 		IPAERR_RL("GSI xfer failed.\n");
 		result = -EFAULT;
@@ -2255,6 +2270,9 @@ void ipa3_tx_cmd_comp(void *user1, int user2)
 	ipahal_destroy_imm_cmd(user1);
 }
 
+static int __ipa3_tx_dp(enum ipa_client_type dst, struct sk_buff *skb,
+		struct ipa_tx_meta *meta, bool xmit_more);
+
 /**
  * ipa3_tx_dp() - Data-path tx handler
  * @dst:	[in] which IPA destination to route tx packets to
@@ -2281,6 +2299,31 @@ void ipa3_tx_cmd_comp(void *user1, int user2)
  */
 int ipa3_tx_dp(enum ipa_client_type dst, struct sk_buff *skb,
 		struct ipa_tx_meta *meta)
+{
+	return __ipa3_tx_dp(dst, skb, meta, false);
+}
+
+/**
+ * ipa3_tx_dp_more() - Data-path tx handler with doorbell batching
+ * @dst:	[in] which IPA destination to route tx packets to
+ * @skb:	[in] the packet to send
+ * @metadata:	[in] TX packet meta-data
+ * @xmit_more:	[in] caller has more packets queued for the same pipe
+ *
+ * Same as ipa3_tx_dp(), but when xmit_more is set the GSI doorbell is not
+ * rung for this packet. The next send on the pipe rings it, and the NOP
+ * timer does if none follows. Pipes without a NOP work ignore the hint.
+ *
+ * Returns:	0 on success, negative on failure
+ */
+int ipa3_tx_dp_more(enum ipa_client_type dst, struct sk_buff *skb,
+		struct ipa_tx_meta *meta, bool xmit_more)
+{
+	return __ipa3_tx_dp(dst, skb, meta, xmit_more);
+}
+
+static int __ipa3_tx_dp(enum ipa_client_type dst, struct sk_buff *skb,
+		struct ipa_tx_meta *meta, bool xmit_more)
 {
 	struct ipa3_desc *desc;
 	struct ipa3_desc _desc[3];
@@ -2354,7 +2397,7 @@ int ipa3_tx_dp(enum ipa_client_type dst, struct sk_buff *skb,
 	if (gsi_ep->prefetch_mode == GSI_SMART_PRE_FETCH ||
 		gsi_ep->prefetch_mode == GSI_FREE_PRE_FETCH)
 		max_desc -= gsi_ep->prefetch_threshold;
-	if (num_frags + 3 > max_desc) {
+	if (num_frags + 3 > max_desc || num_frags + 3 > IPA_SEND_MAX_DESC) {
 		if (skb_linearize(skb)) {
 			IPAERR("Failed to linear skb with %d frags\n",
 				num_frags);
@@ -2368,11 +2411,9 @@ int ipa3_tx_dp(enum ipa_client_type dst, struct sk_buff *skb,
 		 * 1 desc may be needed for the PACKET_INIT;
 		 * 1 desc for each frag
 		 */
-		desc = kzalloc(sizeof(*desc) * (num_frags + 3), GFP_ATOMIC);
-		if (!desc) {
-			IPAERR("failed to alloc desc array\n");
-			goto fail_gen;
-		}
+		local_bh_disable();
+		desc = this_cpu_ptr(&ipa3_tx_desc_cache)->desc;
+		memset(desc, 0, sizeof(*desc) * (num_frags + 3));
 	} else {
 		memset(_desc, 0, 3 * sizeof(struct ipa3_desc));
 		desc = &_desc[0];
@@ -2454,6 +2495,7 @@ int ipa3_tx_dp(enum ipa_client_type dst, struct sk_buff *skb,
 			desc[skb_idx].callback = NULL;
 		}
 
+		desc[num_frags + data_idx - 1].skip_db_ring = xmit_more;
 		if (ipa3_send(sys, num_frags + data_idx, desc, true)) {
 			IPAERR_RL("fail to send skb %pK num_frags %u SWP\n",
 				skb, num_frags);
@@ -2485,6 +2527,7 @@ int ipa3_tx_dp(enum ipa_client_type dst, struct sk_buff *skb,
 			desc[data_idx].dma_address = meta->dma_address;
 		}
 		if (num_frags == 0) {
+			desc[data_idx].skip_db_ring = xmit_more;
 			if (ipa3_send(sys, data_idx + 1, desc, true)) {
 				IPAERR_RL("fail to send skb %pK HWP\n", skb);
 				goto fail_mem;
@@ -2503,6 +2546,7 @@ int ipa3_tx_dp(enum ipa_client_type dst, struct sk_buff *skb,
 			desc[data_idx+f].user1 = desc[data_idx].user1;
 			desc[data_idx+f].user2 = desc[data_idx].user2;
 			desc[data_idx].callback = NULL;
+			desc[data_idx+f].skip_db_ring = xmit_more;
 
 			if (ipa3_send(sys, num_frags + data_idx + 1,
 				desc, true)) {
@@ -2516,7 +2560,7 @@ int ipa3_tx_dp(enum ipa_client_type dst, struct sk_buff *skb,
 
 	trace_ipa3_tx_done(sys->ep->client);
 	if (num_frags) {
-		kfree(desc);
+		local_bh_enable();
 		IPA_STATS_INC_CNT(ipa3_ctx->stats.tx_non_linear);
 	}
 	return 0;
@@ -2524,7 +2568,7 @@ int ipa3_tx_dp(enum ipa_client_type dst, struct sk_buff *skb,
 fail_send:
 fail_mem:
 	if (num_frags)
-		kfree(desc);
+		local_bh_enable();
 fail_gen:
 	return -EFAULT;
 fail_pipe_not_valid:
@@ -5654,6 +5698,7 @@ static int ipa3_assign_policy(struct ipa_sys_connect_params *in,
 			sys->use_comm_evt_ring = true;
 		INIT_WORK(&sys->work, ipa3_send_nop_desc);
 		atomic_set(&sys->workqueue_flushed, 0);
+		sys->db_defer = true;
 
 		/*
 		 * enable source notification status for exception packets
@@ -5688,6 +5733,7 @@ static int ipa3_assign_policy(struct ipa_sys_connect_params *in,
 			sys->use_comm_evt_ring = true;
 			INIT_WORK(&sys->work, ipa3_send_nop_desc);
 			atomic_set(&sys->workqueue_flushed, 0);
+			sys->db_defer = true;
 		}
 	} else {
 		if (IPA_CLIENT_IS_LAN_CONS(in->client) ||
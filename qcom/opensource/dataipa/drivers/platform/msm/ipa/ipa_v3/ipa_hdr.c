@@ -16,6 +16,147 @@ static const u32 ipa_hdr_proc_ctx_bin_sz[IPA_HDR_PROC_CTX_BIN_MAX] = { 32, 64};
 #define HDR_PROC_TYPE_IS_VALID(type) \
 	((type) >= 0 && (type) < IPA_HDR_PROC_MAX)
 
+/* SRAM partial updates start on an 8B boundary */
+#define IPA_HDR_LCL_DMA_ALIGN 8
+
+/**
+ * __ipa_hdr_get_free_offset() - take a free slot from the header table
+ * @htbl:	[in] header table to allocate from
+ * @bin:	[in] smallest bin that fits the header
+ * @best_fit:	[in] fall back to free slots of larger bins
+ *
+ * Returns:	offset entry moved to the used list, NULL if none is free
+ */
+static struct ipa_hdr_offset_entry *__ipa_hdr_get_free_offset(
+	struct ipa3_hdr_tbl *htbl, u32 bin, bool best_fit)
+{
+	struct ipa_hdr_offset_entry *offset;
+	u32 i;
+
+	for (i = bin; i < IPA_HDR_BIN_MAX; i++) {
+		if (!list_empty(&htbl->head_free_offset_list[i])) {
+			offset = list_first_entry(&htbl->head_free_offset_list[i],
+				struct ipa_hdr_offset_entry, link);
+			list_move(&offset->link, &htbl->head_offset_list[i]);
+			return offset;
+		}
+		if (!best_fit)
+			break;
+	}
+
+	return NULL;
+}
+
+/**
+ * __ipa_hdr_put_offset() - return a slot to the header table free lists
+ * @htbl:	[in] header table owning the slot
+ * @offset:	[in] slot to release
+ *
+ * Free slots which end up at the tail of the table are coalesced back into
+ * the unallocated area so that any bin may reuse that space.
+ */
+static void __ipa_hdr_put_offset(struct ipa3_hdr_tbl *htbl,
+	struct ipa_hdr_offset_entry *offset)
+{
+	struct ipa_hdr_offset_entry *tail;
+	bool trimmed;
+	u32 i;
+
+	list_move(&offset->link, &htbl->head_free_offset_list[offset->bin]);
+
+	do {
+		trimmed = false;
+		for (i = 0; i < IPA_HDR_BIN_MAX && !trimmed; i++) {
+			list_for_each_entry(tail,
+				&htbl->head_free_offset_list[i], link) {
+				if (tail->offset + ipa_hdr_bin_sz[i] !=
+					htbl->end)
+					continue;
+				htbl->end = tail->offset;
+				list_del(&tail->link);
+				kmem_cache_free(ipa3_ctx->hdr_offset_cache,
+					tail);
+				trimmed = true;
+				break;
+			}
+		}
+	} while (trimmed);
+}
+
+static void __ipa_hdr_tbl_mark_dirty(struct ipa3_hdr_tbl *htbl,
+	u32 start, u32 len)
+{
+	if (htbl->dirty_start >= htbl->dirty_end) {
+		htbl->dirty_start = start;
+		htbl->dirty_end = start + len;
+		return;
+	}
+
+	htbl->dirty_start = min_t(u32, htbl->dirty_start, start);
+	htbl->dirty_end = max_t(u32, htbl->dirty_end, start + len);
+}
+
+static struct ipa3_hdr_proc_ctx_offset_entry *__ipa_proc_ctx_get_free_offset(
+	struct ipa3_hdr_proc_ctx_tbl *htbl, u32 bin, bool best_fit)
+{
+	struct ipa3_hdr_proc_ctx_offset_entry *offset;
+	u32 i;
+
+	for (i = bin; i < IPA_HDR_PROC_CTX_BIN_MAX; i++) {
+		if (!list_empty(&htbl->head_free_offset_list[i])) {
+			offset = list_first_entry(&htbl->head_free_offset_list[i],
+				struct ipa3_hdr_proc_ctx_offset_entry, link);
+			list_move(&offset->link, &htbl->head_offset_list[i]);
+			return offset;
+		}
+		if (!best_fit)
+			break;
+	}
+
+	return NULL;
+}
+
+static void __ipa_proc_ctx_put_offset(struct ipa3_hdr_proc_ctx_tbl *htbl,
+	struct ipa3_hdr_proc_ctx_offset_entry *offset)
+{
+	struct ipa3_hdr_proc_ctx_offset_entry *tail;
+	bool trimmed;
+	u32 i;
+
+	list_move(&offset->link, &htbl->head_free_offset_list[offset->bin]);
+
+	do {
+		trimmed = false;
+		for (i = 0; i < IPA_HDR_PROC_CTX_BIN_MAX && !trimmed; i++) {
+			list_for_each_entry(tail,
+				&htbl->head_free_offset_list[i], link) {
+				if (tail->offset + ipa_hdr_proc_ctx_bin_sz[i] !=
+					htbl->end)
+					continue;
+				htbl->end = tail->offset;
+				list_del(&tail->link);
+				kmem_cache_free(
+					ipa3_ctx->hdr_proc_ctx_offset_cache,
+					tail);
+				trimmed = true;
+				break;
+			}
+		}
+	} while (trimmed);
+}
+
+/**
+ * ipa3_hdr_lcl_tbl_invalidate() - force the next commit to rewrite the
+ * whole SRAM header table, e.g. after the partition was re-initialized
+ */
+void ipa3_hdr_lcl_tbl_invalidate(void)
+{
+	struct ipa3_hdr_tbl *htbl = &ipa3_ctx->hdr_tbl[HDR_TBL_LCL];
+
+	htbl->dirty_start = 0;
+	htbl->dirty_end = U32_MAX;
+}
+
 /**
  * ipa3_generate_hdr_hw_tbl() - generates the headers table
  * @loc:	[in] storage type of the header table buffer (local or system)
@@ -29,6 +170,9 @@ static int ipa3_generate_hdr_hw_tbl(enum hdr_tbl_storage loc, struct ipa_mem_buf
 	gfp_t flag = GFP_KERNEL;
 
 	mem->size = (ipa3_ctx->hdr_tbl[loc].end) ? ipa3_ctx->hdr_tbl[loc].end : ipa_hdr_bin_sz[0];
+	/* SRAM updates are DMA'd in aligned chunks, cover the last one */
+	if (loc == HDR_TBL_LCL)
+		mem->size = round_up(mem->size, IPA_HDR_LCL_DMA_ALIGN);
 
 	if (mem->size == 0) {
 		IPAERR("%s hdr tbl empty\n", loc == HDR_TBL_LCL ? "SRAM" : "DDR");
@@ -195,6 +339,8 @@ int __ipa_commit_hdr_v3_0(void)
 	struct ipahal_imm_cmd_register_write reg_write_coal_close;
 	struct ipahal_reg_valmask valmask;
 	enum hdr_tbl_storage loc;
+	struct ipa3_hdr_tbl *lcl_tbl = &ipa3_ctx->hdr_tbl[HDR_TBL_LCL];
+	u32 dirty_start = 0, dirty_end = 0;
 
 	memset(desc, 0, 3 * sizeof(struct ipa3_desc));
 
@@ -203,6 +349,11 @@ int __ipa_commit_hdr_v3_0(void)
 		hdr_tbl_size = (loc == HDR_TBL_LCL) ?
 			IPA_MEM_PART(apps_hdr_size) : IPA_MEM_PART(apps_hdr_size_ddr);
 
+		/* SRAM keeps its contents, skip it if nothing was written */
+		if (loc == HDR_TBL_LCL &&
+			lcl_tbl->dirty_start >= lcl_tbl->dirty_end)
+			continue;
+
 		if (hdr_tbl_size) {
 			if (ipa3_generate_hdr_hw_tbl(loc, &hdr_mem[loc])) {
 				IPAERR("fail to generate %s HDR HW TBL\n",
@@ -248,16 +399,28 @@ int __ipa_commit_hdr_v3_0(void)
 		++num_cmd;
 	}
 
-	/* Local (SRAM) header table configuration */
-	if (IPA_MEM_PART(apps_hdr_size)) {
+	/* Local (SRAM) header table configuration, only the dirty range */
+	if (hdr_mem[HDR_TBL_LCL].base) {
+		dirty_end = min_t(u32, lcl_tbl->dirty_end,
+			hdr_mem[HDR_TBL_LCL].size);
+		dirty_end = min_t(u32, round_up(dirty_end,
+			IPA_HDR_LCL_DMA_ALIGN), hdr_mem[HDR_TBL_LCL].size);
+		dirty_start = round_down(lcl_tbl->dirty_start,
+			IPA_HDR_LCL_DMA_ALIGN);
+	}
+
+	if (dirty_start < dirty_end) {
+		IPADBG_LOW("SRAM hdr tbl update ofst=%u size=%u\n",
+			dirty_start, dirty_end - dirty_start);
 		dma_cmd_hdr.is_read = false; /* write operation */
 		dma_cmd_hdr.skip_pipeline_clear = false;
 		dma_cmd_hdr.pipeline_clear_options = IPAHAL_HPS_CLEAR;
-		dma_cmd_hdr.system_addr = hdr_mem[HDR_TBL_LCL].phys_base;
-		dma_cmd_hdr.size = hdr_mem[HDR_TBL_LCL].size;
+		dma_cmd_hdr.system_addr = hdr_mem[HDR_TBL_LCL].phys_base +
+			dirty_start;
+		dma_cmd_hdr.size = dirty_end - dirty_start;
 		dma_cmd_hdr.local_addr =
 			ipa3_ctx->smem_restricted_bytes +
-			IPA_MEM_PART(apps_hdr_ofst);
+			IPA_MEM_PART(apps_hdr_ofst) + dirty_start;
 		hdr_cmd_pyld[HDR_TBL_LCL] = ipahal_construct_imm_cmd(IPA_IMM_CMD_DMA_SHARED_MEM,
 								     &dma_cmd_hdr, false);
 		if (!hdr_cmd_pyld[HDR_TBL_LCL]) {
@@ -267,9 +430,9 @@ int __ipa_commit_hdr_v3_0(void)
 
 		ipa3_init_imm_cmd_desc(&desc[num_cmd], hdr_cmd_pyld[HDR_TBL_LCL]);
 		++num_cmd;
-		IPA_DUMP_BUFF(hdr_mem[HDR_TBL_LCL].base,
-			      hdr_mem[HDR_TBL_LCL].phys_base,
-			      hdr_mem[HDR_TBL_LCL].size);
+		IPA_DUMP_BUFF(hdr_mem[HDR_TBL_LCL].base + dirty_start,
+			      hdr_mem[HDR_TBL_LCL].phys_base + dirty_start,
+			      dirty_end - dirty_start);
 
 	}
 
@@ -359,6 +522,11 @@ int __ipa_commit_hdr_v3_0(void)
 	else
 		rc = 0;
 
+	if (!rc && hdr_mem[HDR_TBL_LCL].base) {
+		lcl_tbl->dirty_start = 0;
+		lcl_tbl->dirty_end = 0;
+	}
+
 	if (!rc && hdr_mem[HDR_TBL_SYS].base) {
 		if (ipa3_ctx->hdr_sys_mem.phys_base) {
 			dma_free_coherent(ipa3_ctx->pdev,
@@ -493,7 +661,9 @@ static int __ipa_add_hdr_proc_ctx(struct ipa_hdr_proc_ctx_add *proc_ctx,
 	mem_size = (ipa3_ctx->hdr_proc_ctx_tbl_lcl) ?
 		IPA_MEM_PART(apps_hdr_proc_ctx_size) :
 		IPA_MEM_PART(apps_hdr_proc_ctx_size_ddr);
-	if (list_empty(&htbl->head_free_offset_list[bin])) {
+	offset = __ipa_proc_ctx_get_free_offset(htbl, bin,
+		htbl->end + ipa_hdr_proc_ctx_bin_sz[bin] > mem_size);
+	if (!offset) {
 		if (htbl->end + ipa_hdr_proc_ctx_bin_sz[bin] > mem_size) {
 			IPAERR_RL("hdr proc ctx table overflow\n");
 			goto bad_len;
@@ -512,18 +682,11 @@ static int __ipa_add_hdr_proc_ctx(struct ipa_hdr_proc_ctx_add *proc_ctx,
 		 */
 		offset->offset = htbl->end;
 		offset->bin = bin;
-		offset->ipacm_installed = user_only;
 		htbl->end += ipa_hdr_proc_ctx_bin_sz[bin];
 		list_add(&offset->link,
 				&htbl->head_offset_list[bin]);
-	} else {
-		/* get the first free slot */
-		offset =
-		    list_first_entry(&htbl->head_free_offset_list[bin],
-				struct ipa3_hdr_proc_ctx_offset_entry, link);
-		offset->ipacm_installed = user_only;
-		list_move(&offset->link, &htbl->head_offset_list[bin]);
 	}
+	offset->ipacm_installed = user_only;
 
 	entry->offset_entry = offset;
 	list_add(&entry->link, &htbl->head_proc_ctx_entry_list);
@@ -544,8 +707,7 @@ static int __ipa_add_hdr_proc_ctx(struct ipa_hdr_proc_ctx_add *proc_ctx,
 	return 0;
 
 ipa_insert_failed:
-	list_move(&offset->link,
-		&htbl->head_free_offset_list[offset->bin]);
+	__ipa_proc_ctx_put_offset(htbl, offset);
 	entry->offset_entry = NULL;
 	list_del(&entry->link);
 	htbl->proc_ctx_cnt--;
@@ -640,46 +802,33 @@ static int __ipa_add_hdr(struct ipa_hdr_add *hdr, bool user,
 	htbl = entry->is_lcl ? &ipa3_ctx->hdr_tbl[HDR_TBL_LCL] : &ipa3_ctx->hdr_tbl[HDR_TBL_SYS];
 	mem_size = entry->is_lcl ? IPA_MEM_PART(apps_hdr_size) : IPA_MEM_PART(apps_hdr_size_ddr);
 
-	if (list_empty(&htbl->head_free_offset_list[bin])) {
-		/*
-		 * In case of a local header entry,
-		 * first iteration will check against SRAM partition space,
-		 * and the second iteration will check against DDR partition space.
-		 * In case of a system header entry, the loop will iterate only once,
-		 * and check against DDR partition space.
-		 */
-		while (htbl->end + ipa_hdr_bin_sz[bin] > mem_size) {
-			if (entry->is_lcl) {
-				/* if header does not fit to SRAM table, place it in DDR */
-				IPADBG_LOW("SRAM header table was full allocting DDR header table! Requested: %d Left: %d name %s, end %d\n",
-						ipa_hdr_bin_sz[bin], mem_size - htbl->end, entry->name, htbl->end);
-				htbl = &ipa3_ctx->hdr_tbl[HDR_TBL_SYS];
-				mem_size = IPA_MEM_PART(apps_hdr_size_ddr);
-				entry->is_lcl = false;
-			}
-
-			/* check if DDR free list */
-			if (list_empty(&htbl->head_free_offset_list[bin])) {
-				if (!entry->is_lcl && (htbl->end + ipa_hdr_bin_sz[bin] > mem_size)) {
-					IPAERR("No space in DDR header buffer! Requested: %d Left: %d name %s, end %d\n",
-							ipa_hdr_bin_sz[bin], mem_size - htbl->end, entry->name, htbl->end);
-					goto bad_hdr_len;
-				}
-
-				IPADBG_LOW("No free offset in DDR allocating new offset Requested: %d Left: %d name %s, end %d\n",
-						ipa_hdr_bin_sz[bin], mem_size - htbl->end, entry->name, htbl->end);
-				goto create_entry;
-			} else {
-				/* get the first free slot */
-				offset = list_first_entry(&htbl->head_free_offset_list[bin],
-						struct ipa_hdr_offset_entry, link);
-				list_move(&offset->link, &htbl->head_offset_list[bin]);
-				entry->offset_entry = offset;
-				offset->ipacm_installed = user;
-				goto free_list;
-			}
+	/*
+	 * Prefer a free slot of the exact bin, then growing the table and
+	 * only then a free slot of a larger bin. A local header which still
+	 * does not fit is placed in the DDR table using the same order.
+	 */
+	offset = __ipa_hdr_get_free_offset(htbl, bin,
+		htbl->end + ipa_hdr_bin_sz[bin] > mem_size);
+	if (!offset && entry->is_lcl &&
+		htbl->end + ipa_hdr_bin_sz[bin] > mem_size) {
+		/* if header does not fit to SRAM table, place it in DDR */
+		IPADBG_LOW("SRAM header table was full allocting DDR header table! Requested: %d Left: %d name %s, end %d\n",
+				ipa_hdr_bin_sz[bin], mem_size - htbl->end, entry->name, htbl->end);
+		htbl = &ipa3_ctx->hdr_tbl[HDR_TBL_SYS];
+		mem_size = IPA_MEM_PART(apps_hdr_size_ddr);
+		entry->is_lcl = false;
+		offset = __ipa_hdr_get_free_offset(htbl, bin,
+			htbl->end + ipa_hdr_bin_sz[bin] > mem_size);
+	}
+
+	if (!offset) {
+		if (htbl->end + ipa_hdr_bin_sz[bin] > mem_size) {
+			IPAERR("No space in %s header buffer! Requested: %d Left: %d name %s, end %d\n",
+					entry->is_lcl ? "SRAM" : "DDR",
+					ipa_hdr_bin_sz[bin], mem_size - htbl->end, entry->name, htbl->end);
+			goto bad_hdr_len;
 		}
-create_entry:
+
 		offset = kmem_cache_zalloc(ipa3_ctx->hdr_offset_cache,
 					   GFP_KERNEL);
 		if (!offset) {
@@ -696,18 +845,11 @@ create_entry:
 		htbl->end += ipa_hdr_bin_sz[bin];
 		list_add(&offset->link,
 				&htbl->head_offset_list[bin]);
-		entry->offset_entry = offset;
-		offset->ipacm_installed = user;
-	} else {
-		/* get the first free slot */
-		offset = list_first_entry(&htbl->head_free_offset_list[bin],
-			struct ipa_hdr_offset_entry, link);
-		list_move(&offset->link, &htbl->head_offset_list[bin]);
-		entry->offset_entry = offset;
-		offset->ipacm_installed = user;
 	}
-
-free_list:
+	entry->offset_entry = offset;
+	offset->ipacm_installed = user;
+	if (entry->is_lcl)
+		__ipa_hdr_tbl_mark_dirty(htbl, offset->offset, entry->hdr_len);
 
 	list_add(&entry->link, &htbl->head_hdr_entry_list);
 	htbl->hdr_cnt++;
@@ -733,8 +875,7 @@ free_list:
 
 ipa_insert_failed:
 	if (offset)
-		list_move(&offset->link,
-			  &htbl->head_free_offset_list[offset->bin]);
+		__ipa_hdr_put_offset(htbl, offset);
 	entry->offset_entry = NULL;
 	htbl->hdr_cnt--;
 	list_del(&entry->link);
@@ -779,8 +920,7 @@ static int __ipa3_del_hdr_proc_ctx(u32 proc_ctx_hdl,
 		__ipa3_del_hdr(entry->hdr->id, false);
 
 	/* move the offset entry to appropriate free list */
-	list_move(&entry->offset_entry->link,
-		&htbl->head_free_offset_list[entry->offset_entry->bin]);
+	__ipa_proc_ctx_put_offset(htbl, entry->offset_entry);
 	list_del(&entry->link);
 	htbl->proc_ctx_cnt--;
 	entry->cookie = 0;
@@ -869,8 +1009,7 @@ int __ipa3_del_hdr(u32 hdr_hdl, bool by_user)
 		__ipa3_del_hdr_proc_ctx(entry->proc_ctx->id, false, false);
 	else
 		/* move the offset entry to appropriate free list */
-		list_move(&entry->offset_entry->link,
-			&htbl->head_free_offset_list[entry->offset_entry->bin]);
+		__ipa_hdr_put_offset(htbl, entry->offset_entry);
 	list_del(&entry->link);
 	htbl->hdr_cnt--;
 	entry->cookie = 0;
@@ -1327,9 +1466,8 @@ int ipa3_reset_hdr(bool user_only)
 				}
 				/* move the offset entry to free list */
 				entry->offset_entry->ipacm_installed = false;
-				list_move(&entry->offset_entry->link,
-				&ipa3_ctx->hdr_tbl[hdr_tbl_loc].head_free_offset_list[
-					entry->offset_entry->bin]);
+				__ipa_hdr_put_offset(&ipa3_ctx->hdr_tbl[hdr_tbl_loc],
+					entry->offset_entry);
 
 				/* delete the hdr entry from headers list */
 				list_del(&entry->link);
@@ -1372,6 +1510,8 @@ int ipa3_reset_hdr(bool user_only)
 			ipa3_ctx->hdr_tbl[hdr_tbl_loc].hdr_cnt = 1;
 		}
 	}
+	if (!user_only)
+		ipa3_hdr_lcl_tbl_invalidate();
 
 	IPADBG("reset hdr proc ctx\n");
 	list_for_each_entry_safe(
@@ -1390,9 +1530,8 @@ int ipa3_reset_hdr(bool user_only)
 		if (!user_only ||
 				ctx_entry->ipacm_installed) {
 			/* move the offset entry to appropriate free list */
-			list_move(&ctx_entry->offset_entry->link,
-				&htbl_proc->head_free_offset_list[
-					ctx_entry->offset_entry->bin]);
+			__ipa_proc_ctx_put_offset(htbl_proc,
+				ctx_entry->offset_entry);
 			list_del(&ctx_entry->link);
 			htbl_proc->proc_ctx_cnt--;
 			ctx_entry->ref_cnt = 0;
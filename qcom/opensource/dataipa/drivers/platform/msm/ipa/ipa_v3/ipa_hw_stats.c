@@ -674,7 +674,8 @@ destroy_init_pyld:
 	return ret;
 }
 
-int ipa_get_quota_stats(struct ipa_quota_stats_all *out)
+static int __ipa_get_quota_stats(struct ipa_quota_stats_all *out,
+	struct ipa_mem_buffer *buf, struct ipahal_stats_quota_all *stats_buf)
 {
 	int i;
 	int ret;
@@ -706,14 +707,23 @@ int ipa_get_quota_stats(struct ipa_quota_stats_all *out)
 	if (offset.size == 0)
 		return 0;
 
-	mem.size = offset.size;
-	mem.base = dma_alloc_coherent(ipa3_ctx->pdev,
-		mem.size,
-		&mem.phys_base,
-		GFP_KERNEL);
-	if (!mem.base) {
-		IPAERR("fail to alloc DMA memory");
-		return ret;
+	if (buf) {
+		if (offset.size > buf->size) {
+			IPAERR("stats buffer too small: %u needed %u\n",
+				buf->size, offset.size);
+			return -ENOMEM;
+		}
+		mem = *buf;
+	} else {
+		mem.size = offset.size;
+		mem.base = dma_alloc_coherent(ipa3_ctx->pdev,
+			mem.size,
+			&mem.phys_base,
+			GFP_KERNEL);
+		if (!mem.base) {
+			IPAERR("fail to alloc DMA memory");
+			return ret;
+		}
 	}
 
 	/* IC to close the coal frame before HPS Clear if coal is enabled */
@@ -733,7 +743,7 @@ int ipa_get_quota_stats(struct ipa_quota_stats_all *out)
 	cmd.clear_after_read = true;
 	cmd.skip_pipeline_clear = false;
 	cmd.pipeline_clear_options = IPAHAL_HPS_CLEAR;
-	cmd.size = mem.size;
+	cmd.size = offset.size;
 	cmd.system_addr = mem.phys_base;
 	cmd.local_addr = ipa3_ctx->smem_restricted_bytes +
 		IPA_MEM_PART(stats_quota_ap_ofst) + offset.offset;
@@ -753,7 +763,7 @@ int ipa_get_quota_stats(struct ipa_quota_stats_all *out)
 		goto destroy_imm;
 	}
 
-	stats = kzalloc(sizeof(*stats), GFP_KERNEL);
+	stats = stats_buf ? stats_buf : kzalloc(sizeof(*stats), GFP_KERNEL);
 	if (!stats) {
 		ret = -ENOMEM;
 		goto destroy_imm;
@@ -795,16 +805,46 @@ int ipa_get_quota_stats(struct ipa_quota_stats_all *out)
 		*out = ipa3_ctx->hw_stats->quota.stats;
 	ret = 0;
 free_stats:
-	kfree(stats);
+	if (!stats_buf)
+		kfree(stats);
 destroy_imm:
 	for (i = 0; i < num_cmd; i++)
 		ipahal_destroy_imm_cmd(cmd_pyld[i]);
 free_dma_mem:
-	dma_free_coherent(ipa3_ctx->pdev, mem.size, mem.base, mem.phys_base);
+	if (!buf)
+		dma_free_coherent(ipa3_ctx->pdev, mem.size, mem.base,
+			mem.phys_base);
 	return ret;
 
 }
 
+int ipa_get_quota_stats(struct ipa_quota_stats_all *out)
+{
+	return __ipa_get_quota_stats(out, NULL, NULL);
+}
+
+/**
+ * ipa_get_quota_stats_prealloc() - read the quota stats into caller
+ * provided buffers
+ * @out: [out] accumulated stats, may be NULL
+ * @mem: DMA buffer of at least IPA_MEM_PART(stats_quota_ap_size) bytes
+ * @stats: parse buffer
+ *
+ * Same as ipa_get_quota_stats() without allocating on every call, for
+ * periodic readers. Caller must hold ipa3_ctx->lock.
+ *
+ * Return: 0 on success, negative otherwise
+ */
+int ipa_get_quota_stats_prealloc(struct ipa_quota_stats_all *out,
+	struct ipa_mem_buffer *mem, struct ipahal_stats_quota_all *stats)
+{
+	if (!mem || !mem->base || !stats)
+		return -EINVAL;
+
+	return __ipa_get_quota_stats(out, mem, stats);
+}
+
+
 int ipa_reset_quota_stats(enum ipa_client_type client)
 {
 	int ret;
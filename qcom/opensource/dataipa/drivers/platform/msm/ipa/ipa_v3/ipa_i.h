@@ -856,6 +856,8 @@ struct ipa3_hdr_entry {
  * @head_free_offset_list: header free offset list
  * @hdr_cnt: number of headers
  * @end: the last header index
+ * @dirty_start: first byte written since the last commit
+ * @dirty_end: end of the bytes written since the last commit
  */
 struct ipa3_hdr_tbl {
 	struct list_head head_hdr_entry_list;
@@ -863,6 +865,8 @@ struct ipa3_hdr_tbl {
 	struct list_head head_free_offset_list[IPA_HDR_BIN_MAX];
 	u32 hdr_cnt;
 	u32 end;
+	u32 dirty_start;
+	u32 dirty_end;
 };
 
 /**
@@ -1188,6 +1192,8 @@ struct ipa3_page_repl_ctx {
  * @buff_size: rx packet length
  * @page_order: page order of the rx pipe based on the ioctl version
  * @ext_ioctl_v2: specifies if it's new version of ingress/egress ioctl
+ * @db_defer: doorbell ring may be deferred (skip_db_ring), the NOP work
+ * rings it if no further send follows
  *
  * IPA context specific to the GPI pipes a.k.a LAN IN/OUT and WAN
  */
@@ -1199,6 +1205,7 @@ struct ipa3_sys_context {
 	enum ipa3_sys_pipe_policy policy;
 	bool use_comm_evt_ring;
 	bool nop_pending;
+	bool db_defer;
 	int (*pyld_hdlr)(struct sk_buff *skb, struct ipa3_sys_context *sys);
 	struct sk_buff * (*get_skb)(unsigned int len, gfp_t flags);
 	void (*free_skb)(struct sk_buff *skb);
@@ -3070,6 +3077,7 @@ int ipa3_put_hdr(u32 hdr_hdl);
 int ipa3_copy_hdr(struct ipa_ioc_copy_hdr *copy);
 
 u32 ipa3_get_hdr_bin_size(int index);
+void ipa3_hdr_lcl_tbl_invalidate(void);
 
 /*
  * Header Processing Context
@@ -3189,6 +3197,9 @@ int ipa3_set_single_ndp_per_mbim(bool enable);
 int ipa3_tx_dp(enum ipa_client_type dst, struct sk_buff *skb,
 		struct ipa_tx_meta *metadata);
 
+int ipa3_tx_dp_more(enum ipa_client_type dst, struct sk_buff *skb,
+		struct ipa_tx_meta *metadata, bool xmit_more);
+
 /*
  * To transfer multiple data packets
  * While passing the data descriptor list, the anchor node
@@ -3618,6 +3629,9 @@ int ipa_init_quota_stats(u32 *pipe_bitmask);
 
 int ipa_get_quota_stats(struct ipa_quota_stats_all *out);
 
+int ipa_get_quota_stats_prealloc(struct ipa_quota_stats_all *out,
+	struct ipa_mem_buffer *mem, struct ipahal_stats_quota_all *stats);
+
 int ipa_reset_quota_stats(enum ipa_client_type client);
 
 int ipa_reset_all_quota_stats(void);
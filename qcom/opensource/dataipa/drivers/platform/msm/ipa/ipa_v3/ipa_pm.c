@@ -7,6 +7,7 @@
 #include "ipa_pm.h"
 #include "ipa_stats.h"
 #include "ipa_i.h"
+#include "ipa_trace.h"
 
 
 #define IPA_PM_DRV_NAME "ipa_pm"
@@ -87,6 +88,56 @@ struct clk_scaling_db {
 	int *current_threshold;
 };
 
+/* defaults of the predictive clock scaling tunables */
+#define IPA_PM_PREDICT_PERIOD_MS 100
+#define IPA_PM_PREDICT_EWMA_SHIFT 2
+#define IPA_PM_PREDICT_HEADROOM_PCT 25
+#define IPA_PM_PREDICT_DOWN_HOLD 5
+/* floor on the interval between two HW quota stats reads */
+#define IPA_PM_PREDICT_MIN_PERIOD_MS 50
+
+/*
+ * struct ipa_pm_predict_db - traffic based clock scaling state
+ * @work: periodic sampling work, runs only while IPA is clocked
+ * @lock: protects @enable, the stats buffers and the sampling state
+ * @enable: predictive scaling on top of the client votes
+ * @period_ms: sampling period
+ * @ewma_shift: weight of a new sample in the average is 1 / 2^ewma_shift
+ * @headroom_pct: margin added on top of the predicted rate
+ * @down_hold: samples a lower prediction must persist before scaling down
+ * @last_bytes: total bytes counted by HW at the previous sample
+ * @last_ts: time of the previous sample
+ * @rate_mbps: rate measured over the last period
+ * @ewma_mbps: smoothed rate
+ * @trend_mbps: smoothed rate increase per period
+ * @pred_mbps: rate expected for the next period, headroom included
+ * @vote: clock index requested by the prediction, 0 if none
+ * @below_cnt: consecutive samples asking for a lower index than @vote
+ * @last_read: time of the last HW quota stats read
+ * @mem: DMA buffer the HW quota stats are read into
+ * @stats: parsed HW quota stats
+ */
+struct ipa_pm_predict_db {
+	struct delayed_work work;
+	struct mutex lock;
+	u32 enable;
+	u32 period_ms;
+	u32 ewma_shift;
+	u32 headroom_pct;
+	u32 down_hold;
+	u64 last_bytes;
+	ktime_t last_ts;
+	u32 rate_mbps;
+	u32 ewma_mbps;
+	u32 trend_mbps;
+	u32 pred_mbps;
+	int vote;
+	u32 below_cnt;
+	ktime_t last_read;
+	struct ipa_mem_buffer mem;
+	struct ipahal_stats_quota_all *stats;
+};
+
 /*
  * ipa_pm state names
  *
@@ -166,6 +217,7 @@ struct ipa_pm_client {
  * @client_mutex: global mutex to  lock the client arrays
  * @aggragated_tput: aggragated tput value of all valid activated clients
  * @group_tput: combined throughput for the groups
+ * @predict: traffic based clock scaling state
  */
 struct ipa_pm_ctx {
 	struct ipa_pm_client *clients[IPA_PM_MAX_CLIENTS];
@@ -175,6 +227,7 @@ struct ipa_pm_ctx {
 	struct mutex client_mutex;
 	int aggregated_tput;
 	int group_tput[IPA_PM_GROUP_MAX];
+	struct ipa_pm_predict_db predict;
 };
 
 static struct ipa_pm_ctx *ipa_pm_ctx;
@@ -347,6 +400,40 @@ static void set_current_threshold(void)
 	spin_unlock_irqrestore(&ipa_pm_ctx->clk_scaling.lock, flags);
 }
 
+/**
+ * tput_to_th_idx() - get the clock index for a throughput
+ * @tput: throughput in Mbps
+ *
+ * Returns: clock index based on the current threshold
+ */
+static int tput_to_th_idx(int tput)
+{
+	struct clk_scaling_db *clk_scaling = &ipa_pm_ctx->clk_scaling;
+	int i, idx = 1;
+
+	for (i = 0; i < clk_scaling->threshold_size; i++) {
+		if (tput >= clk_scaling->current_threshold[i])
+			idx++;
+	}
+
+	return idx;
+}
+
+/**
+ * predict_queue() - schedule the next traffic sample
+ * @predict: [in] predictive scaling state
+ *
+ * A no-op if a sample is already pending.
+ */
+static void predict_queue(struct ipa_pm_predict_db *predict)
+{
+	u32 period_ms = max_t(u32, READ_ONCE(predict->period_ms),
+		IPA_PM_PREDICT_MIN_PERIOD_MS);
+
+	queue_delayed_work(ipa_pm_ctx->wq, &predict->work,
+		msecs_to_jiffies(period_ms));
+}
+
 /**
  * do_clk_scaling() - set the clock based on the activated clients
  *
@@ -354,9 +441,10 @@ static void set_current_threshold(void)
  */
 static int do_clk_scaling(void)
 {
-	int i, tput;
+	int tput, vote_th_idx, pred_th_idx;
 	int new_th_idx = 1;
 	struct clk_scaling_db *clk_scaling;
+	struct ipa_pm_predict_db *predict = &ipa_pm_ctx->predict;
 
 	if (atomic_read(&ipa3_ctx->ipa_clk_vote) == 0) {
 		IPA_PM_DBG("IPA clock is gated\n");
@@ -373,9 +461,18 @@ static int do_clk_scaling(void)
 
 	mutex_unlock(&ipa_pm_ctx->client_mutex);
 
-	for (i = 0; i < clk_scaling->threshold_size; i++) {
-		if (tput >= clk_scaling->current_threshold[i])
-			new_th_idx++;
+	vote_th_idx = tput_to_th_idx(tput);
+	new_th_idx = vote_th_idx;
+
+	if (READ_ONCE(predict->enable)) {
+		pred_th_idx = READ_ONCE(predict->vote);
+		new_th_idx = max(new_th_idx, pred_th_idx);
+		trace_ipa_pm_predict(predict->rate_mbps, predict->ewma_mbps,
+			predict->pred_mbps, vote_th_idx, pred_th_idx,
+			new_th_idx);
+		/* keep sampling while clocked, a no-op if already pending */
+		if (ipa3_ctx->hw_stats && ipa3_ctx->hw_stats->enabled)
+			predict_queue(predict);
 	}
 
 	IPA_PM_DBG_LOW("old idx was at %d\n", ipa_pm_ctx->clk_scaling.cur_vote);
@@ -399,6 +496,204 @@ static void clock_scaling_func(struct work_struct *work)
 	do_clk_scaling();
 }
 
+static void predict_reset(struct ipa_pm_predict_db *predict)
+{
+	predict->last_bytes = 0;
+	predict->last_ts = 0;
+	predict->rate_mbps = 0;
+	predict->ewma_mbps = 0;
+	predict->trend_mbps = 0;
+	predict->pred_mbps = 0;
+	predict->vote = 0;
+	predict->below_cnt = 0;
+}
+
+/**
+ * predict_alloc_bufs() - allocate the buffers the HW stats are sampled into
+ * @predict: [in] predictive scaling state, lock held
+ *
+ * Returns: 0 on success, negative otherwise
+ */
+static int predict_alloc_bufs(struct ipa_pm_predict_db *predict)
+{
+	u32 size = IPA_MEM_PART(stats_quota_ap_size);
+
+	if (predict->stats)
+		return 0;
+
+	if (!size)
+		return -EPERM;
+
+	predict->stats = kzalloc(sizeof(*predict->stats), GFP_KERNEL);
+	if (!predict->stats)
+		return -ENOMEM;
+
+	predict->mem.size = size;
+	predict->mem.base = dma_alloc_coherent(ipa3_ctx->pdev, size,
+		&predict->mem.phys_base, GFP_KERNEL);
+	if (!predict->mem.base) {
+		kfree(predict->stats);
+		predict->stats = NULL;
+		return -ENOMEM;
+	}
+
+	return 0;
+}
+
+/**
+ * predict_free_bufs() - free the HW stats sampling buffers
+ * @predict: [in] predictive scaling state, lock held
+ */
+static void predict_free_bufs(struct ipa_pm_predict_db *predict)
+{
+	if (!predict->stats)
+		return;
+
+	dma_free_coherent(ipa3_ctx->pdev, predict->mem.size,
+		predict->mem.base, predict->mem.phys_base);
+	memset(&predict->mem, 0, sizeof(predict->mem));
+	kfree(predict->stats);
+	predict->stats = NULL;
+}
+
+/**
+ * predict_sample_bytes() - read the bytes counted by the HW quota stats
+ * @predict: [in] predictive scaling state, lock held
+ * @bytes: [out] total bytes over all the monitored pipes
+ *
+ * Every HW read closes the coalescing frame and clears the pipeline, so
+ * reads are spaced at least IPA_PM_PREDICT_MIN_PERIOD_MS apart. The read
+ * goes through preallocated buffers under ipa3_ctx->lock, like the other
+ * quota stats readers, and is skipped rather than waited for when that
+ * lock is busy.
+ *
+ * Returns: 0 on success, -EAGAIN if the sample should be retried later,
+ * other negative values if IPA is not clocked or stats are off
+ */
+static int predict_sample_bytes(struct ipa_pm_predict_db *predict,
+	u64 *bytes)
+{
+	struct ipa_active_client_logging_info log_info;
+	struct ipa_quota_stats *stats;
+	ktime_t now = ktime_get();
+	int i, ret;
+
+	if (!(ipa3_ctx->hw_stats && ipa3_ctx->hw_stats->enabled) ||
+		!predict->stats)
+		return -EPERM;
+
+	if (predict->last_read && ktime_ms_delta(now, predict->last_read) <
+		IPA_PM_PREDICT_MIN_PERIOD_MS)
+		return -EAGAIN;
+
+	if (!mutex_trylock(&ipa3_ctx->lock))
+		return -EAGAIN;
+
+	/* sample only while IPA is already clocked, never wake it up */
+	IPA_ACTIVE_CLIENTS_PREP_SIMPLE(log_info);
+	if (ipa3_inc_client_enable_clks_no_block(&log_info)) {
+		mutex_unlock(&ipa3_ctx->lock);
+		return -EPERM;
+	}
+
+	ret = ipa_get_quota_stats_prealloc(NULL, &predict->mem,
+		predict->stats);
+	ipa3_dec_client_disable_clks(&log_info);
+	predict->last_read = now;
+	if (ret) {
+		mutex_unlock(&ipa3_ctx->lock);
+		return ret;
+	}
+
+	*bytes = 0;
+	for (i = 0; i < IPA_CLIENT_MAX; i++) {
+		stats = &ipa3_ctx->hw_stats->quota.stats.client[i];
+		*bytes += stats->num_ipv4_bytes + stats->num_ipv6_bytes;
+	}
+	mutex_unlock(&ipa3_ctx->lock);
+
+	return 0;
+}
+
+/**
+ * predict_func() - sample the traffic rate and update the predicted vote
+ *
+ * The rate is smoothed with an EWMA and extrapolated with the smoothed
+ * increase so that the clock is raised ahead of a ramping burst. Scaling up
+ * is immediate while scaling down waits for down_hold consecutive samples.
+ */
+static void predict_func(struct work_struct *work)
+{
+	struct ipa_pm_predict_db *predict = &ipa_pm_ctx->predict;
+	u32 shift = min_t(u32, predict->ewma_shift, 16);
+	int ewma, incr, trend, pred_idx;
+	u64 bytes, pred;
+	ktime_t now;
+	s64 delta_us;
+	int ret;
+
+	mutex_lock(&predict->lock);
+	ret = predict->enable ? predict_sample_bytes(predict, &bytes) : -EPERM;
+	if (ret == -EAGAIN) {
+		mutex_unlock(&predict->lock);
+		predict_queue(predict);
+		return;
+	}
+
+	if (ret) {
+		/* stop sampling, restarted by the next clock scaling */
+		pred_idx = predict->vote;
+		predict_reset(predict);
+		if (!predict->enable)
+			predict_free_bufs(predict);
+		mutex_unlock(&predict->lock);
+		if (pred_idx)
+			queue_work(ipa_pm_ctx->wq, &ipa_pm_ctx->clk_scaling.work);
+		return;
+	}
+
+	now = ktime_get();
+	delta_us = ktime_us_delta(now, predict->last_ts);
+	/* first sample or counters were reset */
+	if (!predict->last_ts || bytes < predict->last_bytes || delta_us <= 0) {
+		predict->last_bytes = bytes;
+		predict->last_ts = now;
+		mutex_unlock(&predict->lock);
+		do_clk_scaling();
+		return;
+	}
+
+	/* bits per usec is Mbps */
+	predict->rate_mbps = min_t(u64, div64_u64((bytes - predict->last_bytes)
+		* 8, delta_us), INT_MAX);
+	predict->last_bytes = bytes;
+	predict->last_ts = now;
+
+	ewma = predict->ewma_mbps;
+	ewma += ((int)predict->rate_mbps - ewma) >> shift;
+	incr = max(ewma - (int)predict->ewma_mbps, 0);
+	trend = predict->trend_mbps;
+	trend += (incr - trend) >> shift;
+	predict->ewma_mbps = ewma;
+	predict->trend_mbps = trend;
+
+	pred = max_t(u64, predict->rate_mbps, (u64)ewma + trend);
+	pred = div_u64(pred * (100 + predict->headroom_pct), 100);
+	predict->pred_mbps = min_t(u64, pred, INT_MAX);
+
+	pred_idx = tput_to_th_idx(predict->pred_mbps);
+	if (pred_idx >= predict->vote) {
+		WRITE_ONCE(predict->vote, pred_idx);
+		predict->below_cnt = 0;
+	} else if (++predict->below_cnt >= predict->down_hold) {
+		WRITE_ONCE(predict->vote, pred_idx);
+		predict->below_cnt = 0;
+	}
+	mutex_unlock(&predict->lock);
+
+	do_clk_scaling();
+}
+
 /**
  * activate_work_func - activate a client and vote for clock on a work queue
  */
@@ -664,6 +959,13 @@ int ipa_pm_init(struct ipa_pm_init_params *params)
 	clk_scaling->exception_size = params->exception_size;
 	INIT_WORK(&clk_scaling->work, clock_scaling_func);
 
+	INIT_DELAYED_WORK(&ipa_pm_ctx->predict.work, predict_func);
+	mutex_init(&ipa_pm_ctx->predict.lock);
+	ipa_pm_ctx->predict.period_ms = IPA_PM_PREDICT_PERIOD_MS;
+	ipa_pm_ctx->predict.ewma_shift = IPA_PM_PREDICT_EWMA_SHIFT;
+	ipa_pm_ctx->predict.headroom_pct = IPA_PM_PREDICT_HEADROOM_PCT;
+	ipa_pm_ctx->predict.down_hold = IPA_PM_PREDICT_DOWN_HOLD;
+
 	for (i = 0; i < params->threshold_size; i++)
 		clk_scaling->default_threshold[i] =
 			params->default_threshold[i];
@@ -718,7 +1020,12 @@ int ipa_pm_destroy(void)
 		return -EPERM;
 	}
 
+	mutex_lock(&ipa_pm_ctx->predict.lock);
+	ipa_pm_ctx->predict.enable = 0;
+	mutex_unlock(&ipa_pm_ctx->predict.lock);
+	cancel_delayed_work_sync(&ipa_pm_ctx->predict.work);
 	destroy_workqueue(ipa_pm_ctx->wq);
+	predict_free_bufs(&ipa_pm_ctx->predict);
 
 	kfree(ipa_pm_ctx);
 	ipa_pm_ctx = NULL;
@@ -1385,6 +1692,17 @@ int ipa_pm_stat(char *buf, int size)
 		ipa_pm_ctx->aggregated_tput, clk->cur_vote);
 	cnt += result;
 
+	if (ipa_pm_ctx->predict.enable) {
+		result = scnprintf(buf + cnt, size - cnt,
+			"\nPredict rate: %u, ewma: %u, trend: %u, pred: %u, vote: %d",
+			ipa_pm_ctx->predict.rate_mbps,
+			ipa_pm_ctx->predict.ewma_mbps,
+			ipa_pm_ctx->predict.trend_mbps,
+			ipa_pm_ctx->predict.pred_mbps,
+			ipa_pm_ctx->predict.vote);
+		cnt += result;
+	}
+
 	result = scnprintf(buf + cnt, size - cnt, "\n\nRegistered Clients:\n");
 	cnt += result;
 
@@ -1472,6 +1790,84 @@ int ipa_pm_exceptions_stat(char *buf, int size)
 	return cnt;
 }
 
+static ssize_t ipa_pm_predict_read_enable(struct file *file,
+	char __user *ubuf, size_t count, loff_t *ppos)
+{
+	char buf[4];
+	int nbytes;
+
+	nbytes = scnprintf(buf, sizeof(buf), "%u\n",
+		ipa_pm_ctx->predict.enable);
+
+	return simple_read_from_buffer(ubuf, count, ppos, buf, nbytes);
+}
+
+static ssize_t ipa_pm_predict_write_enable(struct file *file,
+	const char __user *ubuf, size_t count, loff_t *ppos)
+{
+	bool enable;
+	int ret;
+
+	ret = kstrtobool_from_user(ubuf, count, &enable);
+	if (ret)
+		return ret;
+
+	mutex_lock(&ipa_pm_ctx->predict.lock);
+	/* disabling frees the buffers from the sampling work */
+	if (enable) {
+		ret = predict_alloc_bufs(&ipa_pm_ctx->predict);
+		if (ret) {
+			mutex_unlock(&ipa_pm_ctx->predict.lock);
+			return ret;
+		}
+	}
+	WRITE_ONCE(ipa_pm_ctx->predict.enable, enable);
+	mutex_unlock(&ipa_pm_ctx->predict.lock);
+	IPA_PM_DBG("predictive clock scaling %s\n", enable ? "on" : "off");
+
+	/* start sampling or drop the predicted vote */
+	if (enable)
+		queue_work(ipa_pm_ctx->wq, &ipa_pm_ctx->clk_scaling.work);
+	else
+		mod_delayed_work(ipa_pm_ctx->wq, &ipa_pm_ctx->predict.work, 0);
+
+	return count;
+}
+
+static const struct file_operations ipa_pm_predict_enable_ops = {
+	.read = ipa_pm_predict_read_enable,
+	.write = ipa_pm_predict_write_enable,
+};
+
+/**
+ * ipa_pm_debugfs_init_predict() - create the predictive clock scaling
+ * tunables
+ * @parent: [in] IPA debugfs directory
+ */
+void ipa_pm_debugfs_init_predict(struct dentry *parent)
+{
+	struct ipa_pm_predict_db *predict;
+	struct dentry *dent;
+
+	if (!ipa_pm_ctx)
+		return;
+
+	predict = &ipa_pm_ctx->predict;
+	dent = debugfs_create_dir("pm_predict", parent);
+	if (IS_ERR_OR_NULL(dent)) {
+		IPA_PM_ERR("fail to create pm_predict folder\n");
+		return;
+	}
+
+	debugfs_create_file("enable", 0664, dent, NULL,
+		&ipa_pm_predict_enable_ops);
+	debugfs_create_u32("period_ms", 0664, dent, &predict->period_ms);
+	debugfs_create_u32("ewma_shift", 0664, dent, &predict->ewma_shift);
+	debugfs_create_u32("headroom_pct", 0664, dent,
+		&predict->headroom_pct);
+	debugfs_create_u32("down_hold", 0664, dent, &predict->down_hold);
+}
+
 int ipa_pm_get_scaling_bw_levels(struct ipa_lnx_clock_stats *clock_stats)
 {
 	struct clk_scaling_db *clk;
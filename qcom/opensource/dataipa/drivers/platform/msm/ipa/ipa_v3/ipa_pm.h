@@ -8,6 +8,8 @@
 
 #include <linux/msm_ipa.h>
 
+struct dentry;
+
 /* internal to ipa */
 
 /* actual max is value -1 since we start from 1*/
@@ -105,6 +107,7 @@ int ipa_pm_exceptions_stat(char *buf, int size);
 void ipa_pm_set_clock_index(int index);
 int ipa_pm_add_dummy_clients(s8 power_plan);
 int ipa_pm_remove_dummy_clients(void);
+void ipa_pm_debugfs_init_predict(struct dentry *parent);
 
 #else /* IS_ENABLED(CONFIG_IPA3) */
 
@@ -190,6 +193,10 @@ static inline int ipa_pm_remove_dummy_clients(void);
 {
 	return -EPERM;
 }
+
+static inline void ipa_pm_debugfs_init_predict(struct dentry *parent)
+{
+}
 #endif /* IS_ENABLED(CONFIG_IPA3) */
 
 #endif /* _IPA_PM_H_ */
@@ -389,6 +389,37 @@ TRACE_EVENT(
 		__entry->first_skb, __entry->prev_skb, __entry->rx_skb)
 );
 
+TRACE_EVENT(
+	ipa_pm_predict,
+
+	TP_PROTO(u32 rate_mbps, u32 ewma_mbps, u32 pred_mbps, int vote_idx,
+		 int pred_idx, int new_idx),
+
+	TP_ARGS(rate_mbps, ewma_mbps, pred_mbps, vote_idx, pred_idx, new_idx),
+
+	TP_STRUCT__entry(
+		__field(u32,	rate_mbps)
+		__field(u32,	ewma_mbps)
+		__field(u32,	pred_mbps)
+		__field(int,	vote_idx)
+		__field(int,	pred_idx)
+		__field(int,	new_idx)
+	),
+
+	TP_fast_assign(
+		__entry->rate_mbps = rate_mbps;
+		__entry->ewma_mbps = ewma_mbps;
+		__entry->pred_mbps = pred_mbps;
+		__entry->vote_idx = vote_idx;
+		__entry->pred_idx = pred_idx;
+		__entry->new_idx = new_idx;
+	),
+
+	TP_printk("rate=%u ewma=%u pred=%u vote_idx=%d pred_idx=%d new_idx=%d",
+		__entry->rate_mbps, __entry->ewma_mbps, __entry->pred_mbps,
+		__entry->vote_idx, __entry->pred_idx, __entry->new_idx)
+);
+
 #endif /* _IPA_TRACE_H */
 
 /* This part must be outside protection */
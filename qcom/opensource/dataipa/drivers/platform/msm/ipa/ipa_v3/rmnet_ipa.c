@@ -1522,9 +1522,11 @@ send:
 
 	/*
 	 * both data packets and command will be routed to
-	 * IPA_CLIENT_Q6_WAN_CONS based on status configuration
+	 * IPA_CLIENT_Q6_WAN_CONS based on status configuration.
+	 * Ring the doorbell once per burst, QMAP commands go out right away.
 	 */
-	ret = ipa3_tx_dp(IPA_CLIENT_APPS_WAN_PROD, skb, NULL);
+	ret = ipa3_tx_dp_more(IPA_CLIENT_APPS_WAN_PROD, skb, NULL,
+		!qmap_check && netdev_xmit_more());
 	if (ret) {
 		atomic_dec(&wwan_ptr->outstanding_pkts);
 		if (ret == -EPIPE) {
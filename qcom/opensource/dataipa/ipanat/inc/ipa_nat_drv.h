@@ -267,5 +267,37 @@ int ipa_nat_switch_to(
 	enum ipa3_nat_mem_in nmi,
 	bool                 hold_state );
 
+/**
+ * ipa_nat_set_tiering() - While in HYBRID mode only, keep the SRAM
+ * table active and use it for the recently hit rules, parking idle
+ * ones in DDR instead of moving the whole table to DDR when SRAM
+ * fills up. Parked rules are not seen by the IPA and are handled by
+ * the apps path until promoted back to SRAM.
+ * @enable: turn tiering on or off
+ * @idle_passes: number of ipa_nat_tier_rebalance() calls without a
+ *               hit before a rule is considered idle (0 for default)
+ */
+int ipa_nat_set_tiering(
+	bool     enable,
+	uint32_t idle_passes );
+
+/**
+ * ipa_nat_tier_rebalance() - To be called periodically while tiering
+ * is on. Samples the SRAM rules' timestamps, demotes idle rules to
+ * DDR and promotes parked rules into the freed SRAM slots.
+ */
+int ipa_nat_tier_rebalance(void);
+
+/**
+ * ipa_nat_query_tier() - While tiering is on, reports which memory
+ * currently holds a rule: SRAM for the hot set seen by the IPA, DDR
+ * for a parked rule.
+ * @rule_hdl: handle returned by ipa_nat_add_ipv4_rule()
+ * @nmi_ptr: [out] memory holding the rule
+ */
+int ipa_nat_query_tier(
+	uint32_t              rule_hdl,
+	enum ipa3_nat_mem_in* nmi_ptr );
+
 #endif
 
@@ -51,8 +51,9 @@ typedef enum
 	MAP_NUM_01 = 1,
 	MAP_NUM_02 = 2,
 	MAP_NUM_03 = 3,
+	MAP_NUM_04 = 4,
 
-	MAP_NUM_99 = 4,
+	MAP_NUM_99 = 5,
 
 	MAP_NUM_MAX
 } ipa_which_map;
@@ -70,6 +71,7 @@ static inline const char* ipa_which_map_as_str(
 		MAKE_AS_STR_CASE(MAP_NUM_01);
 		MAKE_AS_STR_CASE(MAP_NUM_02);
 		MAKE_AS_STR_CASE(MAP_NUM_03);
+		MAKE_AS_STR_CASE(MAP_NUM_04);
 
 		MAKE_AS_STR_CASE(MAP_NUM_99);
 	default:
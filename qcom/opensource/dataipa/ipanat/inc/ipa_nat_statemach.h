@@ -102,6 +102,7 @@ typedef enum {
 	NATI_TRIG_GOTO_DDR   =  9,
 	NATI_TRIG_GOTO_SRAM  = 10,
 	NATI_TRIG_GET_TSTAMP = 11,
+	NATI_TRIG_TIER_REBAL = 12,
 
 	NATI_TRIG_LAST
 } ipa_nati_trigger;
@@ -159,6 +160,15 @@ typedef struct
 	 * sw_stats[1] for sram
 	 */
 	nati_switch_stats sw_stats[2];
+	/*
+	 * Tiered hybrid mode: SRAM stays active and holds the recently
+	 * hit rules, idle ones are parked in the DDR table...
+	 */
+	bool           tiered;
+	uint32_t       tier_idle_passes;
+	uint32_t       tier_seq;
+	uint32_t       tier_promoted;
+	uint32_t       tier_demoted;
 } ipa_nati_obj;
 
 /*
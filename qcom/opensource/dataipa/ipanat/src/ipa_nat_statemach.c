@@ -62,6 +62,7 @@
  */
 #include <errno.h>
 #include <pthread.h>
+#include <stdlib.h>
 
 #include "ipa_nat_drv.h"
 #include "ipa_nat_drvi.h"
@@ -96,6 +97,42 @@
 #define CHOOSE_SW_STATS() \
 	&(nati_obj.sw_stats[CHOOSE_MEM_SUB()])
 
+/*
+ * For tiered mode...
+ *
+ * The activity map holds, per SRAM resident rule, the timestamp seen
+ * at the last rebalance and the number of passes it has not changed.
+ * For a rule demoted to DDR, it holds the number of passes the rule
+ * has been parked since.
+ */
+#undef  TIER_ACTIVITY_MAP
+#define TIER_ACTIVITY_MAP MAP_NUM_04
+
+#undef  TIER_ACT
+#define TIER_ACT(ts, idle) \
+	((((uint32_t) (ts)) << 8) | ((idle) & 0xFF))
+
+#undef  TIER_ACT_TS
+#define TIER_ACT_TS(v) \
+	((v) >> 8)
+
+#undef  TIER_ACT_IDLE
+#define TIER_ACT_IDLE(v) \
+	((v) & 0xFF)
+
+#undef  TIER_DEFAULT_IDLE_PASSES
+#define TIER_DEFAULT_IDLE_PASSES 2
+
+/*
+ * A demoted rule stays parked this many times the idle passes before
+ * it may be promoted again...
+ */
+#undef  TIER_PROMOTE_HOLD
+#define TIER_PROMOTE_HOLD 4
+
+#undef  TIER_ORIG_HDL_BIT
+#define TIER_ORIG_HDL_BIT 0x80000000
+
 /*
  * BACKROUND INFORMATION
  *
@@ -170,6 +207,11 @@ static ipa_nati_obj nati_obj = {
 	 *   sw_stats[1] for sram
 	 */
 	.sw_stats = { {0, 0}, {0, 0} },
+	.tiered           = false,
+	.tier_idle_passes = TIER_DEFAULT_IDLE_PASSES,
+	.tier_seq         = 0,
+	.tier_promoted    = 0,
+	.tier_demoted     = 0,
 };
 
 /*
@@ -609,6 +651,208 @@ bool ipa_nat_is_sram_supported(void)
 	return VALID_TBL_HDL(nati_obj.sram_tbl_hdl);
 }
 
+static void tier_reset_parked(
+	ipa_nati_obj* nati_obj_ptr ); /* forward declaration */
+
+int ipa_nat_set_tiering(
+	bool     enable,
+	uint32_t idle_passes )
+{
+	int ret;
+
+	IPADBG("In - current state %s tiered(%u) enable(%u)\n",
+		   ipa_nati_state_as_str(nati_obj.curr_state),
+		   nati_obj.tiered,
+		   enable);
+
+	ret = take_mutex();
+
+	if ( ret != 0 )
+	{
+		goto bail;
+	}
+
+	if ( enable )
+	{
+		if ( ! nati_obj.tiered && nati_obj.curr_state == NATI_STATE_HYBRID )
+		{
+			/*
+			 * Whatever is in DDR was left behind by an earlier
+			 * switch. From now on, it's where idle rules get parked...
+			 */
+			tier_reset_parked(&nati_obj);
+			ipa_nat_map_clear(TIER_ACTIVITY_MAP);
+		}
+
+		nati_obj.tier_idle_passes =
+			(idle_passes) ? idle_passes : TIER_DEFAULT_IDLE_PASSES;
+
+		nati_obj.tiered = true;
+	}
+	else if ( nati_obj.tiered )
+	{
+		if ( nati_obj.curr_state == NATI_STATE_HYBRID
+			 &&
+			 nati_obj.tot_rules_in_table[DDR_SUB] )
+		{
+			/*
+			 * Parked rules would be lost to the IPA for good, so
+			 * bring everything together in DDR...
+			 */
+			ipa_nati_statemach(&nati_obj, NATI_TRIG_TBL_SWITCH, 0);
+
+			if ( nati_obj.curr_state != NATI_STATE_HYBRID_DDR )
+			{
+				IPAERR("Unable to merge parked rules, staying tiered\n");
+				ret = -1;
+				goto unlock;
+			}
+		}
+
+		ipa_nat_map_clear(TIER_ACTIVITY_MAP);
+
+		nati_obj.tiered = false;
+	}
+
+	IPADBG("Tiering is %s, idle after %u passes\n",
+		   (nati_obj.tiered) ? "on" : "off",
+		   nati_obj.tier_idle_passes);
+
+unlock:
+	if ( give_mutex() != 0 && ret == 0 )
+	{
+		ret = -1;
+	}
+
+bail:
+	IPADBG("Out\n");
+
+	return ret;
+}
+
+int ipa_nat_tier_rebalance(void)
+{
+	int ret;
+
+	IPADBG("In\n");
+
+	ret = take_mutex();
+
+	if ( ret != 0 )
+	{
+		goto bail;
+	}
+
+	if ( nati_obj.tiered && IN_HYBRID_STATE() )
+	{
+		ret = ipa_nati_statemach(&nati_obj, NATI_TRIG_TIER_REBAL, 0);
+	}
+
+	if ( give_mutex() != 0 && ret == 0 )
+	{
+		ret = -1;
+	}
+
+bail:
+	IPADBG("Out\n");
+
+	return ret;
+}
+
+int ipa_nat_query_tier(
+	uint32_t              rule_hdl,
+	enum ipa3_nat_mem_in* nmi_ptr )
+{
+	uint32_t new_rule_hdl;
+
+	int ret;
+
+	IPADBG("In\n");
+
+	if ( nmi_ptr == NULL )
+	{
+		IPAERR("Invalid parameters passed nmi_ptr=%pK\n", nmi_ptr);
+		ret = -EINVAL;
+		goto bail;
+	}
+
+	ret = take_mutex();
+
+	if ( ret != 0 )
+	{
+		goto bail;
+	}
+
+	ret = -ENOENT;
+
+	if ( nati_obj.tiered && nati_obj.curr_state == NATI_STATE_HYBRID )
+	{
+		if ( ipa_nat_map_find(
+				 nati_obj.map_pairs[SRAM_SUB].orig2new_map,
+				 rule_hdl,
+				 &new_rule_hdl) == 0 )
+		{
+			*nmi_ptr = IPA_NAT_MEM_IN_SRAM;
+			ret = 0;
+		}
+		else if ( ipa_nat_map_find(
+					  nati_obj.map_pairs[DDR_SUB].orig2new_map,
+					  rule_hdl,
+					  &new_rule_hdl) == 0 )
+		{
+			*nmi_ptr = IPA_NAT_MEM_IN_DDR;
+			ret = 0;
+		}
+	}
+
+	if ( give_mutex() != 0 && ret == 0 )
+	{
+		ret = -1;
+	}
+
+bail:
+	IPADBG("Out\n");
+
+	return ret;
+}
+
+/******************************************************************************/
+/*
+ * FUNCTION: nat_rule_to_v4_rule
+ *
+ * PARAMS:
+ *
+ *   nat_rule_ptr (IN)  A nat rule record from a table
+ *
+ *   v4_rule_ptr  (OUT) The record above in API form
+ *
+ * DESCRIPTION:
+ *
+ *   Used when a record is to be re-added to another table.
+ */
+static void nat_rule_to_v4_rule(
+	const struct ipa_nat_rule* nat_rule_ptr,
+	ipa_nat_ipv4_rule*         v4_rule_ptr )
+{
+	memset(v4_rule_ptr, 0, sizeof(*v4_rule_ptr));
+
+	v4_rule_ptr->private_ip   = nat_rule_ptr->private_ip;
+	v4_rule_ptr->private_port = nat_rule_ptr->private_port;
+	v4_rule_ptr->protocol     = nat_rule_ptr->protocol;
+	v4_rule_ptr->public_port  = nat_rule_ptr->public_port;
+	v4_rule_ptr->target_ip    = nat_rule_ptr->target_ip;
+	v4_rule_ptr->target_port  = nat_rule_ptr->target_port;
+	v4_rule_ptr->pdn_index    = nat_rule_ptr->pdn_index;
+	v4_rule_ptr->redirect     = nat_rule_ptr->redirect;
+	v4_rule_ptr->enable       = nat_rule_ptr->enable;
+	v4_rule_ptr->time_stamp   = nat_rule_ptr->time_stamp;
+	v4_rule_ptr->uc_activation_index = nat_rule_ptr->uc_activation_index;
+	v4_rule_ptr->s = nat_rule_ptr->s;
+	v4_rule_ptr->ucp = nat_rule_ptr->ucp;
+	v4_rule_ptr->dst_only = nat_rule_ptr->dst_only;
+	v4_rule_ptr->src_only = nat_rule_ptr->src_only;
+}
+
 /******************************************************************************/
 /*
  * FUNCTION: migrate_rule
@@ -739,67 +983,438 @@ static int migrate_rule(
 
 	ret = ipa_nat_map_find(src_new2orig_map, tbl_rule_hdl, &orig_rule_hdl);
 
-	if ( ret != 0 )
+	if ( ret != 0 )
+	{
+		IPAERR("%s: ipa_nat_map_find(src_new2orig_map) fail\n", mig_dir_ptr);
+		goto bail;
+	}
+
+	nat_rule_to_v4_rule(nat_rule_ptr, &v4_rule);
+
+	ret = ipa_NATI_add_ipv4_rule(dst_tbl_hdl, &v4_rule, &new_rule_hdl);
+
+	if ( ret != 0 )
+	{
+		IPAERR("%s: ipa_NATI_add_ipv4_rule() fail\n", mig_dir_ptr);
+		goto bail;
+	}
+
+	(*cnt_ptr)++;
+
+	/*
+	 * The following is needed to maintain the original handle and
+	 * have it point to the new handle.
+	 *
+	 * Remember, original handle points to new and the new handle
+	 * points back to original.
+	 */
+	ret = ipa_nat_map_add(dst_orig2new_map, orig_rule_hdl, new_rule_hdl);
+
+	if ( ret != 0 )
+	{
+		IPAERR("%s: ipa_nat_map_add(dst_orig2new_map) fail\n", mig_dir_ptr);
+		goto bail;
+	}
+
+	ret = ipa_nat_map_add(dst_new2orig_map, new_rule_hdl, orig_rule_hdl);
+
+	if ( ret != 0 )
+	{
+		IPAERR("%s: ipa_nat_map_add(dst_new2orig_map) fail\n", mig_dir_ptr);
+		goto bail;
+	}
+
+	IPADBG("orig_rule_hdl(0x%08X) new_rule_hdl(0x%08X)\n",
+		   orig_rule_hdl, new_rule_hdl);
+
+bail:
+	IPADBG("Out\n");
+
+	return ret;
+}
+
+/*
+ * ****************************************************************************
+ *
+ * TIERED MODE HELPERS
+ *
+ * ****************************************************************************
+ *
+ * The IPA only ever looks at one NAT table. In tiered mode that is
+ * the SRAM table, and rather than moving everything to DDR once SRAM
+ * fills up, rules that have gone idle are moved (demoted) to the DDR
+ * table, where they are parked. Parked rules are not seen by the IPA;
+ * their packets take the apps path until the rule is promoted back
+ * into SRAM by a later rebalance.
+ *
+ * Idleness comes from the rule timestamps the IPA refreshes on every
+ * hit. Parked rules are not hit, so they are promoted as SRAM room
+ * allows and demoted again if they stay idle there.
+ *
+ * Rules move between tables, hence the handles given to the
+ * application come from tier_next_orig_hdl() rather than from a table
+ * and are mapped just like in the non-tiered hybrid case.
+ */
+typedef struct
+{
+	uint32_t          orig_rule_hdl;
+	uint32_t          rule_hdl;
+	uint32_t          idle;
+	ipa_nat_ipv4_rule v4_rule;
+} tier_cand;
+
+typedef struct
+{
+	tier_cand* cands;
+	uint32_t   max;
+	uint32_t   cnt;
+} tier_scan;
+
+static uint32_t tier_next_orig_hdl(
+	ipa_nati_obj* nati_obj_ptr )
+{
+	nati_obj_ptr->tier_seq =
+		(nati_obj_ptr->tier_seq + 1) & ~TIER_ORIG_HDL_BIT;
+
+	return TIER_ORIG_HDL_BIT | nati_obj_ptr->tier_seq;
+}
+
+static uint32_t tier_promote_hold(void)
+{
+	uint32_t hold = nati_obj.tier_idle_passes * TIER_PROMOTE_HOLD;
+
+	return (hold < 0xFF) ? hold : 0xFF;
+}
+
+static void tier_reset_parked(
+	ipa_nati_obj* nati_obj_ptr )
+{
+	nati_obj_ptr->tot_rules_in_table[DDR_SUB] = 0;
+
+	ipa_nat_map_clear(nati_obj_ptr->map_pairs[DDR_SUB].orig2new_map);
+	ipa_nat_map_clear(nati_obj_ptr->map_pairs[DDR_SUB].new2orig_map);
+
+	if ( VALID_TBL_HDL(nati_obj_ptr->ddr_tbl_hdl) )
+	{
+		ipa_NATI_clear_ipv4_tbl(nati_obj_ptr->ddr_tbl_hdl);
+	}
+}
+
+/******************************************************************************/
+/*
+ * FUNCTION: tier_scan_rule
+ *
+ * DESCRIPTION:
+ *
+ *   An ipa_table_walk() callback. For the SRAM table, updates the
+ *   rule's activity and collects it when it has been idle long
+ *   enough.  For the DDR table, collects the parked rules that may be
+ *   promoted: rules parked on add right away, demoted rules once
+ *   they have been parked TIER_PROMOTE_HOLD times the idle passes.
+ *   The IPA never hits a parked rule, so this hold is what keeps
+ *   idle rules from bouncing between the tiers.
+ *
+ * RETURNS:
+ *
+ *   zero, so the walk continues
+ */
+static int tier_scan_rule(
+	ipa_table*      table_ptr,
+	uint32_t        tbl_rule_hdl,
+	void*           record_ptr,
+	uint16_t        record_index,
+	void*           meta_record_ptr,
+	uint16_t        meta_record_index,
+	void*           arb_data_ptr )
+{
+	struct ipa_nat_rule* nat_rule_ptr = (struct ipa_nat_rule*) record_ptr;
+	tier_scan*           scan_ptr     = (tier_scan*) arb_data_ptr;
+	bool                 in_sram      = (table_ptr->nmi == IPA_NAT_MEM_IN_SRAM);
+	uint32_t             sub          = (in_sram) ? SRAM_SUB : DDR_SUB;
+
+	uint32_t             orig_rule_hdl, act;
+	uint32_t             idle = 0;
+
+	tier_cand*           cand_ptr;
+
+	if ( nat_rule_ptr->protocol == IPA_NAT_INVALID_PROTO_FIELD_VALUE_IN_RULE )
+	{
+		goto bail;
+	}
+
+	if ( ipa_nat_map_find(
+			 nati_obj.map_pairs[sub].new2orig_map,
+			 tbl_rule_hdl,
+			 &orig_rule_hdl) != 0 )
+	{
+		goto bail;
+	}
+
+	if ( in_sram )
+	{
+		/*
+		 * A rule is idle when its timestamp has not moved since the
+		 * previous pass...
+		 */
+		if ( ipa_nat_map_del(TIER_ACTIVITY_MAP, orig_rule_hdl, &act) == 0
+			 &&
+			 TIER_ACT_TS(act) == nat_rule_ptr->time_stamp )
+		{
+			idle = TIER_ACT_IDLE(act);
+
+			if ( idle < 0xFF )
+			{
+				idle++;
+			}
+		}
+
+		ipa_nat_map_add(
+			TIER_ACTIVITY_MAP,
+			orig_rule_hdl,
+			TIER_ACT(nat_rule_ptr->time_stamp, idle));
+
+		if ( idle < nati_obj.tier_idle_passes )
+		{
+			goto bail;
+		}
+	}
+	else if ( ipa_nat_map_del(TIER_ACTIVITY_MAP, orig_rule_hdl, &act) == 0 )
+	{
+		idle = TIER_ACT_IDLE(act);
+
+		if ( idle < 0xFF )
+		{
+			idle++;
+		}
+
+		ipa_nat_map_add(TIER_ACTIVITY_MAP, orig_rule_hdl, TIER_ACT(0, idle));
+
+		if ( idle < tier_promote_hold() )
+		{
+			goto bail;
+		}
+	}
+
+	if ( scan_ptr->cnt < scan_ptr->max )
+	{
+		cand_ptr = &scan_ptr->cands[scan_ptr->cnt++];
+
+		cand_ptr->orig_rule_hdl = orig_rule_hdl;
+		cand_ptr->rule_hdl      = tbl_rule_hdl;
+		cand_ptr->idle          = idle;
+
+		nat_rule_to_v4_rule(nat_rule_ptr, &cand_ptr->v4_rule);
+	}
+
+bail:
+	return 0;
+}
+
+static int tier_cmp_idle(
+	const void* a,
+	const void* b )
+{
+	const tier_cand* ca = a;
+	const tier_cand* cb = b;
+
+	/* Most idle first */
+	return (int) cb->idle - (int) ca->idle;
+}
+
+/******************************************************************************/
+/*
+ * FUNCTION: tier_move_rule
+ *
+ * DESCRIPTION:
+ *
+ *   Moves a rule from one table to the other, keeping its original
+ *   handle.  The rule is added to the destination before it is
+ *   removed from the source, so it is never lost.
+ *
+ * RETURNS:
+ *
+ *   zero on success, otherwise non-zero
+ */
+static int tier_move_rule(
+	ipa_nati_obj* nati_obj_ptr,
+	tier_cand*    cand_ptr,
+	uint32_t      src_sub,
+	uint32_t      dst_sub )
+{
+	uint32_t src_tbl_hdl = (src_sub == SRAM_SUB) ?
+		nati_obj_ptr->sram_tbl_hdl : nati_obj_ptr->ddr_tbl_hdl;
+	uint32_t dst_tbl_hdl = (dst_sub == SRAM_SUB) ?
+		nati_obj_ptr->sram_tbl_hdl : nati_obj_ptr->ddr_tbl_hdl;
+
+	nati_map_pair* src_maps = &nati_obj_ptr->map_pairs[src_sub];
+	nati_map_pair* dst_maps = &nati_obj_ptr->map_pairs[dst_sub];
+
+	uint32_t new_rule_hdl;
+
+	int ret;
+
+	ret = ipa_NATI_add_ipv4_rule(dst_tbl_hdl, &cand_ptr->v4_rule, &new_rule_hdl);
+
+	if ( ret != 0 )
+	{
+		IPADBG("Unable to add orig_rule_hdl(0x%08X) to %s\n",
+			   cand_ptr->orig_rule_hdl,
+			   (dst_sub == SRAM_SUB) ? "SRAM" : "DDR");
+		goto bail;
+	}
+
+	ret = ipa_NATI_del_ipv4_rule(src_tbl_hdl, cand_ptr->rule_hdl);
+
+	if ( ret != 0 )
+	{
+		IPAERR("Unable to delete rule_hdl(0x%08X) from %s\n",
+			   cand_ptr->rule_hdl,
+			   (src_sub == SRAM_SUB) ? "SRAM" : "DDR");
+		ipa_NATI_del_ipv4_rule(dst_tbl_hdl, new_rule_hdl);
+		goto bail;
+	}
+
+	ipa_nat_map_del(src_maps->orig2new_map, cand_ptr->orig_rule_hdl, NULL);
+	ipa_nat_map_del(src_maps->new2orig_map, cand_ptr->rule_hdl, NULL);
+
+	ipa_nat_map_add(dst_maps->orig2new_map, cand_ptr->orig_rule_hdl, new_rule_hdl);
+	ipa_nat_map_add(dst_maps->new2orig_map, new_rule_hdl, cand_ptr->orig_rule_hdl);
+
+	nati_obj_ptr->tot_rules_in_table[src_sub]--;
+	nati_obj_ptr->tot_rules_in_table[dst_sub]++;
+
+	ipa_nat_map_del(TIER_ACTIVITY_MAP, cand_ptr->orig_rule_hdl, NULL);
+
+	if ( dst_sub == SRAM_SUB )
+	{
+		ipa_nat_map_add(
+			TIER_ACTIVITY_MAP,
+			cand_ptr->orig_rule_hdl,
+			TIER_ACT(cand_ptr->v4_rule.time_stamp, 0));
+
+		nati_obj_ptr->tier_promoted++;
+	}
+	else
+	{
+		/* Start the hold before it can come back */
+		ipa_nat_map_add(
+			TIER_ACTIVITY_MAP,
+			cand_ptr->orig_rule_hdl,
+			TIER_ACT(0, 0));
+
+		nati_obj_ptr->tier_demoted++;
+	}
+
+bail:
+	return ret;
+}
+
+/******************************************************************************/
+/*
+ * FUNCTION: tier_rebalance
+ *
+ * PARAMS:
+ *
+ *   nati_obj_ptr (IN) A pointer to an initialized nati object
+ *
+ *   want_free    (IN) SRAM slots wanted beyond those needed for the
+ *                     parked rules
+ *
+ * DESCRIPTION:
+ *
+ *   Demotes the most idle SRAM rules, as many as there are parked
+ *   rules due for promotion plus want_free, then promotes those
+ *   parked rules for as long as SRAM takes them.
+ *
+ * RETURNS:
+ *
+ *   zero on success, otherwise non-zero
+ */
+static int tier_rebalance(
+	ipa_nati_obj* nati_obj_ptr,
+	uint32_t      want_free )
+{
+	tier_scan cold   = { NULL, nati_obj_ptr->tot_rules_in_table[SRAM_SUB], 0 };
+	tier_scan parked = { NULL, nati_obj_ptr->tot_rules_in_table[DDR_SUB],  0 };
+
+	uint32_t  i, to_demote;
+	uint32_t  demoted  = nati_obj_ptr->tier_demoted;
+	uint32_t  promoted = nati_obj_ptr->tier_promoted;
+
+	int       ret = 0;
+
+	IPADBG("In\n");
+
+	if ( (cold.max   && ! (cold.cands   = calloc(cold.max,   sizeof(tier_cand)))) ||
+		 (parked.max && ! (parked.cands = calloc(parked.max, sizeof(tier_cand)))) )
 	{
-		IPAERR("%s: ipa_nat_map_find(src_new2orig_map) fail\n", mig_dir_ptr);
+		IPAERR("Unable to allocate tier scan arrays\n");
+		ret = -ENOMEM;
 		goto bail;
 	}
 
-	memset(&v4_rule, 0, sizeof(v4_rule));
-
-	v4_rule.private_ip   = nat_rule_ptr->private_ip;
-	v4_rule.private_port = nat_rule_ptr->private_port;
-	v4_rule.protocol     = nat_rule_ptr->protocol;
-	v4_rule.public_port  = nat_rule_ptr->public_port;
-	v4_rule.target_ip    = nat_rule_ptr->target_ip;
-	v4_rule.target_port  = nat_rule_ptr->target_port;
-	v4_rule.pdn_index    = nat_rule_ptr->pdn_index;
-	v4_rule.redirect     = nat_rule_ptr->redirect;
-	v4_rule.enable       = nat_rule_ptr->enable;
-	v4_rule.time_stamp   = nat_rule_ptr->time_stamp;
-	v4_rule.uc_activation_index = nat_rule_ptr->uc_activation_index;
-	v4_rule.s = nat_rule_ptr->s;
-	v4_rule.ucp = nat_rule_ptr->ucp;
-	v4_rule.dst_only = nat_rule_ptr->dst_only;
-	v4_rule.src_only = nat_rule_ptr->src_only;
+	if ( cold.max )
+	{
+		ret = ipa_NATI_walk_ipv4_tbl(
+			nati_obj_ptr->sram_tbl_hdl, USE_NAT_TABLE, tier_scan_rule, &cold);
 
-	ret = ipa_NATI_add_ipv4_rule(dst_tbl_hdl, &v4_rule, &new_rule_hdl);
+		if ( ret != 0 )
+		{
+			goto bail;
+		}
+	}
 
-	if ( ret != 0 )
+	/*
+	 * Snapshot the parked rules before demoting, so the rules demoted
+	 * below are not promoted right back...
+	 */
+	if ( parked.max )
 	{
-		IPAERR("%s: ipa_NATI_add_ipv4_rule() fail\n", mig_dir_ptr);
-		goto bail;
+		ret = ipa_NATI_walk_ipv4_tbl(
+			nati_obj_ptr->ddr_tbl_hdl, USE_NAT_TABLE, tier_scan_rule, &parked);
+
+		if ( ret != 0 )
+		{
+			goto bail;
+		}
 	}
 
-	(*cnt_ptr)++;
+	to_demote = parked.cnt + want_free;
 
-	/*
-	 * The following is needed to maintain the original handle and
-	 * have it point to the new handle.
-	 *
-	 * Remember, original handle points to new and the new handle
-	 * points back to original.
-	 */
-	ret = ipa_nat_map_add(dst_orig2new_map, orig_rule_hdl, new_rule_hdl);
+	if ( to_demote > cold.cnt )
+	{
+		to_demote = cold.cnt;
+	}
 
-	if ( ret != 0 )
+	if ( to_demote )
 	{
-		IPAERR("%s: ipa_nat_map_add(dst_orig2new_map) fail\n", mig_dir_ptr);
-		goto bail;
+		qsort(cold.cands, cold.cnt, sizeof(tier_cand), tier_cmp_idle);
 	}
 
-	ret = ipa_nat_map_add(dst_new2orig_map, new_rule_hdl, orig_rule_hdl);
+	for ( i = 0; i < to_demote; i++ )
+	{
+		tier_move_rule(nati_obj_ptr, &cold.cands[i], SRAM_SUB, DDR_SUB);
+	}
 
-	if ( ret != 0 )
+	for ( i = 0; i < parked.cnt; i++ )
 	{
-		IPAERR("%s: ipa_nat_map_add(dst_new2orig_map) fail\n", mig_dir_ptr);
-		goto bail;
+		if ( tier_move_rule(nati_obj_ptr, &parked.cands[i], DDR_SUB, SRAM_SUB) != 0 )
+		{
+			break;
+		}
 	}
 
-	IPADBG("orig_rule_hdl(0x%08X) new_rule_hdl(0x%08X)\n",
-		   orig_rule_hdl, new_rule_hdl);
+	IPADBG("idle(%u) demoted(%u) promoted(%u) -> SRAM(%u) DDR(%u)\n",
+		   cold.cnt,
+		   nati_obj_ptr->tier_demoted  - demoted,
+		   nati_obj_ptr->tier_promoted - promoted,
+		   nati_obj_ptr->tot_rules_in_table[SRAM_SUB],
+		   nati_obj_ptr->tot_rules_in_table[DDR_SUB]);
 
 bail:
+	free(cold.cands);
+	free(parked.cands);
+
 	IPADBG("Out\n");
 
 	return ret;
@@ -1121,6 +1736,7 @@ static int _smAddSramAndDdrTbl(
 	ipa_nat_map_clear(nati_obj_ptr->map_pairs[SRAM_SUB].new2orig_map);
 	ipa_nat_map_clear(nati_obj_ptr->map_pairs[DDR_SUB].orig2new_map);
 	ipa_nat_map_clear(nati_obj_ptr->map_pairs[DDR_SUB].new2orig_map);
+	ipa_nat_map_clear(TIER_ACTIVITY_MAP);
 
 	ret = _smAddSramTbl(nati_obj_ptr, trigger, arb_data_ptr);
 
@@ -1215,6 +1831,7 @@ static int _smDelSramAndDdrTbl(
 	ipa_nat_map_clear(nati_obj_ptr->map_pairs[SRAM_SUB].new2orig_map);
 	ipa_nat_map_clear(nati_obj_ptr->map_pairs[DDR_SUB].orig2new_map);
 	ipa_nat_map_clear(nati_obj_ptr->map_pairs[DDR_SUB].new2orig_map);
+	ipa_nat_map_clear(TIER_ACTIVITY_MAP);
 
 	ret = _smDelTbl(nati_obj_ptr, trigger, arb_data_ptr);
 
@@ -1344,6 +1961,19 @@ static int _smClrTblHybrid(
 
 	ret = _smClrTbl(nati_obj_ptr, trigger, new_args);
 
+	if ( ret == 0
+		 &&
+		 nati_obj_ptr->tiered
+		 &&
+		 nati_obj_ptr->curr_state == NATI_STATE_HYBRID )
+	{
+		/*
+		 * The parked rules go too...
+		 */
+		tier_reset_parked(nati_obj_ptr);
+		ipa_nat_map_clear(TIER_ACTIVITY_MAP);
+	}
+
 	IPADBG("Out\n");
 
 	return ret;
@@ -1654,6 +2284,191 @@ static int _smDelRuleFromTbl(
 	return ret;
 }
 
+/******************************************************************************/
+/*
+ * FUNCTION: _smAddRuleTiered
+ *
+ * PARAMS:
+ *
+ *   nati_obj_ptr (IN) A pointer to an initialized nati object
+ *
+ *   trigger      (IN) The trigger to run through the state machine
+ *
+ *   arb_data_ptr (IN) Whatever you like
+ *
+ * DESCRIPTION:
+ *
+ *   The following will cause the addition of a NAT rule while in
+ *   tiered mode.  New rules go to SRAM.  When SRAM is full, idle
+ *   rules are demoted to make room and, failing that, the new rule
+ *   is parked in DDR.
+ *
+ * RETURNS:
+ *
+ *   zero on success, otherwise non-zero
+ */
+static int _smAddRuleTiered(
+	ipa_nati_obj*    nati_obj_ptr,
+	ipa_nati_trigger trigger,
+	arb_t*           arb_data_ptr )
+{
+	arb_t** args = arb_data_ptr;
+
+	ipa_nat_ipv4_rule* clnt_rule = (ipa_nat_ipv4_rule*) args[1];
+	uint32_t*          rule_hdl  = (uint32_t*)          args[2];
+
+	uint32_t sub = SRAM_SUB;
+	uint32_t new_rule_hdl, orig_rule_hdl;
+
+	int ret;
+
+	IPADBG("In\n");
+
+	clnt_rule->redirect = clnt_rule->enable = clnt_rule->time_stamp = 0;
+
+	ret = ipa_NATI_add_ipv4_rule(
+		nati_obj_ptr->sram_tbl_hdl, clnt_rule, &new_rule_hdl);
+
+	if ( ret != 0 )
+	{
+		IPAINFO("Add of rule to SRAM failed...attempting demotion of idle rules\n");
+
+		tier_rebalance(nati_obj_ptr, 1);
+
+		ret = ipa_NATI_add_ipv4_rule(
+			nati_obj_ptr->sram_tbl_hdl, clnt_rule, &new_rule_hdl);
+	}
+
+	if ( ret != 0 )
+	{
+		IPAINFO("No idle rules in SRAM...parking rule in DDR\n");
+
+		sub = DDR_SUB;
+
+		ret = ipa_NATI_add_ipv4_rule(
+			nati_obj_ptr->ddr_tbl_hdl, clnt_rule, &new_rule_hdl);
+	}
+
+	if ( ret == 0 )
+	{
+		orig_rule_hdl = tier_next_orig_hdl(nati_obj_ptr);
+
+		nati_obj_ptr->tot_rules_in_table[sub]++;
+
+		ret = ipa_nat_map_add(
+			nati_obj_ptr->map_pairs[sub].orig2new_map,
+			orig_rule_hdl, new_rule_hdl);
+
+		if ( ret == 0 )
+		{
+			ret = ipa_nat_map_add(
+				nati_obj_ptr->map_pairs[sub].new2orig_map,
+				new_rule_hdl, orig_rule_hdl);
+		}
+
+		if ( ret == 0 )
+		{
+			/*
+			 * A rule parked on add is new, not idle, so it may be
+			 * promoted right away...
+			 */
+			ret = ipa_nat_map_add(
+				TIER_ACTIVITY_MAP, orig_rule_hdl,
+				TIER_ACT(0, (sub == SRAM_SUB) ? 0 : 0xFF));
+		}
+
+		*rule_hdl = orig_rule_hdl;
+
+		IPADBG("orig_rule_hdl(0x%08X) -> %s rule_hdl(0x%08X)\n",
+			   orig_rule_hdl,
+			   (sub == SRAM_SUB) ? "SRAM" : "DDR",
+			   new_rule_hdl);
+	}
+
+	IPADBG("Out\n");
+
+	return ret;
+}
+
+/******************************************************************************/
+/*
+ * FUNCTION: _smDelRuleTiered
+ *
+ * PARAMS:
+ *
+ *   nati_obj_ptr (IN) A pointer to an initialized nati object
+ *
+ *   trigger      (IN) The trigger to run through the state machine
+ *
+ *   arb_data_ptr (IN) Whatever you like
+ *
+ * DESCRIPTION:
+ *
+ *   The following will cause the deletion of a NAT rule while in
+ *   tiered mode, from SRAM or, if parked, from DDR.
+ *
+ * RETURNS:
+ *
+ *   zero on success, otherwise non-zero
+ */
+static int _smDelRuleTiered(
+	ipa_nati_obj*    nati_obj_ptr,
+	ipa_nati_trigger trigger,
+	arb_t*           arb_data_ptr )
+{
+	arb_t**  args = arb_data_ptr;
+
+	uint32_t orig_rule_hdl = (uint32_t) args[1];
+
+	uint32_t sub = SRAM_SUB;
+	uint32_t new_rule_hdl, tbl_hdl;
+
+	int      ret;
+
+	IPADBG("In\n");
+
+	ret = ipa_nat_map_del(
+		nati_obj_ptr->map_pairs[SRAM_SUB].orig2new_map,
+		orig_rule_hdl, &new_rule_hdl);
+
+	if ( ret != 0 && nati_obj_ptr->tot_rules_in_table[DDR_SUB] )
+	{
+		sub = DDR_SUB;
+
+		ret = ipa_nat_map_del(
+			nati_obj_ptr->map_pairs[DDR_SUB].orig2new_map,
+			orig_rule_hdl, &new_rule_hdl);
+	}
+
+	if ( ret == 0 )
+	{
+		IPADBG("orig_rule_hdl(0x%08X) -> %s rule_hdl(0x%08X)\n",
+			   orig_rule_hdl,
+			   (sub == SRAM_SUB) ? "SRAM" : "DDR",
+			   new_rule_hdl);
+
+		ipa_nat_map_del(
+			nati_obj_ptr->map_pairs[sub].new2orig_map, new_rule_hdl, NULL);
+
+		ipa_nat_map_del(TIER_ACTIVITY_MAP, orig_rule_hdl, NULL);
+
+		tbl_hdl = (sub == SRAM_SUB) ?
+			nati_obj_ptr->sram_tbl_hdl :
+			nati_obj_ptr->ddr_tbl_hdl;
+
+		ret = ipa_NATI_del_ipv4_rule(tbl_hdl, new_rule_hdl);
+
+		if ( ret == 0 )
+		{
+			nati_obj_ptr->tot_rules_in_table[sub]--;
+		}
+	}
+
+	IPADBG("Out\n");
+
+	return ret;
+}
+
 /******************************************************************************/
 /*
  * FUNCTION: _smAddRuleHybrid
@@ -1706,6 +2521,12 @@ static int _smAddRuleHybrid(
 
 	IPADBG("In\n");
 
+	if ( nati_obj_ptr->tiered && nati_obj_ptr->curr_state == NATI_STATE_HYBRID )
+	{
+		ret = _smAddRuleTiered(nati_obj_ptr, trigger, arb_data_ptr);
+		goto bail;
+	}
+
 	ret = _smAddRuleToTbl(nati_obj_ptr, trigger, new_args);
 
 	if ( ret == 0 )
@@ -1771,6 +2592,7 @@ static int _smAddRuleHybrid(
 		}
 	}
 
+bail:
 	IPADBG("Out\n");
 
 	return ret;
@@ -1821,6 +2643,12 @@ static int _smDelRuleHybrid(
 
 	IPADBG("In\n");
 
+	if ( nati_obj_ptr->tiered && nati_obj_ptr->curr_state == NATI_STATE_HYBRID )
+	{
+		ret = _smDelRuleTiered(nati_obj_ptr, trigger, arb_data_ptr);
+		goto bail;
+	}
+
 	CHOOSE_MAPS(orig2new_map, new2orig_map);
 
 	/*
@@ -1907,6 +2735,7 @@ static int _smDelRuleHybrid(
 		}
 	}
 
+bail:
 	IPADBG("Out\n");
 
 	return ret;
@@ -2062,6 +2891,7 @@ static int _smSwitchFromDdrToSram(
 		 */
 		ipa_nat_map_clear(nati_obj.map_pairs[SRAM_SUB].orig2new_map);
 		ipa_nat_map_clear(nati_obj.map_pairs[SRAM_SUB].new2orig_map);
+		ipa_nat_map_clear(TIER_ACTIVITY_MAP);
 
 		/*
 		 * Now copy DDR's content to SRAM...
@@ -2077,6 +2907,15 @@ static int _smSwitchFromDdrToSram(
 		{
 			sw_stats_ptr->pass += 1;
 
+			if ( nati_obj_ptr->tiered )
+			{
+				/*
+				 * Everything is in SRAM now and DDR becomes the
+				 * (empty) parking area...
+				 */
+				tier_reset_parked(nati_obj_ptr);
+			}
+
 			IPADBG("Transistion from DDR to SRAM took %f microseconds\n",
 				   (float) (stop - start) / 1000.0);
 		}
@@ -2222,24 +3061,41 @@ static int _smSwitchFromSramToDdr(
 
 	if ( ret == 0 )
 	{
-		/*
-		 * Clear destination counter...
-		 */
-		nati_obj_ptr->tot_rules_in_table[DDR_SUB] = 0;
+		ipa_nat_map_clear(TIER_ACTIVITY_MAP);
 
-		/*
-		 * Clear destination DDR maps...
-		 */
-		ipa_nat_map_clear(nati_obj.map_pairs[DDR_SUB].orig2new_map);
-		ipa_nat_map_clear(nati_obj.map_pairs[DDR_SUB].new2orig_map);
+		if ( nati_obj_ptr->tiered )
+		{
+			/*
+			 * DDR holds the parked rules, which must be kept, so
+			 * add SRAM's content to them...
+			 */
+			ret = ipa_NATI_walk_ipv4_tbl(
+				nati_obj_ptr->sram_tbl_hdl,
+				USE_NAT_TABLE,
+				migrate_rule,
+				(void*)(arb_t) nati_obj_ptr->ddr_tbl_hdl);
+		}
+		else
+		{
+			/*
+			 * Clear destination counter...
+			 */
+			nati_obj_ptr->tot_rules_in_table[DDR_SUB] = 0;
 
-		/*
-		 * Now copy SRAM's content to DDR...
-		 */
-		ret = ipa_nati_copy_ipv4_tbl(
-			nati_obj_ptr->sram_tbl_hdl,
-			nati_obj_ptr->ddr_tbl_hdl,
-			migrate_rule);
+			/*
+			 * Clear destination DDR maps...
+			 */
+			ipa_nat_map_clear(nati_obj.map_pairs[DDR_SUB].orig2new_map);
+			ipa_nat_map_clear(nati_obj.map_pairs[DDR_SUB].new2orig_map);
+
+			/*
+			 * Now copy SRAM's content to DDR...
+			 */
+			ret = ipa_nati_copy_ipv4_tbl(
+				nati_obj_ptr->sram_tbl_hdl,
+				nati_obj_ptr->ddr_tbl_hdl,
+				migrate_rule);
+		}
 
 		currTimeAs(TimeAsNanSecs, &stop);
 
@@ -2429,12 +3285,34 @@ static int _smGetTmStmpHybrid(
 
 	ret = ipa_nat_map_find(orig2new_map, orig_rule_hdl, &new_rule_hdl);
 
+	if ( nati_obj_ptr->curr_state == NATI_STATE_HYBRID )
+	{
+		if ( ret != 0
+			 &&
+			 nati_obj_ptr->tiered
+			 &&
+			 nati_obj_ptr->tot_rules_in_table[DDR_SUB] )
+		{
+			/*
+			 * Parked in DDR, where the timestamp is the one from
+			 * its last hit in SRAM...
+			 */
+			ret = ipa_nat_map_find(
+				nati_obj_ptr->map_pairs[DDR_SUB].orig2new_map,
+				orig_rule_hdl, &new_rule_hdl);
+
+			tbl_hdl = nati_obj_ptr->ddr_tbl_hdl;
+		}
+	}
+	else
+	{
+		tbl_hdl = nati_obj_ptr->ddr_tbl_hdl;
+	}
+
 	if ( ret == 0 )
 	{
 		arb_t* new_args[] = {
-			(arb_t*)(arb_t)(nati_obj_ptr->curr_state == NATI_STATE_HYBRID) ?
-			         tbl_hdl :
-			         nati_obj_ptr->ddr_tbl_hdl,
+			(arb_t*)(arb_t)tbl_hdl,
 			(arb_t*)(arb_t)new_rule_hdl,
 			(arb_t*) time_stamp,
 		};
@@ -2447,6 +3325,46 @@ static int _smGetTmStmpHybrid(
 	return ret;
 }
 
+/******************************************************************************/
+/*
+ * FUNCTION: _smTierRebalance
+ *
+ * PARAMS:
+ *
+ *   nati_obj_ptr (IN) A pointer to an initialized nati object
+ *
+ *   trigger      (IN) The trigger to run through the state machine
+ *
+ *   arb_data_ptr (IN) Whatever you like
+ *
+ * DESCRIPTION:
+ *
+ *   Periodic tiered mode rebalance of SRAM and DDR.  Nothing to do
+ *   unless tiered and SRAM is the active table.
+ *
+ * RETURNS:
+ *
+ *   zero on success, otherwise non-zero
+ */
+static int _smTierRebalance(
+	ipa_nati_obj*    nati_obj_ptr,
+	ipa_nati_trigger trigger,
+	arb_t*           arb_data_ptr )
+{
+	int ret = 0;
+
+	IPADBG("In\n");
+
+	if ( nati_obj_ptr->tiered && nati_obj_ptr->curr_state == NATI_STATE_HYBRID )
+	{
+		ret = tier_rebalance(nati_obj_ptr, 0);
+	}
+
+	IPADBG("Out\n");
+
+	return ret;
+}
+
 /******************************************************************************/
 /*
  * The following table relates a nati object's state and a transition
@@ -2468,6 +3386,7 @@ _state_mach_tbl[NATI_STATE_LAST+1][NATI_TRIG_LAST+1] =
 		SM_ROW( NATI_STATE_NULL,       NATI_TRIG_GOTO_DDR,   _smUndef ),
 		SM_ROW( NATI_STATE_NULL,       NATI_TRIG_GOTO_SRAM,  _smUndef ),
 		SM_ROW( NATI_STATE_NULL,       NATI_TRIG_GET_TSTAMP, _smUndef ),
+		SM_ROW( NATI_STATE_NULL,       NATI_TRIG_TIER_REBAL, _smUndef ),
 		SM_ROW( NATI_STATE_NULL,       NATI_TRIG_LAST,       _smUndef ),
 	},
 
@@ -2484,6 +3403,7 @@ _state_mach_tbl[NATI_STATE_LAST+1][NATI_TRIG_LAST+1] =
 		SM_ROW( NATI_STATE_DDR_ONLY,   NATI_TRIG_GOTO_DDR,   _smUndef ),
 		SM_ROW( NATI_STATE_DDR_ONLY,   NATI_TRIG_GOTO_SRAM,  _smUndef ),
 		SM_ROW( NATI_STATE_DDR_ONLY,   NATI_TRIG_GET_TSTAMP, _smGetTmStmp ),
+		SM_ROW( NATI_STATE_DDR_ONLY,   NATI_TRIG_TIER_REBAL, _smUndef ),
 		SM_ROW( NATI_STATE_DDR_ONLY,   NATI_TRIG_LAST,       _smUndef ),
 	},
 
@@ -2500,6 +3420,7 @@ _state_mach_tbl[NATI_STATE_LAST+1][NATI_TRIG_LAST+1] =
 		SM_ROW( NATI_STATE_SRAM_ONLY,  NATI_TRIG_GOTO_DDR,   _smUndef ),
 		SM_ROW( NATI_STATE_SRAM_ONLY,  NATI_TRIG_GOTO_SRAM,  _smUndef ),
 		SM_ROW( NATI_STATE_SRAM_ONLY,  NATI_TRIG_GET_TSTAMP, _smGetTmStmp ),
+		SM_ROW( NATI_STATE_SRAM_ONLY,  NATI_TRIG_TIER_REBAL, _smUndef ),
 		SM_ROW( NATI_STATE_SRAM_ONLY,  NATI_TRIG_LAST,       _smUndef ),
 	},
 
@@ -2516,6 +3437,7 @@ _state_mach_tbl[NATI_STATE_LAST+1][NATI_TRIG_LAST+1] =
 		SM_ROW( NATI_STATE_HYBRID,     NATI_TRIG_GOTO_DDR,   _smGoToDdr ),
 		SM_ROW( NATI_STATE_HYBRID,     NATI_TRIG_GOTO_SRAM,  _smGoToSram ),
 		SM_ROW( NATI_STATE_HYBRID,     NATI_TRIG_GET_TSTAMP, _smGetTmStmpHybrid ),
+		SM_ROW( NATI_STATE_HYBRID,     NATI_TRIG_TIER_REBAL, _smTierRebalance ),
 		SM_ROW( NATI_STATE_HYBRID,     NATI_TRIG_LAST,       _smUndef ),
 	},
 
@@ -2532,6 +3454,7 @@ _state_mach_tbl[NATI_STATE_LAST+1][NATI_TRIG_LAST+1] =
 		SM_ROW( NATI_STATE_HYBRID_DDR, NATI_TRIG_GOTO_DDR,   _smGoToDdr ),
 		SM_ROW( NATI_STATE_HYBRID_DDR, NATI_TRIG_GOTO_SRAM,  _smGoToSram ),
 		SM_ROW( NATI_STATE_HYBRID_DDR, NATI_TRIG_GET_TSTAMP, _smGetTmStmpHybrid ),
+		SM_ROW( NATI_STATE_HYBRID_DDR, NATI_TRIG_TIER_REBAL, _smTierRebalance ),
 		SM_ROW( NATI_STATE_HYBRID_DDR, NATI_TRIG_LAST,       _smUndef ),
 	},
 
@@ -2548,6 +3471,7 @@ _state_mach_tbl[NATI_STATE_LAST+1][NATI_TRIG_LAST+1] =
 		SM_ROW( NATI_STATE_LAST,       NATI_TRIG_GOTO_DDR,   _smUndef ),
 		SM_ROW( NATI_STATE_LAST,       NATI_TRIG_GOTO_SRAM,  _smUndef ),
 		SM_ROW( NATI_STATE_LAST,       NATI_TRIG_GET_TSTAMP, _smUndef ),
+		SM_ROW( NATI_STATE_LAST,       NATI_TRIG_TIER_REBAL, _smUndef ),
 		SM_ROW( NATI_STATE_LAST,       NATI_TRIG_LAST,       _smUndef ),
 	},
 };
@@ -0,0 +1,297 @@
+/*
+ * Copyright (c) 2026 Qualcomm Innovation Center, Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *  * Neither the name of The Linux Foundation nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+ * BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN
+ * IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*=========================================================================*/
+/*!
+	@file
+	ipa_nat_test026.c
+
+	@brief
+	Verify the following scenario:
+	1. Turn on tiering (only has an effect in HYBRID mode)
+	2. Add ipv4 rules until SRAM is full and one gets parked in DDR
+	3. Keep hitting a hot set of rules while rebalancing
+	4. Check the hot rules stay in SRAM, the parked rule is promoted
+	   and an idle rule is demoted in its place
+	5. Check the demoted rule is held in DDR, then promoted again
+	6. Delete all rules
+	7. Turn off tiering
+*/
+/*=========================================================================*/
+
+#include "ipa_nat_test.h"
+
+#define TIER_TEST_IDLE_PASSES 2
+#define TIER_TEST_HOLD        (TIER_TEST_IDLE_PASSES * 4) /* TIER_PROMOTE_HOLD */
+#define TIER_TEST_HOT_RULES   4
+#define TIER_TEST_BASE_PORT   1024
+
+/*
+ * Stands in for the IPA by moving the timestamp of the hot rules,
+ * which is what a hit does...
+ */
+static int tier_test_hit(
+	ipa_table*      table_ptr,
+	uint32_t        rule_hdl,
+	void*           record_ptr,
+	uint16_t        record_index,
+	void*           meta_record_ptr,
+	uint16_t        meta_record_index,
+	void*           arb_data_ptr )
+{
+	struct ipa_nat_rule* rule_ptr = (struct ipa_nat_rule*) record_ptr;
+
+	if ( rule_ptr->protocol != IPA_NAT_INVALID_PROTO_FIELD_VALUE_IN_RULE
+		 &&
+		 rule_ptr->private_port >= TIER_TEST_BASE_PORT
+		 &&
+		 rule_ptr->private_port < TIER_TEST_BASE_PORT + TIER_TEST_HOT_RULES )
+	{
+		rule_ptr->time_stamp = (rule_ptr->time_stamp + 1) & 0xFFFFFF;
+	}
+
+	return 0;
+}
+
+/*
+ * Hits the hot rules, rebalances and checks they are all still in
+ * SRAM...
+ */
+static int tier_test_pass(
+	u32        tbl_hdl,
+	const u32* rule_hdls )
+{
+	enum ipa3_nat_mem_in nmi;
+
+	u32 i;
+
+	int ret;
+
+	ret = ipa_nati_walk_ipv4_tbl(tbl_hdl, USE_NAT_TABLE, tier_test_hit, NULL);
+
+	if ( ret == 0 )
+	{
+		ret = ipa_nat_tier_rebalance();
+	}
+
+	for ( i = 0; ret == 0 && i < TIER_TEST_HOT_RULES; i++ )
+	{
+		ret = ipa_nat_query_tier(rule_hdls[i], &nmi);
+
+		if ( ret == 0 && nmi != IPA_NAT_MEM_IN_SRAM )
+		{
+			IPAERR("Hot rule_hdl(0x%08X) left SRAM\n", rule_hdls[i]);
+			ret = -1;
+		}
+	}
+
+	return ret;
+}
+
+int ipa_nat_test026(
+	const char* nat_mem_type,
+	u32 pub_ip_add,
+	int total_entries,
+	u32 tbl_hdl,
+	int sep,
+	void* arb_data_ptr)
+{
+	int* tbl_hdl_ptr = (int*) arb_data_ptr;
+
+	ipa_nat_ipv4_rule    ipv4_rule;
+	enum ipa3_nat_mem_in nmi;
+	u32*                 rule_hdls;
+	u32                  parked_hdl = 0, demoted_hdl = 0;
+
+	u32                  i, tot, pass;
+
+	int ret;
+
+	IPADBG("In\n");
+
+	if ( sep )
+	{
+		ret = ipa_nat_add_ipv4_tbl(pub_ip_add, nat_mem_type, total_entries, &tbl_hdl);
+		CHECK_ERR_TBL_STOP(ret, tbl_hdl);
+	}
+
+	ret = ipa_nat_set_tiering(true, TIER_TEST_IDLE_PASSES);
+	CHECK_ERR_TBL_STOP(ret, tbl_hdl);
+
+	rule_hdls = calloc(total_entries, sizeof(u32));
+
+	ret = (rule_hdls) ? 0 : -1;
+	CHECK_ERR_TBL_STOP(ret, tbl_hdl);
+
+	for ( i = tot = 0; i < (u32) total_entries; i++ )
+	{
+		memset(&ipv4_rule, 0, sizeof(ipv4_rule));
+
+		ipv4_rule.protocol     = IPPROTO_TCP;
+		ipv4_rule.public_port  = RAN_PORT;
+		ipv4_rule.target_ip    = RAN_ADDR;
+		ipv4_rule.target_port  = RAN_PORT;
+		ipv4_rule.private_ip   = RAN_ADDR;
+		ipv4_rule.private_port = TIER_TEST_BASE_PORT + i;
+
+		ret = ipa_nat_add_ipv4_rule(tbl_hdl, &ipv4_rule, &rule_hdls[i]);
+		CHECK_ERR_TBL_ACTION(ret, tbl_hdl, break);
+
+		tot++;
+
+		ret = ipa_nat_query_tier(rule_hdls[i], &nmi);
+
+		if ( ret != 0 )
+		{
+			break;
+		}
+
+		if ( nmi == IPA_NAT_MEM_IN_DDR )
+		{
+			parked_hdl = rule_hdls[i];
+			break;
+		}
+	}
+
+	IPAINFO("Added (%u) rules, parked rule_hdl(0x%08X)\n", tot, parked_hdl);
+
+	if ( ! parked_hdl || tot <= TIER_TEST_HOT_RULES + 1 )
+	{
+		/*
+		 * Not in HYBRID mode or SRAM never filled up, so there are
+		 * no tiers to check...
+		 */
+		IPAINFO("Nothing parked, skipping the tier checks\n");
+		ret = 0;
+		goto cleanup;
+	}
+
+	/*
+	 * The rules in SRAM have all been seen once by the rebalance
+	 * that failed to make room for the parked one.  One more pass
+	 * makes the cold ones idle, so the parked rule trades places
+	 * with one of them...
+	 */
+	ret = tier_test_pass(tbl_hdl, rule_hdls);
+	CHECK_ERR_TBL_ACTION(ret, tbl_hdl, goto cleanup);
+
+	ret = ipa_nat_query_tier(parked_hdl, &nmi);
+	CHECK_ERR_TBL_ACTION(ret, tbl_hdl, goto cleanup);
+
+	if ( nmi != IPA_NAT_MEM_IN_SRAM )
+	{
+		IPAERR("Parked rule_hdl(0x%08X) was not promoted\n", parked_hdl);
+		ret = -1;
+		goto cleanup;
+	}
+
+	for ( i = TIER_TEST_HOT_RULES; i < tot && ! demoted_hdl; i++ )
+	{
+		ret = ipa_nat_query_tier(rule_hdls[i], &nmi);
+		CHECK_ERR_TBL_ACTION(ret, tbl_hdl, goto cleanup);
+
+		if ( nmi == IPA_NAT_MEM_IN_DDR )
+		{
+			demoted_hdl = rule_hdls[i];
+		}
+	}
+
+	if ( ! demoted_hdl )
+	{
+		IPAERR("No idle rule was demoted\n");
+		ret = -1;
+		goto cleanup;
+	}
+
+	/*
+	 * The demoted rule is held in DDR for a while, then comes back
+	 * in place of another idle rule...
+	 */
+	for ( pass = 1; ; pass++ )
+	{
+		ret = tier_test_pass(tbl_hdl, rule_hdls);
+		CHECK_ERR_TBL_ACTION(ret, tbl_hdl, goto cleanup);
+
+		ret = ipa_nat_query_tier(demoted_hdl, &nmi);
+		CHECK_ERR_TBL_ACTION(ret, tbl_hdl, goto cleanup);
+
+		if ( nmi == IPA_NAT_MEM_IN_SRAM )
+		{
+			break;
+		}
+
+		if ( pass > 2 * TIER_TEST_HOLD )
+		{
+			IPAERR("Demoted rule_hdl(0x%08X) was never promoted\n",
+				   demoted_hdl);
+			ret = -1;
+			goto cleanup;
+		}
+	}
+
+	if ( pass < TIER_TEST_HOLD )
+	{
+		IPAERR("Demoted rule_hdl(0x%08X) promoted after only (%u) passes\n",
+			   demoted_hdl, pass);
+		ret = -1;
+		goto cleanup;
+	}
+
+	IPAINFO("Demoted rule_hdl(0x%08X) promoted after (%u) passes\n",
+			demoted_hdl, pass);
+
+cleanup:
+	for ( i = 0; i < tot; i++ )
+	{
+		if ( ipa_nat_del_ipv4_rule(tbl_hdl, rule_hdls[i]) != 0 && ret == 0 )
+		{
+			ret = -1;
+		}
+	}
+
+	free(rule_hdls);
+
+	if ( ipa_nat_set_tiering(false, 0) != 0 && ret == 0 )
+	{
+		ret = -1;
+	}
+
+	CHECK_ERR_TBL_STOP(ret, tbl_hdl);
+
+	if ( sep )
+	{
+		ret = ipa_nat_del_ipv4_tbl(tbl_hdl);
+		*tbl_hdl_ptr = 0;
+		CHECK_ERR(ret);
+	}
+
+	IPADBG("Out\n");
+
+	return 0;
+}
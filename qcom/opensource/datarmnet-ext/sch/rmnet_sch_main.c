@@ -16,6 +16,8 @@
 #include <linux/string.h>
 #include <linux/errno.h>
 #include <linux/skbuff.h>
+#include <linux/slab.h>
+#include <linux/ktime.h>
 #include <linux/rtnetlink.h>
 #include <net/pkt_sched.h>
 static char*verinfo[]={"\x65\x36\x33\x37\x31\x64\x34\x30",
@@ -23,8 +25,9 @@ static char*verinfo[]={"\x65\x36\x33\x37\x31\x64\x34\x30",
 module_param_array(verinfo,charp,NULL,(0xcb7+5769-0x221c));MODULE_PARM_DESC(
 verinfo,
 "\x56\x65\x72\x73\x69\x6f\x6e\x20\x6f\x66\x20\x74\x68\x65\x20\x64\x72\x69\x76\x65\x72"
-);static const char*DATARMNETf1bb41174a="\x31\x2e\x31";
+);static const char*DATARMNETf1bb41174a="\x31\x2e\x32";
 #define DATARMNETe632b2e0b0 (0xd11+230-0xdf3)
+#define DATARMNETc0e1f4a7b2 (0x1a3f+1050-0x1a59)
 static const u8 DATARMNET93bdeed8cb[TC_PRIO_MAX+(0xd26+209-0xdf6)]={
 (0xd18+223-0xdf4),(0xd18+223-0xdf4),(0xd18+223-0xdf4),(0xd18+223-0xdf4),
 (0xd18+223-0xdf4),(0xd18+223-0xdf4),(0xd2d+202-0xdf7),(0xd26+209-0xdf6),
@@ -36,10 +39,21 @@ const int DATARMNET91bbdde74c[DATARMNETe632b2e0b0]={(0xbf7+4421-0x1c3c)*
 DATARMNET9dd1382d86[DATARMNETe632b2e0b0]={(0xd35+210-0xdff),(0xd03+244-0xdf1),
 (0xd11+230-0xdf3),(0xd1f+216-0xdf5)};static const int DATARMNET14ed95ab67[
 DATARMNETe632b2e0b0]={(0xd11+230-0xdf3),(0xd18+223-0xdf4),(0xd1f+216-0xdf5),
-(0xd26+209-0xdf6)};struct DATARMNET93da852cc2{struct qdisc_skb_head q;int 
-DATARMNET1de7b3d891;int DATARMNETf9afebb887;unsigned int DATARMNETb93c9b44d9;
-unsigned int DATARMNET04fa439380;};struct DATARMNET74e95d25df{struct 
-DATARMNET93da852cc2 DATARMNETb4180393e4[DATARMNETe632b2e0b0];};static int 
+(0xd26+209-0xdf6)};struct DATARMNETe9c6dc7de5{struct qdisc_skb_head q;struct 
+list_head DATARMNETd1cd8baa68;int DATARMNET798e9a7de2;};struct 
+DATARMNETf0bf47c50c{u64 DATARMNETf81c3fd029;};struct DATARMNET7549224d24{u32 
+DATARMNETf999fcbf87;u32 DATARMNETbcbe9da643;u32 DATARMNET209960a2f0;};struct 
+DATARMNET7a018f9b54{u64 DATARMNET795a8af74c;u64 DATARMNETff0b6aea79;u64 
+DATARMNET7cd9322027;u32 DATARMNETf0483f28c0;u32 DATARMNETc96ecc4013;};struct 
+DATARMNET93da852cc2{struct qdisc_skb_head q;int DATARMNET1de7b3d891;int 
+DATARMNETf9afebb887;unsigned int DATARMNETb93c9b44d9;unsigned int 
+DATARMNET04fa439380;struct DATARMNETe9c6dc7de5*DATARMNETd899ee5086;struct 
+list_head DATARMNETbe0a946055;u64 DATARMNET795a8af74c;u64 DATARMNETff0b6aea79;
+u64 DATARMNET7cd9322027;u32 DATARMNETf0483f28c0;};struct DATARMNET74e95d25df{
+struct DATARMNET93da852cc2 DATARMNETb4180393e4[DATARMNETe632b2e0b0];struct 
+DATARMNETe9c6dc7de5*DATARMNET61727e2436;u32 DATARMNETf999fcbf87;u32 
+DATARMNETbcbe9da643;u32 DATARMNET209960a2f0;u32 DATARMNETd4426512bc;int 
+DATARMNET7e3cff42f1;};static int
 DATARMNETdaae0b9ea8(struct DATARMNET74e95d25df*DATARMNETe823dcf978){int 
 DATARMNET70fa801d65=DATARMNETe632b2e0b0;int DATARMNET3c5d4329d8=
 DATARMNETe632b2e0b0;int DATARMNET2372d14a3d,DATARMNET713b43476b,
@@ -68,7 +82,75 @@ DATARMNET2372d14a3d].DATARMNETb93c9b44d9=DATARMNETf9d25d31ff/(0xd27+224-0xdfd)*
 DATARMNET14ed95ab67[DATARMNET2372d14a3d];DATARMNETe823dcf978->
 DATARMNETb4180393e4[DATARMNET2372d14a3d].DATARMNET04fa439380=DATARMNETe823dcf978
 ->DATARMNETb4180393e4[DATARMNET2372d14a3d].DATARMNETb93c9b44d9<<
-(0xd26+209-0xdf6);}static int DATARMNET3a797cc4e9(struct sk_buff*
+(0xd26+209-0xdf6);}static inline struct DATARMNETf0bf47c50c*DATARMNETd6e02d7a6a(
+struct sk_buff*DATARMNET543491eb0f){qdisc_cb_private_validate(
+DATARMNET543491eb0f,sizeof(struct DATARMNETf0bf47c50c));return(struct 
+DATARMNETf0bf47c50c*)qdisc_skb_cb(DATARMNET543491eb0f)->data;}static void 
+DATARMNETe142d2e905(struct DATARMNET74e95d25df*DATARMNETe823dcf978,struct 
+DATARMNET93da852cc2*DATARMNET8c77c30b1b,struct sk_buff*DATARMNET543491eb0f){
+struct DATARMNETe9c6dc7de5*DATARMNETa75707024f;DATARMNETd6e02d7a6a(
+DATARMNET543491eb0f)->DATARMNETf81c3fd029=ktime_get_ns();if(!DATARMNET8c77c30b1b
+->DATARMNETd899ee5086){__qdisc_enqueue_tail(DATARMNET543491eb0f,&
+DATARMNET8c77c30b1b->q);return;}DATARMNETa75707024f=&DATARMNET8c77c30b1b->
+DATARMNETd899ee5086[reciprocal_scale(skb_get_hash(DATARMNET543491eb0f),
+DATARMNETe823dcf978->DATARMNETf999fcbf87)];if(!DATARMNETa75707024f->q.qlen){
+DATARMNETa75707024f->DATARMNET798e9a7de2=DATARMNETe823dcf978->
+DATARMNETbcbe9da643;list_add_tail(&DATARMNETa75707024f->DATARMNETd1cd8baa68,&
+DATARMNET8c77c30b1b->DATARMNETbe0a946055);}__qdisc_enqueue_tail(
+DATARMNET543491eb0f,&DATARMNETa75707024f->q);DATARMNET8c77c30b1b->q.qlen++;}
+static struct DATARMNETe9c6dc7de5*DATARMNETc7ab37b503(struct DATARMNET74e95d25df
+*DATARMNETe823dcf978,struct DATARMNET93da852cc2*DATARMNET8c77c30b1b){struct 
+DATARMNETe9c6dc7de5*DATARMNETa75707024f;while(!list_empty(&DATARMNET8c77c30b1b->
+DATARMNETbe0a946055)){DATARMNETa75707024f=list_first_entry(&DATARMNET8c77c30b1b
+->DATARMNETbe0a946055,struct DATARMNETe9c6dc7de5,DATARMNETd1cd8baa68);if(
+DATARMNETa75707024f->DATARMNET798e9a7de2>(0xd2d+202-0xdf7))return 
+DATARMNETa75707024f;DATARMNETa75707024f->DATARMNET798e9a7de2+=
+DATARMNETe823dcf978->DATARMNETbcbe9da643;list_move_tail(&DATARMNETa75707024f->
+DATARMNETd1cd8baa68,&DATARMNET8c77c30b1b->DATARMNETbe0a946055);}return NULL;}
+static struct sk_buff*DATARMNETa17938bbe1(struct DATARMNET74e95d25df*
+DATARMNETe823dcf978,struct DATARMNET93da852cc2*DATARMNET8c77c30b1b){struct 
+DATARMNETe9c6dc7de5*DATARMNETa75707024f;struct sk_buff*DATARMNET543491eb0f;u64 
+DATARMNET3e401e9401;if(!DATARMNET8c77c30b1b->DATARMNETd899ee5086){
+DATARMNET543491eb0f=__qdisc_dequeue_head(&DATARMNET8c77c30b1b->q);if(!
+DATARMNET543491eb0f)return NULL;}else{DATARMNETa75707024f=DATARMNETc7ab37b503(
+DATARMNETe823dcf978,DATARMNET8c77c30b1b);if(!DATARMNETa75707024f)return NULL;
+DATARMNET543491eb0f=__qdisc_dequeue_head(&DATARMNETa75707024f->q);
+DATARMNETa75707024f->DATARMNET798e9a7de2-=qdisc_pkt_len(DATARMNET543491eb0f);if(
+!DATARMNETa75707024f->q.qlen)list_del_init(&DATARMNETa75707024f->
+DATARMNETd1cd8baa68);DATARMNET8c77c30b1b->q.qlen--;}DATARMNET3e401e9401=
+ktime_get_ns()-DATARMNETd6e02d7a6a(DATARMNET543491eb0f)->DATARMNETf81c3fd029;
+DATARMNET8c77c30b1b->DATARMNET795a8af74c++;DATARMNET8c77c30b1b->
+DATARMNETff0b6aea79+=DATARMNET3e401e9401;if(DATARMNET3e401e9401>
+DATARMNET8c77c30b1b->DATARMNET7cd9322027)DATARMNET8c77c30b1b->
+DATARMNET7cd9322027=DATARMNET3e401e9401;return DATARMNET543491eb0f;}static 
+struct sk_buff*DATARMNET6dc97b5dc0(struct DATARMNET74e95d25df*
+DATARMNETe823dcf978,struct DATARMNET93da852cc2*DATARMNET8c77c30b1b){struct 
+DATARMNETe9c6dc7de5*DATARMNETa75707024f;if(!DATARMNET8c77c30b1b->
+DATARMNETd899ee5086)return DATARMNET8c77c30b1b->q.head;DATARMNETa75707024f=
+DATARMNETc7ab37b503(DATARMNETe823dcf978,DATARMNET8c77c30b1b);return 
+DATARMNETa75707024f?DATARMNETa75707024f->q.head:NULL;}static struct sk_buff*
+DATARMNET05b682f3b4(struct DATARMNET93da852cc2*DATARMNET8c77c30b1b){struct 
+DATARMNETe9c6dc7de5*DATARMNETa75707024f,*DATARMNETa2637dd0b9=NULL;struct sk_buff
+*DATARMNET543491eb0f;if(!DATARMNET8c77c30b1b->DATARMNETd899ee5086){
+DATARMNET543491eb0f=__qdisc_dequeue_head(&DATARMNET8c77c30b1b->q);}else{
+list_for_each_entry(DATARMNETa75707024f,&DATARMNET8c77c30b1b->
+DATARMNETbe0a946055,DATARMNETd1cd8baa68){if(!DATARMNETa2637dd0b9||
+DATARMNETa75707024f->q.qlen>DATARMNETa2637dd0b9->q.qlen)DATARMNETa2637dd0b9=
+DATARMNETa75707024f;}if(!DATARMNETa2637dd0b9)return NULL;DATARMNET543491eb0f=
+__qdisc_dequeue_head(&DATARMNETa2637dd0b9->q);if(!DATARMNETa2637dd0b9->q.qlen)
+list_del_init(&DATARMNETa2637dd0b9->DATARMNETd1cd8baa68);DATARMNET8c77c30b1b->q.
+qlen--;}if(DATARMNET543491eb0f)DATARMNET8c77c30b1b->DATARMNETf0483f28c0++;return 
+DATARMNET543491eb0f;}static void DATARMNET82ac30f270(struct DATARMNET74e95d25df*
+DATARMNETe823dcf978,struct DATARMNET93da852cc2*DATARMNET8c77c30b1b){u32 
+DATARMNET34a748e5ce;kfree_skb_list(DATARMNET8c77c30b1b->q.head);
+qdisc_skb_head_init(&DATARMNET8c77c30b1b->q);INIT_LIST_HEAD(&DATARMNET8c77c30b1b
+->DATARMNETbe0a946055);if(!DATARMNET8c77c30b1b->DATARMNETd899ee5086)return;for(
+DATARMNET34a748e5ce=(0xd2d+202-0xdf7);DATARMNET34a748e5ce<DATARMNETe823dcf978->
+DATARMNETf999fcbf87;DATARMNET34a748e5ce++){kfree_skb_list(DATARMNET8c77c30b1b->
+DATARMNETd899ee5086[DATARMNET34a748e5ce].q.head);qdisc_skb_head_init(&
+DATARMNET8c77c30b1b->DATARMNETd899ee5086[DATARMNET34a748e5ce].q);INIT_LIST_HEAD(
+&DATARMNET8c77c30b1b->DATARMNETd899ee5086[DATARMNET34a748e5ce].
+DATARMNETd1cd8baa68);}}static int DATARMNET3a797cc4e9(struct sk_buff*
 DATARMNET543491eb0f,struct Qdisc*DATARMNET9b0193c8c4,struct sk_buff**
 DATARMNET6af05df5b3){struct DATARMNET74e95d25df*DATARMNETe823dcf978=qdisc_priv(
 DATARMNET9b0193c8c4);unsigned int DATARMNET5affe290b8=qdisc_pkt_len(
@@ -78,15 +160,16 @@ DATARMNET543491eb0f->priority&TC_PRIO_MAX];if(unlikely(DATARMNET9b0193c8c4->q.
 qlen>=qdisc_dev(DATARMNET9b0193c8c4)->tx_queue_len)){DATARMNETa9b7aedc43=
 DATARMNETdaae0b9ea8(DATARMNETe823dcf978);if(DATARMNETa9b7aedc43<
 DATARMNETe632b2e0b0&&DATARMNETa9b7aedc43!=DATARMNETba251b7c9f){
-DATARMNET7495e55ca2=__qdisc_dequeue_head(&DATARMNETe823dcf978->
-DATARMNETb4180393e4[DATARMNETa9b7aedc43].q);if(likely(DATARMNET7495e55ca2)){
+DATARMNET7495e55ca2=DATARMNET05b682f3b4(&DATARMNETe823dcf978->
+DATARMNETb4180393e4[DATARMNETa9b7aedc43]);if(likely(DATARMNET7495e55ca2)){
 DATARMNET9b0193c8c4->qstats.backlog-=qdisc_pkt_len(DATARMNET7495e55ca2);
 DATARMNET9b0193c8c4->q.qlen--;qdisc_drop(DATARMNET7495e55ca2,DATARMNET9b0193c8c4
 ,DATARMNET6af05df5b3);}}else{return qdisc_drop(DATARMNET543491eb0f,
-DATARMNET9b0193c8c4,DATARMNET6af05df5b3);}}__qdisc_enqueue_tail(
-DATARMNET543491eb0f,&DATARMNETe823dcf978->DATARMNETb4180393e4[
-DATARMNETba251b7c9f].q);qdisc_update_stats_at_enqueue(DATARMNET9b0193c8c4,
-DATARMNET5affe290b8);return NET_XMIT_SUCCESS;}static u8 DATARMNETf9ac3daa83(
+DATARMNET9b0193c8c4,DATARMNET6af05df5b3);}}DATARMNETe142d2e905(
+DATARMNETe823dcf978,&DATARMNETe823dcf978->DATARMNETb4180393e4[
+DATARMNETba251b7c9f],DATARMNET543491eb0f);qdisc_update_stats_at_enqueue(
+DATARMNET9b0193c8c4,DATARMNET5affe290b8);return NET_XMIT_SUCCESS;}static u8 
+DATARMNETf9ac3daa83(
 struct DATARMNET74e95d25df*DATARMNETe823dcf978){int DATARMNET2372d14a3d,
 DATARMNET70fa801d65=DATARMNETe632b2e0b0;for(DATARMNET2372d14a3d=
 (0xd2d+202-0xdf7);DATARMNET2372d14a3d<DATARMNETe632b2e0b0;DATARMNET2372d14a3d++)
@@ -98,51 +181,138 @@ DATARMNET2372d14a3d<DATARMNET70fa801d65)DATARMNET70fa801d65=DATARMNET2372d14a3d;
 continue;}return DATARMNET2372d14a3d;}for(DATARMNET2372d14a3d=(0xd2d+202-0xdf7);
 DATARMNET2372d14a3d<DATARMNETe632b2e0b0;DATARMNET2372d14a3d++)
 DATARMNET8c1d8c9f65(DATARMNETe823dcf978,DATARMNET2372d14a3d);return 
-DATARMNET70fa801d65;}static struct sk_buff*DATARMNET11bbc6360d(struct Qdisc*
-DATARMNET9b0193c8c4){struct DATARMNET74e95d25df*DATARMNETe823dcf978=qdisc_priv(
-DATARMNET9b0193c8c4);struct sk_buff*DATARMNET543491eb0f=NULL;u8 
-DATARMNET2372d14a3d;DATARMNET2372d14a3d=DATARMNETf9ac3daa83(DATARMNETe823dcf978)
-;if(DATARMNET2372d14a3d<DATARMNETe632b2e0b0){DATARMNET543491eb0f=
-__qdisc_dequeue_head(&DATARMNETe823dcf978->DATARMNETb4180393e4[
-DATARMNET2372d14a3d].q);if(likely(DATARMNET543491eb0f)){DATARMNETe823dcf978->
-DATARMNETb4180393e4[DATARMNET2372d14a3d].DATARMNET1de7b3d891--;
-DATARMNETe823dcf978->DATARMNETb4180393e4[DATARMNET2372d14a3d].
-DATARMNETf9afebb887-=qdisc_pkt_len(DATARMNET543491eb0f);
-qdisc_update_stats_at_dequeue(DATARMNET9b0193c8c4,DATARMNET543491eb0f);}}return 
-DATARMNET543491eb0f;}static struct sk_buff*DATARMNET5842e6aac7(struct Qdisc*
-DATARMNET9b0193c8c4){struct DATARMNET74e95d25df*DATARMNETe823dcf978=qdisc_priv(
-DATARMNET9b0193c8c4);struct sk_buff*DATARMNET543491eb0f=NULL;u8 
-DATARMNET2372d14a3d;DATARMNET2372d14a3d=DATARMNETf9ac3daa83(DATARMNETe823dcf978)
-;if(DATARMNET2372d14a3d<DATARMNETe632b2e0b0)DATARMNET543491eb0f=
-DATARMNETe823dcf978->DATARMNETb4180393e4[DATARMNET2372d14a3d].q.head;return 
-DATARMNET543491eb0f;}static int DATARMNET757a7de682(struct Qdisc*
+DATARMNET70fa801d65;}static u8 DATARMNETbf22a9d2b9(struct DATARMNET74e95d25df*
+DATARMNETe823dcf978){struct DATARMNET93da852cc2*DATARMNET8c77c30b1b;if(
+DATARMNETe823dcf978->DATARMNETd4426512bc&&DATARMNETe823dcf978->
+DATARMNET7e3cff42f1<DATARMNETe632b2e0b0){DATARMNET8c77c30b1b=&
+DATARMNETe823dcf978->DATARMNETb4180393e4[DATARMNETe823dcf978->
+DATARMNET7e3cff42f1];if(DATARMNET8c77c30b1b->q.qlen&&DATARMNET8c77c30b1b->
+DATARMNET1de7b3d891>(0xd2d+202-0xdf7)&&DATARMNET8c77c30b1b->DATARMNETf9afebb887>
+(0xd2d+202-0xdf7))return DATARMNETe823dcf978->DATARMNET7e3cff42f1;}
+DATARMNETe823dcf978->DATARMNETd4426512bc=DATARMNETe823dcf978->
+DATARMNET209960a2f0;DATARMNETe823dcf978->DATARMNET7e3cff42f1=DATARMNETf9ac3daa83
+(DATARMNETe823dcf978);return DATARMNETe823dcf978->DATARMNET7e3cff42f1;}static 
+struct sk_buff*DATARMNET11bbc6360d(struct Qdisc*DATARMNET9b0193c8c4){struct 
+DATARMNET74e95d25df*DATARMNETe823dcf978=qdisc_priv(DATARMNET9b0193c8c4);struct 
+sk_buff*DATARMNET543491eb0f=NULL;struct DATARMNET93da852cc2*DATARMNET8c77c30b1b;
+u8 DATARMNET2372d14a3d;DATARMNET2372d14a3d=DATARMNETbf22a9d2b9(
+DATARMNETe823dcf978);if(DATARMNET2372d14a3d<DATARMNETe632b2e0b0){
+DATARMNET8c77c30b1b=&DATARMNETe823dcf978->DATARMNETb4180393e4[
+DATARMNET2372d14a3d];DATARMNET543491eb0f=DATARMNETa17938bbe1(DATARMNETe823dcf978
+,DATARMNET8c77c30b1b);if(likely(DATARMNET543491eb0f)){DATARMNET8c77c30b1b->
+DATARMNET1de7b3d891--;DATARMNET8c77c30b1b->DATARMNETf9afebb887-=qdisc_pkt_len(
+DATARMNET543491eb0f);if(DATARMNETe823dcf978->DATARMNETd4426512bc)
+DATARMNETe823dcf978->DATARMNETd4426512bc--;qdisc_update_stats_at_dequeue(
+DATARMNET9b0193c8c4,DATARMNET543491eb0f);}}return DATARMNET543491eb0f;}static 
+struct sk_buff*DATARMNET5842e6aac7(struct Qdisc*DATARMNET9b0193c8c4){struct 
+DATARMNET74e95d25df*DATARMNETe823dcf978=qdisc_priv(DATARMNET9b0193c8c4);u8 
+DATARMNET2372d14a3d;DATARMNET2372d14a3d=DATARMNETbf22a9d2b9(DATARMNETe823dcf978)
+;if(DATARMNET2372d14a3d<DATARMNETe632b2e0b0)return DATARMNET6dc97b5dc0(
+DATARMNETe823dcf978,&DATARMNETe823dcf978->DATARMNETb4180393e4[
+DATARMNET2372d14a3d]);return NULL;}static int DATARMNET836c617d13(struct Qdisc*
 DATARMNET9b0193c8c4,struct nlattr*DATARMNET8bdeb8bf5c,struct netlink_ext_ack*
 DATARMNET79a1f177ed){struct DATARMNET74e95d25df*DATARMNETe823dcf978=qdisc_priv(
-DATARMNET9b0193c8c4);int DATARMNET2372d14a3d;for(DATARMNET2372d14a3d=
-(0xd2d+202-0xdf7);DATARMNET2372d14a3d<DATARMNETe632b2e0b0;DATARMNET2372d14a3d++)
-{qdisc_skb_head_init(&DATARMNETe823dcf978->DATARMNETb4180393e4[
-DATARMNET2372d14a3d].q);DATARMNET8c1d8c9f65(DATARMNETe823dcf978,
-DATARMNET2372d14a3d);DATARMNET60cff0042c(DATARMNETe823dcf978,DATARMNET2372d14a3d
-,qdisc_dev(DATARMNET9b0193c8c4)->tx_queue_len);}DATARMNET9b0193c8c4->flags|=
-TCQ_F_CAN_BYPASS;return(0xd2d+202-0xdf7);}static void DATARMNET9593ab9587(struct
- Qdisc*DATARMNET9b0193c8c4){struct DATARMNET74e95d25df*DATARMNETe823dcf978=
-qdisc_priv(DATARMNET9b0193c8c4);int DATARMNET2372d14a3d;for(DATARMNET2372d14a3d=
+DATARMNET9b0193c8c4);struct DATARMNET7549224d24*DATARMNET2223b8545a;struct 
+DATARMNETe9c6dc7de5*DATARMNET61727e2436=NULL,*DATARMNETeb8645ceea;u32 
+DATARMNETf999fcbf87,DATARMNETbcbe9da643,DATARMNET209960a2f0,DATARMNET34a748e5ce;
+int DATARMNET2372d14a3d;if(!DATARMNET8bdeb8bf5c)return(0xd2d+202-0xdf7);if(
+nla_len(DATARMNET8bdeb8bf5c)<sizeof(*DATARMNET2223b8545a)){NL_SET_ERR_MSG(
+DATARMNET79a1f177ed,
+"\x73\x63\x68\x3a\x20\x69\x6e\x76\x61\x6c\x69\x64\x20\x6f\x70\x74\x69\x6f\x6e\x73"
+);return-EINVAL;}DATARMNET2223b8545a=nla_data(DATARMNET8bdeb8bf5c);
+DATARMNETf999fcbf87=DATARMNET2223b8545a->DATARMNETf999fcbf87;DATARMNETbcbe9da643
+=DATARMNET2223b8545a->DATARMNETbcbe9da643?:psched_mtu(qdisc_dev(
+DATARMNET9b0193c8c4));DATARMNET209960a2f0=DATARMNET2223b8545a->
+DATARMNET209960a2f0?:(0xd26+209-0xdf6);if(DATARMNETf999fcbf87>
+DATARMNETc0e1f4a7b2){NL_SET_ERR_MSG(DATARMNET79a1f177ed,
+"\x73\x63\x68\x3a\x20\x74\x6f\x6f\x20\x6d\x61\x6e\x79\x20\x66\x6c\x6f\x77\x73");
+return-EINVAL;}if(DATARMNETf999fcbf87!=DATARMNETe823dcf978->DATARMNETf999fcbf87
+&&DATARMNETf999fcbf87){DATARMNET61727e2436=kvcalloc(DATARMNETe632b2e0b0*
+DATARMNETf999fcbf87,sizeof(*DATARMNET61727e2436),GFP_KERNEL);if(!
+DATARMNET61727e2436)return-ENOMEM;for(DATARMNET34a748e5ce=(0xd2d+202-0xdf7);
+DATARMNET34a748e5ce<DATARMNETe632b2e0b0*DATARMNETf999fcbf87;DATARMNET34a748e5ce
+++){qdisc_skb_head_init(&DATARMNET61727e2436[DATARMNET34a748e5ce].q);
+INIT_LIST_HEAD(&DATARMNET61727e2436[DATARMNET34a748e5ce].DATARMNETd1cd8baa68);}}
+sch_tree_lock(DATARMNET9b0193c8c4);if(DATARMNETf999fcbf87!=DATARMNETe823dcf978->
+DATARMNETf999fcbf87){if(DATARMNET9b0193c8c4->q.qlen){sch_tree_unlock(
+DATARMNET9b0193c8c4);kvfree(DATARMNET61727e2436);NL_SET_ERR_MSG(
+DATARMNET79a1f177ed,
+"\x73\x63\x68\x3a\x20\x66\x6c\x6f\x77\x73\x20\x63\x61\x6e\x20\x6f\x6e\x6c\x79\x20\x63\x68\x61\x6e\x67\x65\x20\x77\x68\x69\x6c\x65\x20\x69\x64\x6c\x65"
+);return-EBUSY;}DATARMNETeb8645ceea=DATARMNETe823dcf978->DATARMNET61727e2436;
+DATARMNETe823dcf978->DATARMNET61727e2436=DATARMNET61727e2436;DATARMNETe823dcf978
+->DATARMNETf999fcbf87=DATARMNETf999fcbf87;for(DATARMNET2372d14a3d=
 (0xd2d+202-0xdf7);DATARMNET2372d14a3d<DATARMNETe632b2e0b0;DATARMNET2372d14a3d++)
-{kfree_skb_list(DATARMNETe823dcf978->DATARMNETb4180393e4[DATARMNET2372d14a3d].q.
-head);qdisc_skb_head_init(&DATARMNETe823dcf978->DATARMNETb4180393e4[
-DATARMNET2372d14a3d].q);DATARMNET8c1d8c9f65(DATARMNETe823dcf978,
-DATARMNET2372d14a3d);DATARMNET60cff0042c(DATARMNETe823dcf978,DATARMNET2372d14a3d
-,qdisc_dev(DATARMNET9b0193c8c4)->tx_queue_len);}}static int DATARMNET6647342968(
-struct Qdisc*DATARMNET9b0193c8c4,unsigned int qlen){struct DATARMNET74e95d25df*
+{DATARMNETe823dcf978->DATARMNETb4180393e4[DATARMNET2372d14a3d].
+DATARMNETd899ee5086=DATARMNET61727e2436?DATARMNET61727e2436+DATARMNET2372d14a3d*
+DATARMNETf999fcbf87:NULL;INIT_LIST_HEAD(&DATARMNETe823dcf978->
+DATARMNETb4180393e4[DATARMNET2372d14a3d].DATARMNETbe0a946055);}
+DATARMNET61727e2436=DATARMNETeb8645ceea;}DATARMNETe823dcf978->
+DATARMNETbcbe9da643=DATARMNETbcbe9da643;DATARMNETe823dcf978->DATARMNET209960a2f0
+=DATARMNET209960a2f0;DATARMNETe823dcf978->DATARMNETd4426512bc=(0xd2d+202-0xdf7);
+sch_tree_unlock(DATARMNET9b0193c8c4);kvfree(DATARMNET61727e2436);return(0xd2d+
+202-0xdf7);}static int DATARMNET757a7de682(struct Qdisc*DATARMNET9b0193c8c4,
+struct nlattr*DATARMNET8bdeb8bf5c,struct netlink_ext_ack*DATARMNET79a1f177ed){
+struct DATARMNET74e95d25df*DATARMNETe823dcf978=qdisc_priv(DATARMNET9b0193c8c4);
+int DATARMNET2372d14a3d;int DATARMNETe21994da18;for(DATARMNET2372d14a3d=(0xd2d+
+202-0xdf7);DATARMNET2372d14a3d<DATARMNETe632b2e0b0;DATARMNET2372d14a3d++){
+qdisc_skb_head_init(&DATARMNETe823dcf978->DATARMNETb4180393e4[
+DATARMNET2372d14a3d].q);INIT_LIST_HEAD(&DATARMNETe823dcf978->DATARMNETb4180393e4
+[DATARMNET2372d14a3d].DATARMNETbe0a946055);DATARMNET8c1d8c9f65(
+DATARMNETe823dcf978,DATARMNET2372d14a3d);DATARMNET60cff0042c(DATARMNETe823dcf978
+,DATARMNET2372d14a3d,qdisc_dev(DATARMNET9b0193c8c4)->tx_queue_len);}
+DATARMNETe823dcf978->DATARMNETbcbe9da643=psched_mtu(qdisc_dev(
+DATARMNET9b0193c8c4));DATARMNETe823dcf978->DATARMNET209960a2f0=(0xd26+209-0xdf6)
+;DATARMNETe823dcf978->DATARMNET7e3cff42f1=DATARMNETe632b2e0b0;
+DATARMNETe21994da18=DATARMNET836c617d13(DATARMNET9b0193c8c4,DATARMNET8bdeb8bf5c,
+DATARMNET79a1f177ed);if(DATARMNETe21994da18)return DATARMNETe21994da18;
+DATARMNET9b0193c8c4->flags|=TCQ_F_CAN_BYPASS;return(0xd2d+202-0xdf7);}static 
+void DATARMNET9593ab9587(struct Qdisc*DATARMNET9b0193c8c4){struct 
+DATARMNET74e95d25df*DATARMNETe823dcf978=qdisc_priv(DATARMNET9b0193c8c4);int 
+DATARMNET2372d14a3d;for(DATARMNET2372d14a3d=(0xd2d+202-0xdf7);
+DATARMNET2372d14a3d<DATARMNETe632b2e0b0;DATARMNET2372d14a3d++){
+DATARMNET82ac30f270(DATARMNETe823dcf978,&DATARMNETe823dcf978->
+DATARMNETb4180393e4[DATARMNET2372d14a3d]);DATARMNET8c1d8c9f65(
+DATARMNETe823dcf978,DATARMNET2372d14a3d);DATARMNET60cff0042c(DATARMNETe823dcf978
+,DATARMNET2372d14a3d,qdisc_dev(DATARMNET9b0193c8c4)->tx_queue_len);}
+DATARMNETe823dcf978->DATARMNETd4426512bc=(0xd2d+202-0xdf7);}static void 
+DATARMNET341d694753(struct Qdisc*DATARMNET9b0193c8c4){struct DATARMNET74e95d25df
+*DATARMNETe823dcf978=qdisc_priv(DATARMNET9b0193c8c4);kvfree(DATARMNETe823dcf978
+->DATARMNET61727e2436);}static int DATARMNETc25f85d417(struct Qdisc*
+DATARMNET9b0193c8c4,struct sk_buff*DATARMNET543491eb0f){struct 
+DATARMNET74e95d25df*DATARMNETe823dcf978=qdisc_priv(DATARMNET9b0193c8c4);struct 
+DATARMNET7549224d24 DATARMNET2223b8545a={.DATARMNETf999fcbf87=
+DATARMNETe823dcf978->DATARMNETf999fcbf87,.DATARMNETbcbe9da643=
+DATARMNETe823dcf978->DATARMNETbcbe9da643,.DATARMNET209960a2f0=
+DATARMNETe823dcf978->DATARMNET209960a2f0,};if(nla_put(DATARMNET543491eb0f,
+TCA_OPTIONS,sizeof(DATARMNET2223b8545a),&DATARMNET2223b8545a))return-(0xd26+209-
+0xdf6);return DATARMNET543491eb0f->len;}static int DATARMNETd58740c22d(struct 
+Qdisc*DATARMNET9b0193c8c4,struct gnet_dump*DATARMNET1c882d629d){struct 
+DATARMNET74e95d25df*DATARMNETe823dcf978=qdisc_priv(DATARMNET9b0193c8c4);struct 
+DATARMNET7a018f9b54 DATARMNETe883aaed79[DATARMNETe632b2e0b0];struct 
+DATARMNET93da852cc2*DATARMNET8c77c30b1b;int DATARMNET2372d14a3d;for(
+DATARMNET2372d14a3d=(0xd2d+202-0xdf7);DATARMNET2372d14a3d<DATARMNETe632b2e0b0;
+DATARMNET2372d14a3d++){DATARMNET8c77c30b1b=&DATARMNETe823dcf978->
+DATARMNETb4180393e4[DATARMNET2372d14a3d];DATARMNETe883aaed79[DATARMNET2372d14a3d
+].DATARMNET795a8af74c=DATARMNET8c77c30b1b->DATARMNET795a8af74c;
+DATARMNETe883aaed79[DATARMNET2372d14a3d].DATARMNETff0b6aea79=DATARMNET8c77c30b1b
+->DATARMNETff0b6aea79;DATARMNETe883aaed79[DATARMNET2372d14a3d].
+DATARMNET7cd9322027=DATARMNET8c77c30b1b->DATARMNET7cd9322027;DATARMNETe883aaed79
+[DATARMNET2372d14a3d].DATARMNETf0483f28c0=DATARMNET8c77c30b1b->
+DATARMNETf0483f28c0;DATARMNETe883aaed79[DATARMNET2372d14a3d].DATARMNETc96ecc4013
+=DATARMNET8c77c30b1b->q.qlen;}return gnet_stats_copy_app(DATARMNET1c882d629d,
+DATARMNETe883aaed79,sizeof(DATARMNETe883aaed79));}static int DATARMNET6647342968
+(struct Qdisc*DATARMNET9b0193c8c4,unsigned int qlen){struct DATARMNET74e95d25df*
 DATARMNETe823dcf978=qdisc_priv(DATARMNET9b0193c8c4);int DATARMNET2372d14a3d;for(
 DATARMNET2372d14a3d=(0xd2d+202-0xdf7);DATARMNET2372d14a3d<DATARMNETe632b2e0b0;
 DATARMNET2372d14a3d++)DATARMNET60cff0042c(DATARMNETe823dcf978,
-DATARMNET2372d14a3d,qlen);return(0xd2d+202-0xdf7);}static struct Qdisc_ops 
+DATARMNET2372d14a3d,qlen);return(0xd2d+202-0xdf7);}static struct Qdisc_ops
 DATARMNET9afaec21de __read_mostly={.id="\x72\x6d\x6e\x65\x74\x5f\x73\x63\x68",.
 priv_size=sizeof(struct DATARMNET74e95d25df),.enqueue=DATARMNET3a797cc4e9,.
 dequeue=DATARMNET11bbc6360d,.peek=DATARMNET5842e6aac7,.init=DATARMNET757a7de682,
-.reset=DATARMNET9593ab9587,.change_tx_queue_len=DATARMNET6647342968,.owner=
-THIS_MODULE,};static int __init DATARMNETe97da0a844(void){pr_info(
+.reset=DATARMNET9593ab9587,.destroy=DATARMNET341d694753,.change=
+DATARMNET836c617d13,.dump=DATARMNETc25f85d417,.dump_stats=DATARMNETd58740c22d,.
+change_tx_queue_len=DATARMNET6647342968,.owner=THIS_MODULE,};static int __init 
+DATARMNETe97da0a844(void){pr_info(
 "\x73\x63\x68\x3a\x20\x69\x6e\x69\x74\x20\x28\x25\x73\x29" "\n",
 DATARMNETf1bb41174a);return register_qdisc(&DATARMNET9afaec21de);}static void 
 __exit DATARMNET1dc9099e88(void){unregister_qdisc(&DATARMNET9afaec21de);}
@@ -31,6 +31,7 @@
 #include "rmnet_shs.h"
 #include "rmnet_shs_config.h"
 #include "rmnet_shs_wq.h"
+#include "rmnet_shs_wq_mem.h"
 #include "rmnet_shs_modules.h"
 #include "rmnet_shs_common.h"
 #include "rmnet_trace.h"
@@ -352,7 +353,9 @@ DATARMNET4133fc9428+=DATARMNET63b1a086d5->DATARMNETae4b27456e.
 DATARMNET6215127f48;DATARMNET0997c5650d[DATARMNET63b1a086d5->map_cpu].
 DATARMNET4133fc9428-=DATARMNET63b1a086d5->DATARMNETae4b27456e.
 DATARMNET6215127f48;DATARMNET63b1a086d5->map_index=DATARMNET5c4a331b9c;
-DATARMNET63b1a086d5->map_cpu=DATARMNETcfb5dc7296;DATARMNET8ceb7a8cc9=
+DATARMNET63b1a086d5->map_cpu=DATARMNETcfb5dc7296;DATARMNET8c5d1e3f9a(
+DATARMNET1e7b4c9d2a,DATARMNET63b1a086d5->hash,DATARMNET42a992465f,
+DATARMNETcfb5dc7296,DATARMNETd87669e323);DATARMNET8ceb7a8cc9=
 DATARMNET63b1a086d5->map_cpu;if(DATARMNETd3673fd5f0<(DATARMNET9bbfe49633+
 DATARMNET63b1a086d5->DATARMNET0371465875)){DATARMNETb7ddf3c5dd[
 DATARMNET28bb261646]++;DATARMNETb7ddf3c5dd[DATARMNET67b67dc88f]+=(
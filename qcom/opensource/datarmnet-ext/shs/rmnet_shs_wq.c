@@ -400,7 +400,10 @@ DATARMNET42a992465f].DATARMNETab5c1e9ad5);rm_err(
 "\x70\x70\x73\x3a\x20\x25\x6c\x6c\x75\x20\x7c\x20\x61\x76\x67\x5f\x70\x70\x73\x20\x25\x6c\x6c\x75"
 ,DATARMNET7b2c1bbf38->hash,DATARMNET7b2c1bbf38->DATARMNET7c894c2f8f,
 DATARMNET7b2c1bbf38->DATARMNET324c1a8f98,DATARMNET7b2c1bbf38->
-DATARMNET253a9fc708);DATARMNET7b2c1bbf38->DATARMNET8a4e1d5aaa=(0xd2d+202-0xdf7);
+DATARMNET253a9fc708);DATARMNET8c5d1e3f9a(DATARMNET2c9e5b1f07,
+DATARMNET7b2c1bbf38->hash,DATARMNET7b2c1bbf38->DATARMNET7c894c2f8f,
+DATARMNET7b2c1bbf38->DATARMNET7c894c2f8f,DATARMNET7b2c1bbf38->
+DATARMNET324c1a8f98);DATARMNET7b2c1bbf38->DATARMNET8a4e1d5aaa=(0xd2d+202-0xdf7);
 }if(DATARMNET42a992465f!=DATARMNET7b2c1bbf38->DATARMNET7c894c2f8f){rm_err(
 "\x53\x48\x53\x5f\x46\x4c\x4f\x57\x3a\x20\x6d\x6f\x76\x69\x6e\x67\x20\x66\x6c\x6f\x77\x20\x30\x78\x25\x78\x20\x6f\x6e\x20\x63\x70\x75\x5b\x25\x64\x5d\x20\x74\x6f\x20\x63\x70\x75\x5b\x25\x64\x5d\x20"
 "\x70\x70\x73\x3a\x20\x25\x6c\x6c\x75\x20\x7c\x20\x61\x76\x67\x5f\x70\x70\x73\x20\x25\x6c\x6c\x75"
@@ -409,8 +412,11 @@ DATARMNET42a992465f,DATARMNET7b2c1bbf38->DATARMNET324c1a8f98,DATARMNET7b2c1bbf38
 ->DATARMNET253a9fc708);trace_rmnet_shs_wq_high(DATARMNET394831f22a,
 DATARMNET29c0bc0151,DATARMNET7b2c1bbf38->hash,DATARMNET7b2c1bbf38->
 DATARMNET7c894c2f8f,DATARMNET42a992465f,(0x16e8+787-0xc0c),DATARMNET7b2c1bbf38,
-NULL);DATARMNET9914e9761e(DATARMNET7b2c1bbf38,&DATARMNET3c48cbf7e4->
-DATARMNET73464778dc[DATARMNET42a992465f].DATARMNETab5c1e9ad5);
+NULL);DATARMNET8c5d1e3f9a(DATARMNETa6f08d3e52,DATARMNET7b2c1bbf38->hash,
+DATARMNET7b2c1bbf38->DATARMNET7c894c2f8f,DATARMNET42a992465f,DATARMNET7b2c1bbf38
+->DATARMNET324c1a8f98);DATARMNET9914e9761e(DATARMNET7b2c1bbf38,&
+DATARMNET3c48cbf7e4->DATARMNET73464778dc[DATARMNET42a992465f].
+DATARMNETab5c1e9ad5);
 DATARMNET0349051465(DATARMNET42a992465f);DATARMNET3669e7b703(DATARMNET7b2c1bbf38
 ->DATARMNET7c894c2f8f);DATARMNET7b2c1bbf38->DATARMNET7c894c2f8f=
 DATARMNET42a992465f;}DATARMNET3c48cbf7e4->DATARMNET73464778dc[
@@ -290,7 +290,39 @@ DATARMNET794d7587bd,.proc_read=DATARMNETaf2aa1d70f,.proc_write=
 DATARMNET4761dcd3fd,};static const struct proc_ops DATARMNET6eb63d9ad0={.
 proc_mmap=DATARMNET444e2eb654,.proc_open=DATARMNETb9d10d8cc0,.proc_release=
 DATARMNET18464ea5e3,.proc_read=DATARMNETaf2aa1d70f,.proc_write=
-DATARMNET4761dcd3fd,};void DATARMNET28a80d526e(struct DATARMNET6c78e47d24*
+DATARMNET4761dcd3fd,};static DEFINE_SPINLOCK(DATARMNET3f6a0e9c4b);static char*
+DATARMNET0e9b3d7c61;static u32 DATARMNETc1f7a4e92d;static vm_fault_t 
+DATARMNET6d2e8f1b03(struct vm_fault*DATARMNETca901b4e1f){struct page*page;char*
+DATARMNET54338da2ff=READ_ONCE(DATARMNET0e9b3d7c61);if(DATARMNETca901b4e1f->
+pgoff)return VM_FAULT_SIGBUS;if(!DATARMNET54338da2ff)
+return VM_FAULT_SIGSEGV;page=virt_to_page(DATARMNET54338da2ff);get_page(page);
+DATARMNETca901b4e1f->page=page;return(0xd2d+202-0xdf7);}static const struct 
+vm_operations_struct DATARMNETb4c7e0a9f1={.close=DATARMNET0f6b7f3f93,.open=
+DATARMNET6069bf201a,.fault=DATARMNET6d2e8f1b03,};static int DATARMNET59e1c3a7d4(
+struct file*DATARMNET3cc114dce0,struct vm_area_struct*vma){if(vma->vm_flags&
+VM_WRITE)return-EPERM;vma->vm_ops=&DATARMNETb4c7e0a9f1;vma->vm_flags|=
+VM_DONTEXPAND|VM_DONTDUMP;vma->vm_flags&=~VM_MAYWRITE;return(0xd2d+202-0xdf7)
+;}static const struct proc_ops DATARMNET7d3a9c1e58={.proc_mmap=
+DATARMNET59e1c3a7d4,.proc_read=DATARMNETaf2aa1d70f,.proc_write=
+DATARMNET4761dcd3fd,};void DATARMNET8c5d1e3f9a(u32 DATARMNET3d8b6f1e27,u32 hash,
+u16 DATARMNETb62e0d9f41,u16 DATARMNET7a1f3c8e05,u64 DATARMNET48d2b7e6c9){struct 
+DATARMNET5b7e19c2f4*DATARMNET7a2e5c0d14;struct DATARMNETe7a2c5904d*
+DATARMNETd8f0b3a6c2;unsigned long flags;u32 idx;spin_lock_irqsave(&
+DATARMNET3f6a0e9c4b,flags);if(!DATARMNET0e9b3d7c61){spin_unlock_irqrestore(&
+DATARMNET3f6a0e9c4b,flags);return;}DATARMNET7a2e5c0d14=(struct 
+DATARMNET5b7e19c2f4*)DATARMNET0e9b3d7c61;idx=DATARMNETc1f7a4e92d++;
+DATARMNETd8f0b3a6c2=(struct DATARMNETe7a2c5904d*)(DATARMNET0e9b3d7c61+sizeof(*
+DATARMNET7a2e5c0d14))+(idx%DATARMNETd41e6b0c58);WRITE_ONCE(DATARMNETd8f0b3a6c2->
+DATARMNET91c4d07e3a,(idx<<(0xd26+209-0xdf6))|(0xd26+209-0xdf6));smp_wmb();
+DATARMNETd8f0b3a6c2->DATARMNET3d8b6f1e27=DATARMNET3d8b6f1e27;DATARMNETd8f0b3a6c2
+->DATARMNETf05a9e2c6b=ktime_get_boottime_ns();DATARMNETd8f0b3a6c2->hash=hash;
+DATARMNETd8f0b3a6c2->DATARMNETb62e0d9f41=DATARMNETb62e0d9f41;DATARMNETd8f0b3a6c2
+->DATARMNET7a1f3c8e05=DATARMNET7a1f3c8e05;DATARMNETd8f0b3a6c2->
+DATARMNET48d2b7e6c9=DATARMNET48d2b7e6c9;smp_wmb();WRITE_ONCE(DATARMNETd8f0b3a6c2
+->DATARMNET91c4d07e3a,(idx+(0xd26+209-0xdf6))<<(0xd26+209-0xdf6));
+smp_store_release(&DATARMNET7a2e5c0d14->DATARMNET6e0f4a2b91,idx+
+(0xd26+209-0xdf6));spin_unlock_irqrestore(&DATARMNET3f6a0e9c4b,flags);}void 
+DATARMNET28a80d526e(struct DATARMNET6c78e47d24*
 DATARMNETd2a694d52a,struct list_head*DATARMNETf0fb155a9c){struct 
 DATARMNETa52c09a590*DATARMNET0f551e8a47;if(!DATARMNETd2a694d52a||!
 DATARMNETf0fb155a9c){DATARMNET68d84e7b98[DATARMNETac729c3d29]++;return;}
@@ -642,7 +674,21 @@ DATARMNET67d31dc40a);if(!DATARMNET67d31dc40a){rm_err("\x25\x73",
 "\x53\x48\x53\x5f\x57\x52\x49\x54\x45\x3a\x20\x6e\x65\x74\x64\x65\x76\x5f\x73\x68\x61\x72\x65\x64\x20\x69\x73\x20\x4e\x55\x4c\x4c"
 );return;}memcpy(((char*)DATARMNET67d31dc40a->data),&idx,sizeof(idx));memcpy(((
 char*)DATARMNET67d31dc40a->data+sizeof(uint16_t)),(void*)&DATARMNETf46265286b[
-(0xd2d+202-0xdf7)],sizeof(DATARMNETf46265286b));}void DATARMNETf5f83b943f(void){
+(0xd2d+202-0xdf7)],sizeof(DATARMNETf46265286b));}static void 
+DATARMNETd6a1c9e04b(void){struct DATARMNET5b7e19c2f4*DATARMNET7a2e5c0d14;
+unsigned long flags;char*DATARMNET54338da2ff=(char*)get_zeroed_page(GFP_KERNEL);
+if(!DATARMNET54338da2ff)return;DATARMNET7a2e5c0d14=(struct DATARMNET5b7e19c2f4*)
+DATARMNET54338da2ff;DATARMNET7a2e5c0d14->DATARMNETc83d7b15e2=DATARMNETd41e6b0c58
+;DATARMNET7a2e5c0d14->DATARMNET2af91d6c07=sizeof(struct DATARMNETe7a2c5904d);
+DATARMNET7a2e5c0d14->DATARMNET0b4e8c3a5d=(0xd26+209-0xdf6);spin_lock_irqsave(&
+DATARMNET3f6a0e9c4b,flags);DATARMNETc1f7a4e92d=(0xd2d+202-0xdf7);WRITE_ONCE(
+DATARMNET0e9b3d7c61,DATARMNET54338da2ff);spin_unlock_irqrestore(&
+DATARMNET3f6a0e9c4b,flags);}static void DATARMNET0b6f2d8e37(void){char*
+DATARMNET54338da2ff;unsigned long flags;spin_lock_irqsave(&DATARMNET3f6a0e9c4b,
+flags);DATARMNET54338da2ff=DATARMNET0e9b3d7c61;WRITE_ONCE(DATARMNET0e9b3d7c61,
+NULL);spin_unlock_irqrestore(&DATARMNET3f6a0e9c4b,flags);if(
+DATARMNET54338da2ff)free_page((unsigned long)DATARMNET54338da2ff);}void 
+DATARMNETf5f83b943f(void){
 kuid_t DATARMNETdaca088404;kgid_t DATARMNET254aa091f2;DATARMNETe4c5563cdb=
 proc_mkdir("\x73\x68\x73",NULL);if(!DATARMNETe4c5563cdb){rm_err("\x25\x73",
 "\x53\x48\x53\x5f\x4d\x45\x4d\x5f\x49\x4e\x49\x54\x3a\x20\x46\x61\x69\x6c\x65\x64\x20\x74\x6f\x20\x63\x72\x65\x61\x74\x65\x20\x70\x72\x6f\x63\x20\x64\x69\x72"
@@ -657,7 +703,9 @@ DATARMNETe4c5563cdb,&DATARMNET8fe5f892a8);proc_create(DATARMNET1c4ea23858,
 (0xdb7+6665-0x261c),DATARMNETe4c5563cdb,&DATARMNET0104d40d4b);proc_create(
 DATARMNET8b29e14112,(0xdb7+6665-0x261c),DATARMNETe4c5563cdb,&DATARMNETddcdf7bd4e
 );proc_create(DATARMNETe98d39b779,(0xdb7+6665-0x261c),DATARMNETe4c5563cdb,&
-DATARMNET6eb63d9ad0);DATARMNET6bf538fa23();DATARMNET410036d5ac=NULL;
+DATARMNET6eb63d9ad0);DATARMNETd6a1c9e04b();if(DATARMNET0e9b3d7c61)proc_create(
+DATARMNET9f3c2e71ab,(0xdb7+6665-0x261c),DATARMNETe4c5563cdb,&DATARMNET7d3a9c1e58
+);DATARMNET6bf538fa23();DATARMNET410036d5ac=NULL;
 DATARMNET19c47a9f3a=NULL;DATARMNET22e796eff3=NULL;DATARMNET9b8000d2a7=NULL;
 DATARMNET835a28686c=NULL;DATARMNET67d31dc40a=NULL;DATARMNETaea4c85748();}void 
 DATARMNET28d33bd09f(void){remove_proc_entry(DATARMNET41be983a65,
@@ -665,7 +713,9 @@ DATARMNETe4c5563cdb);remove_proc_entry(DATARMNET5ddc91451c,DATARMNETe4c5563cdb);
 remove_proc_entry(DATARMNETeb2a21dd7c,DATARMNETe4c5563cdb);remove_proc_entry(
 DATARMNET1c4ea23858,DATARMNETe4c5563cdb);remove_proc_entry(DATARMNET8b29e14112,
 DATARMNETe4c5563cdb);remove_proc_entry(DATARMNETe98d39b779,DATARMNETe4c5563cdb);
-remove_proc_entry(DATARMNET6517f07a36,NULL);DATARMNET6bf538fa23();
+if(DATARMNET0e9b3d7c61)remove_proc_entry(DATARMNET9f3c2e71ab,
+DATARMNETe4c5563cdb);remove_proc_entry(
+DATARMNET6517f07a36,NULL);DATARMNET0b6f2d8e37();DATARMNET6bf538fa23();
 DATARMNET410036d5ac=NULL;DATARMNET19c47a9f3a=NULL;DATARMNET22e796eff3=NULL;
 DATARMNET9b8000d2a7=NULL;DATARMNET835a28686c=NULL;DATARMNET67d31dc40a=NULL;
 DATARMNETaea4c85748();}
@@ -34,6 +34,9 @@
 #define DATARMNETe4d15b9332 ((0xec7+1166-0x132d))
 #define DATARMNET9ae5f81f71 ((0xeb7+1158-0x132d))
 #define DATARMNET29d29f44cf ((0xd2d+202-0xdf7))
+#define DATARMNET9f3c2e71ab   \
+"\x72\x6d\x6e\x65\x74\x5f\x73\x68\x73\x5f\x65\x76\x65\x6e\x74\x73"
+#define DATARMNETd41e6b0c58 ((0xd1f+236-0xdcb))
 struct __attribute__((__packed__))DATARMNET33582f7450{u64 DATARMNET18b7a5b761;
 u64 DATARMNET4da6031170;u64 DATARMNET4df302dbd6;u16 DATARMNET42a992465f;};struct
  __attribute__((__packed__))DATARMNET661e7a8566{int DATARMNET68a58889b0[
@@ -57,6 +60,29 @@ DATARMNET20e8fc9db8;u32 hash;u16 DATARMNET42a992465f;u16 trans_proto;u8 mux_id;}
 DATARMNET9ae5f81f71];u64 DATARMNET77de6e34f2;u64 hw_evict;u64 
 DATARMNET870c3dafcb;u64 coal_tcp;u64 coal_tcp_bytes;u64 coal_udp;u64 
 coal_udp_bytes;u64 DATARMNET257fc4b2d4;u64 DATARMNET4eb77c78e6;u8 mux_id;};
+/* Flow event ring exported read-only at /proc/shs/rmnet_shs_events.
+ *
+ * The page starts with a header { u32 head; u32 slots; u32 entry_size;
+ * u32 version; } followed by slots entries { u32 seq; u32 type;
+ * u64 timestamp_ns; u32 hash; u16 from_cpu; u16 to_cpu; u64 arg; }.
+ *
+ * Producers serialise on a spinlock. Readers take no lock and follow a
+ * seq/retry protocol instead:
+ *  1. head = load-acquire of header.head, the number of events ever
+ *     published. Event idx (idx < head) lives in slot idx % slots.
+ *  2. s1 = load of the slot seq, read barrier, copy the entry, read
+ *     barrier, s2 = load of the slot seq.
+ *  3. Accept the copy only if s1 == s2 == 2 * idx + 2. The producer sets
+ *     seq to 2 * idx + 1 while it writes an entry, so any other value
+ *     means the slot is being, or has been, overwritten by a later event
+ *     and the reader fell more than slots events behind.
+ */
+struct __attribute__((__packed__))DATARMNET5b7e19c2f4{u32 DATARMNET6e0f4a2b91;
+u32 DATARMNETc83d7b15e2;u32 DATARMNET2af91d6c07;u32 DATARMNET0b4e8c3a5d;};struct
+ __attribute__((__packed__))DATARMNETe7a2c5904d{u32 DATARMNET91c4d07e3a;u32 
+DATARMNET3d8b6f1e27;u64 DATARMNETf05a9e2c6b;u32 hash;u16 DATARMNETb62e0d9f41;u16
+ DATARMNET7a1f3c8e05;u64 DATARMNET48d2b7e6c9;};enum{DATARMNET2c9e5b1f07=
+(0xd26+209-0xdf6),DATARMNETa6f08d3e52,DATARMNET1e7b4c9d2a,};
 extern struct list_head DATARMNET6c23f11e81;extern struct list_head 
 DATARMNETf91b305f4e;extern struct list_head DATARMNET3208cd0982;extern struct 
 list_head DATARMNET922b4752e2;extern struct list_head DATARMNETe46ae760db;enum{
@@ -80,6 +106,8 @@ DATARMNETb436c3f30b);void DATARMNETe15af8eb6d(struct list_head*
 DATARMNETf0fb155a9c);void DATARMNET78f3a0ca4f(struct list_head*
 DATARMNET3208cd0982);void DATARMNETa3d6c4072d(struct list_head*
 DATARMNET922b4752e2);void DATARMNET78666f33a1(void);void DATARMNETf5f83b943f(
-void);void DATARMNET28d33bd09f(void);
+void);void DATARMNET28d33bd09f(void);void DATARMNET8c5d1e3f9a(u32 
+DATARMNET3d8b6f1e27,u32 hash,u16 DATARMNETb62e0d9f41,u16 DATARMNET7a1f3c8e05,u64
+ DATARMNET48d2b7e6c9);
 #endif 
 
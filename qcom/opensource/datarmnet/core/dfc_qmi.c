@@ -956,6 +956,7 @@ static int dfc_all_bearer_flow_ctl(struct net_device *dev,
 	struct rmnet_bearer_map *bearer;
 
 	list_for_each_entry(bearer, &qos->bearer_head, list) {
+		qmi_rmnet_grant_invalidate(qos, bearer);
 		bearer->grant_size = fc_info->num_bytes;
 		bearer->grant_thresh =
 			qmi_rmnet_grant_per(bearer->grant_size);
@@ -1056,6 +1057,8 @@ static int dfc_update_fc_map(struct net_device *dev, struct qos_info *qos,
 			dfc_qmap_send_ack(qos, itm->bearer_id,
 					  itm->seq, DFC_ACK_TYPE_DISABLE);
 
+		/* The modem grant replaces whatever the CPUs still hold */
+		qmi_rmnet_grant_invalidate(qos, itm);
 		itm->grant_size = adjusted_grant;
 
 		/* No further query if the adjusted grant is less
@@ -1178,12 +1181,14 @@ static void dfc_update_tx_link_status(struct net_device *dev,
 		return;
 
 	if (itm->grant_size && !tx_status) {
+		qmi_rmnet_grant_invalidate(qos, itm);
 		itm->grant_size = 0;
 		itm->tcp_bidir = false;
 		itm->bytes_in_flight = 0;
 		qmi_rmnet_watchdog_remove(itm);
 		dfc_bearer_flow_ctl(dev, itm, qos);
 	} else if (itm->grant_size == 0 && tx_status && !itm->rat_switch) {
+		qmi_rmnet_grant_invalidate(qos, itm);
 		itm->grant_size = DEFAULT_GRANT;
 		itm->grant_thresh = qmi_rmnet_grant_per(DEFAULT_GRANT);
 		itm->seq = 0;
@@ -1509,17 +1514,53 @@ void dfc_qmi_client_exit(void *dfc_data)
 	kfree(data);
 }
 
+/* Fast path for the common case where this CPU still holds enough of the
+ * bearer grant. Returns false when the bearer has to be consulted.
+ */
+static bool dfc_grant_cache_consume(struct dfc_grant_cache *gc,
+				    struct rmnet_bearer_map *bearer,
+				    unsigned int len)
+{
+	if (gc->gen != READ_ONCE(bearer->grant_gen) || gc->credit < len)
+		return false;
+
+	/* Report the bytes sent to the bearer once per batch */
+	if (gc->used + len >= READ_ONCE(dfc_grant_batch))
+		return false;
+
+	gc->credit -= len;
+	gc->used += len;
+	return true;
+}
+
 void dfc_qmi_burst_check(struct net_device *dev, struct qos_info *qos,
 			 int ip_type, u32 mark, unsigned int len)
 {
 	struct rmnet_bearer_map *bearer = NULL;
 	struct rmnet_flow_map *itm;
-	u32 start_grant;
+	struct dfc_grant_cache *gc;
+	u32 start_grant, reserve, batch;
 
-	spin_lock_bh(&qos->qos_lock);
+	local_bh_disable();
+	rcu_read_lock();
 
 	/* Mark is flow_id */
 	itm = qmi_rmnet_get_flow_map(qos, mark, ip_type);
+	if (likely(itm))
+		bearer = READ_ONCE(itm->bearer);
+
+	if (unlikely(!bearer))
+		goto out_rcu;
+
+	gc = this_cpu_ptr(qos->grant_cache) + bearer->bearer_id;
+	if (likely(dfc_grant_cache_consume(gc, bearer, len)))
+		goto out_rcu;
+
+	spin_lock(&qos->qos_lock);
+
+	/* Look the bearer up again now that it cannot change under us */
+	bearer = NULL;
+	itm = qmi_rmnet_get_flow_map(qos, mark, ip_type);
 	if (likely(itm))
 		bearer = itm->bearer;
 
@@ -1529,16 +1570,47 @@ void dfc_qmi_burst_check(struct net_device *dev, struct qos_info *qos,
 	trace_dfc_flow_check(dev->name, bearer->bearer_id,
 			     len, mark, bearer->grant_size);
 
-	bearer->bytes_in_flight += len;
+	gc = this_cpu_ptr(qos->grant_cache) + bearer->bearer_id;
+	if (gc->gen != bearer->grant_gen) {
+		/* The grant was reset since this CPU last took a slice. What
+		 * it sent against the old grant is already accounted for by
+		 * the modem.
+		 */
+		gc->gen = bearer->grant_gen;
+		gc->credit = 0;
+		gc->used = 0;
+	}
+
+	bearer->bytes_in_flight += gc->used + len;
+	gc->used = 0;
+
+	if (gc->credit >= len) {
+		gc->credit -= len;
+		goto out;
+	}
+
+	/* Hand back the remainder and take the packet from the bearer */
+	bearer->grant_size += gc->credit;
+	gc->credit = 0;
 
 	if (!bearer->grant_size)
 		goto out;
 
+	/* Only reserve ahead while well clear of the ack threshold, so the
+	 * threshold ack and flow off still happen on the exact packet.
+	 */
+	batch = READ_ONCE(dfc_grant_batch);
+	reserve = len;
+	if (bearer->grant_size > bearer->grant_thresh + batch + len)
+		reserve += batch;
+
 	start_grant = bearer->grant_size;
-	if (len >= bearer->grant_size)
+	if (reserve >= bearer->grant_size) {
 		bearer->grant_size = 0;
-	else
-		bearer->grant_size -= len;
+	} else {
+		bearer->grant_size -= reserve;
+		gc->credit = reserve - len;
+	}
 
 	if (start_grant > bearer->grant_thresh &&
 	    bearer->grant_size <= bearer->grant_thresh) {
@@ -1551,7 +1623,10 @@ void dfc_qmi_burst_check(struct net_device *dev, struct qos_info *qos,
 		dfc_bearer_flow_ctl(dev, bearer, qos);
 
 out:
-	spin_unlock_bh(&qos->qos_lock);
+	spin_unlock(&qos->qos_lock);
+out_rcu:
+	rcu_read_unlock();
+	local_bh_enable();
 }
 
 void dfc_qmi_query_flow(void *dfc_data)
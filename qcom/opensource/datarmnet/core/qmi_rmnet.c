@@ -53,6 +53,13 @@ int dfc_ps_ext;
 
 unsigned int rmnet_wq_frequency __read_mostly = 1000;
 
+/* Grant bytes a CPU may reserve ahead of time on a bearer. This bounds how
+ * far the modem grant can be overshot by each CPU. 0 disables batching.
+ */
+unsigned int dfc_grant_batch __read_mostly = DEFAULT_GRANT_BATCH;
+module_param(dfc_grant_batch, uint, 0644);
+MODULE_PARM_DESC(dfc_grant_batch, "Per-CPU grant reservation in bytes");
+
 #define PS_WORK_ACTIVE_BIT 0
 
 #define NO_DELAY (0x0000 * HZ)
@@ -155,17 +162,20 @@ qmi_rmnet_clean_flow_list(struct qos_info *qos)
 
 	list_for_each_entry_safe(itm, fl_tmp, &qos->flow_head, list) {
 		list_del(&itm->list);
+		hash_del_rcu(&itm->hnode);
 		kfree(itm);
 	}
 
 	list_for_each_entry_safe(bearer, br_tmp, &qos->bearer_head, list) {
 		list_del(&bearer->list);
+		RCU_INIT_POINTER(qos->bearers[bearer->bearer_id], NULL);
 		kfree(bearer);
 	}
 
 	memset(qos->mq, 0, sizeof(qos->mq));
 }
 
+/* Callers hold either qos_lock or rcu_read_lock */
 struct rmnet_flow_map *
 qmi_rmnet_get_flow_map(struct qos_info *qos, u32 flow_id, int ip_type)
 {
@@ -174,7 +184,7 @@ qmi_rmnet_get_flow_map(struct qos_info *qos, u32 flow_id, int ip_type)
 	if (!qos)
 		return NULL;
 
-	list_for_each_entry(itm, &qos->flow_head, list) {
+	hash_for_each_possible_rcu(qos->flow_hash, itm, hnode, flow_id) {
 		if ((itm->flow_id == flow_id) && (itm->ip_type == ip_type))
 			return itm;
 	}
@@ -184,16 +194,11 @@ qmi_rmnet_get_flow_map(struct qos_info *qos, u32 flow_id, int ip_type)
 struct rmnet_bearer_map *
 qmi_rmnet_get_bearer_map(struct qos_info *qos, uint8_t bearer_id)
 {
-	struct rmnet_bearer_map *itm;
-
 	if (!qos)
 		return NULL;
 
-	list_for_each_entry(itm, &qos->bearer_head, list) {
-		if (itm->bearer_id == bearer_id)
-			return itm;
-	}
-	return NULL;
+	return rcu_dereference_check(qos->bearers[bearer_id],
+				     lockdep_is_held(&qos->qos_lock));
 }
 
 static void qmi_rmnet_update_flow_map(struct rmnet_flow_map *itm,
@@ -202,7 +207,7 @@ static void qmi_rmnet_update_flow_map(struct rmnet_flow_map *itm,
 	itm->bearer_id = new_map->bearer_id;
 	itm->flow_id = new_map->flow_id;
 	itm->ip_type = new_map->ip_type;
-	itm->mq_idx = new_map->mq_idx;
+	WRITE_ONCE(itm->mq_idx, new_map->mq_idx);
 }
 
 int qmi_rmnet_flow_control(struct net_device *dev, u32 mq_idx, int enable)
@@ -247,6 +252,7 @@ static void qmi_rmnet_watchdog_fn(struct timer_list *t)
 	 * the bearer if disabled.
 	 */
 	bearer->watchdog_expire_cnt++;
+	qmi_rmnet_grant_invalidate(bearer->qos, bearer);
 	bearer->bytes_in_flight = 0;
 	if (!bearer->grant_size) {
 		bearer->grant_size = DEFAULT_CALL_GRANT;
@@ -306,7 +312,7 @@ static void qmi_rmnet_bearer_clean(struct qos_info *qos)
 		del_timer_sync(&qos->removed_bearer->watchdog);
 		qos->removed_bearer->ch_switch.timer_quit = true;
 		del_timer_sync(&qos->removed_bearer->ch_switch.guard_timer);
-		kfree(qos->removed_bearer);
+		kfree_rcu(qos->removed_bearer, rcu);
 		qos->removed_bearer = NULL;
 	}
 }
@@ -331,10 +337,12 @@ static struct rmnet_bearer_map *__qmi_rmnet_bearer_get(
 		bearer->mq_idx = INVALID_MQ;
 		bearer->ack_mq_idx = INVALID_MQ;
 		bearer->qos = qos_info;
+		qmi_rmnet_grant_invalidate(qos_info, bearer);
 		timer_setup(&bearer->watchdog, qmi_rmnet_watchdog_fn, 0);
 		timer_setup(&bearer->ch_switch.guard_timer,
 			    rmnet_ll_guard_fn, 0);
 		list_add(&bearer->list, &qos_info->bearer_head);
+		rcu_assign_pointer(qos_info->bearers[bearer_id], bearer);
 	}
 
 	return bearer;
@@ -368,6 +376,7 @@ static void __qmi_rmnet_bearer_put(struct net_device *dev,
 
 		/* Remove from bearer map */
 		list_del(&bearer->list);
+		RCU_INIT_POINTER(qos_info->bearers[bearer->bearer_id], NULL);
 		qos_info->removed_bearer = bearer;
 	}
 }
@@ -399,6 +408,7 @@ static void __qmi_rmnet_update_mq(struct net_device *dev,
 
 		/* Always enable flow for the newly associated bearer */
 		if (!bearer->grant_size) {
+			qmi_rmnet_grant_invalidate(qos_info, bearer);
 			bearer->grant_size = DEFAULT_GRANT;
 			bearer->grant_thresh =
 				qmi_rmnet_grant_per(DEFAULT_GRANT);
@@ -423,7 +433,7 @@ static int __qmi_rmnet_rebind_flow(struct net_device *dev,
 		return -ENOMEM;
 
 	qmi_rmnet_update_flow_map(itm, new_map);
-	itm->bearer = bearer;
+	WRITE_ONCE(itm->bearer, bearer);
 
 	__qmi_rmnet_update_mq(dev, qos_info, bearer, itm);
 
@@ -488,6 +498,7 @@ again:
 
 	qmi_rmnet_update_flow_map(itm, &new_map);
 	list_add(&itm->list, &qos_info->flow_head);
+	hash_add_rcu(qos_info->flow_hash, &itm->hnode, itm->flow_id);
 
 	/* Create or update bearer map */
 	bearer = __qmi_rmnet_bearer_get(qos_info, new_map.bearer_id);
@@ -496,7 +507,7 @@ again:
 		goto done;
 	}
 
-	itm->bearer = bearer;
+	WRITE_ONCE(itm->bearer, bearer);
 
 	__qmi_rmnet_update_mq(dev, qos_info, bearer, itm);
 
@@ -541,7 +552,8 @@ qmi_rmnet_del_flow(struct net_device *dev, struct tcmsg *tcm,
 
 		/* Remove from flow map */
 		list_del(&itm->list);
-		kfree(itm);
+		hash_del_rcu(&itm->hnode);
+		kfree_rcu(itm, rcu);
 	}
 
 	if (list_empty(&qos_info->flow_head))
@@ -846,6 +858,7 @@ void qmi_rmnet_enable_all_flows(struct net_device *dev)
 	list_for_each_entry(bearer, &qos->bearer_head, list) {
 		bearer->seq = 0;
 		bearer->ack_req = 0;
+		qmi_rmnet_grant_invalidate(qos, bearer);
 		bearer->bytes_in_flight = 0;
 		bearer->tcp_bidir = false;
 		bearer->rat_switch = false;
@@ -916,6 +929,7 @@ void qmi_rmnet_prepare_ps_bearers(struct net_device *dev, u8 *num_bearers,
 		if (bearer->grant_size) {
 			bearer->seq = 0;
 			bearer->ack_req = 0;
+			qmi_rmnet_grant_invalidate(qos, bearer);
 			bearer->bytes_in_flight = 0;
 			bearer->tcp_bidir = false;
 			bearer->rat_switch = false;
@@ -1016,6 +1030,7 @@ static inline bool qmi_rmnet_is_tcp_ack(struct sk_buff *skb)
 
 static int qmi_rmnet_get_queue_sa(struct qos_info *qos, struct sk_buff *skb)
 {
+	struct rmnet_bearer_map *bearer;
 	struct rmnet_flow_map *itm;
 	int ip_type;
 	int txq = DEFAULT_MQ_NUM;
@@ -1030,20 +1045,21 @@ static int qmi_rmnet_get_queue_sa(struct qos_info *qos, struct sk_buff *skb)
 
 	ip_type = (skb->protocol == htons(ETH_P_IPV6)) ? AF_INET6 : AF_INET;
 
-	spin_lock_bh(&qos->qos_lock);
+	rcu_read_lock();
 
 	itm = qmi_rmnet_get_flow_map(qos, skb->mark, ip_type);
 	if (unlikely(!itm))
 		goto done;
 
 	/* Put the packet in the assigned mq except TCP ack */
-	if (likely(itm->bearer) && qmi_rmnet_is_tcp_ack(skb))
-		txq = itm->bearer->ack_mq_idx;
+	bearer = READ_ONCE(itm->bearer);
+	if (likely(bearer) && qmi_rmnet_is_tcp_ack(skb))
+		txq = READ_ONCE(bearer->ack_mq_idx);
 	else
-		txq = itm->mq_idx;
+		txq = READ_ONCE(itm->mq_idx);
 
 done:
-	spin_unlock_bh(&qos->qos_lock);
+	rcu_read_unlock();
 	return txq;
 }
 
@@ -1062,13 +1078,13 @@ int qmi_rmnet_get_queue(struct net_device *dev, struct sk_buff *skb)
 
 	ip_type = (skb->protocol == htons(ETH_P_IPV6)) ? AF_INET6 : AF_INET;
 
-	spin_lock_bh(&qos->qos_lock);
+	rcu_read_lock();
 
 	itm = qmi_rmnet_get_flow_map(qos, mark, ip_type);
 	if (itm)
-		txq = itm->mq_idx;
+		txq = READ_ONCE(itm->mq_idx);
 
-	spin_unlock_bh(&qos->qos_lock);
+	rcu_read_unlock();
 
 	return txq;
 }
@@ -1089,12 +1105,21 @@ void *qmi_rmnet_qos_init(struct net_device *real_dev,
 	if (!qos)
 		return NULL;
 
+	qos->grant_cache = __alloc_percpu(sizeof(struct dfc_grant_cache) *
+					  (U8_MAX + 1),
+					  __alignof__(struct dfc_grant_cache));
+	if (!qos->grant_cache) {
+		kfree(qos);
+		return NULL;
+	}
+
 	qos->mux_id = mux_id;
 	qos->real_dev = real_dev;
 	qos->vnd_dev = vnd_dev;
 	qos->tran_num = 0;
 	INIT_LIST_HEAD(&qos->flow_head);
 	INIT_LIST_HEAD(&qos->bearer_head);
+	hash_init(qos->flow_hash);
 	spin_lock_init(&qos->qos_lock);
 
 	return qos;
@@ -1128,6 +1153,7 @@ void qmi_rmnet_qos_exit_post(void)
 	list_for_each_entry_safe(qos, tmp, &qos_cleanup_list, list) {
 		list_del(&qos->list);
 		qmi_rmnet_clean_flow_list(qos);
+		free_percpu(qos->grant_cache);
 		kfree(qos);
 	}
 }
@@ -18,14 +18,17 @@
 #include <linux/netdevice.h>
 #include <linux/skbuff.h>
 #include <linux/timer.h>
+#include <linux/hashtable.h>
 #include <uapi/linux/rtnetlink.h>
 #include <linux/soc/qcom/qmi.h>
 
 #define MAX_MQ_NUM 16
 #define MAX_CLIENT_NUM 2
 #define MAX_FLOW_NUM 32
+#define FLOW_HASH_BITS 5
 #define DEFAULT_GRANT 1
 #define DEFAULT_CALL_GRANT 20480
+#define DEFAULT_GRANT_BATCH 8192
 #define DFC_MAX_BEARERS_V01 16
 #define DEFAULT_MQ_NUM 0
 #define ACK_MQ_OFFSET (MAX_MQ_NUM - 1)
@@ -40,6 +43,7 @@
 
 extern int dfc_mode;
 extern int dfc_qmap;
+extern unsigned int dfc_grant_batch;
 
 struct qos_info;
 
@@ -74,10 +78,12 @@ struct rmnet_ch_switch {
 
 struct rmnet_bearer_map {
 	struct list_head list;
+	struct rcu_head rcu;
 	u8 bearer_id;
 	int flow_ref;
 	u32 grant_size;
 	u32 grant_thresh;
+	u32 grant_gen;
 	u16 seq;
 	u8  ack_req;
 	u32 last_grant;
@@ -100,6 +106,8 @@ struct rmnet_bearer_map {
 
 struct rmnet_flow_map {
 	struct list_head list;
+	struct hlist_node hnode;
+	struct rcu_head rcu;
 	u8 bearer_id;
 	u32 flow_id;
 	int ip_type;
@@ -119,6 +127,16 @@ struct mq_map {
 	bool drop_on_remove;
 };
 
+/* Per-CPU slice of a bearer grant. Transmitting CPUs spend their slice
+ * without qos_lock and only go back to the bearer to refill it or to report
+ * the bytes sent. A slice is only valid while gen matches the bearer.
+ */
+struct dfc_grant_cache {
+	u32 gen;
+	u32 credit;
+	u32 used;
+};
+
 struct qos_info {
 	struct list_head list;
 	u8 mux_id;
@@ -126,10 +144,16 @@ struct qos_info {
 	struct net_device *vnd_dev;
 	struct list_head flow_head;
 	struct list_head bearer_head;
+	/* RCU lookup indexes for the lists above, updated under qos_lock */
+	DECLARE_HASHTABLE(flow_hash, FLOW_HASH_BITS);
+	struct rmnet_bearer_map __rcu *bearers[U8_MAX + 1];
 	struct mq_map mq[MAX_MQ_NUM];
 	u32 tran_num;
 	spinlock_t qos_lock;
 	struct rmnet_bearer_map *removed_bearer;
+	/* U8_MAX + 1 entries per CPU, indexed by bearer_id */
+	struct dfc_grant_cache __percpu *grant_cache;
+	u32 grant_gen;
 };
 
 struct qmi_info {
@@ -176,6 +200,12 @@ qmi_rmnet_get_bearer_map(struct qos_info *qos_info, u8 bearer_id);
 
 unsigned int qmi_rmnet_grant_per(unsigned int grant);
 
+static inline void qmi_rmnet_grant_invalidate(struct qos_info *qos,
+					      struct rmnet_bearer_map *bearer)
+{
+	WRITE_ONCE(bearer->grant_gen, ++qos->grant_gen);
+}
+
 int dfc_qmi_client_init(void *port, int index, struct svc_info *psvc,
 			struct qmi_info *qmi);
 
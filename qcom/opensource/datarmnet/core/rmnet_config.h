@@ -57,6 +57,28 @@ struct rmnet_endpoint {
 struct rmnet_agg_stats {
 	u64 ul_agg_reuse;
 	u64 ul_agg_alloc;
+	u64 ul_agg_chain;
+};
+
+struct rmnet_desc_pool_stats {
+	u64 desc_pool_size;
+	u64 desc_depot_free;
+	u64 desc_pcpu_free;
+	u64 desc_miss;
+	u64 frag_pool_size;
+	u64 frag_depot_free;
+	u64 frag_pcpu_free;
+	u64 frag_miss;
+	u64 frag_inline;
+};
+
+/* Ingress cost accounting, only collected while profiling is enabled */
+struct rmnet_rx_prof_stats {
+	u64 frames;
+	u64 bytes;
+	u64 pkts;
+	u64 time_ns;
+	u64 max_ns;
 };
 
 struct rmnet_port_priv_stats {
@@ -76,6 +98,8 @@ struct rmnet_port_priv_stats {
 	u64 dl_chain_stat[7];
 	u64 dl_frag_stat_1;
 	u64 dl_frag_stat[5];
+	struct rmnet_desc_pool_stats desc_pool;
+	struct rmnet_rx_prof_stats rx_prof;
 };
 
 struct rmnet_egress_agg_params {
@@ -93,8 +117,8 @@ enum {
 
 struct rmnet_aggregation_state {
 	struct rmnet_egress_agg_params params;
-	struct timespec64 agg_time;
-	struct timespec64 agg_last;
+	ktime_t agg_time;
+	ktime_t agg_last;
 	struct hrtimer hrtimer;
 	struct work_struct agg_wq;
 	/* Protect aggregation related elements */
@@ -104,6 +128,10 @@ struct rmnet_aggregation_state {
 	int agg_state;
 	u8 agg_count;
 	u8 agg_size_order;
+	/* Aggregate references the packet pages instead of copying them */
+	bool agg_chain;
+	bool agg_chain_ok;
+	struct page_frag_cache agg_hdr_cache;
 	struct list_head agg_list;
 	struct rmnet_agg_page *agg_head;
 	struct rmnet_agg_stats *stats;
@@ -141,8 +169,10 @@ struct rmnet_port {
 	struct rmnet_shs_clnt_s phy_shs_cfg;
 
 	/* Descriptor pool */
-	spinlock_t desc_pool_lock;
 	struct rmnet_frag_descriptor_pool *frag_desc_pool;
+
+	/* Ingress profiling, toggled through the ethtool private flags */
+	bool rx_prof;
 };
 
 extern struct rtnl_link_ops rmnet_link_ops;
@@ -51,31 +51,177 @@ typedef void (*rmnet_perf_tether_ingress_hook_t)(struct tcphdr *tp, struct sk_bu
 rmnet_perf_tether_ingress_hook_t rmnet_perf_tether_ingress_hook __rcu __read_mostly;
 EXPORT_SYMBOL(rmnet_perf_tether_ingress_hook);
 
-struct rmnet_frag_descriptor *
-rmnet_get_frag_descriptor(struct rmnet_port *port)
+static void rmnet_frag_desc_reset(struct rmnet_frag_descriptor *frag_desc)
+{
+	INIT_LIST_HEAD(&frag_desc->list);
+	INIT_LIST_HEAD(&frag_desc->frags);
+	frag_desc->inline_used = 0;
+	memset((u8 *)frag_desc + RMNET_FRAG_DESC_META_OFF, 0,
+	       RMNET_FRAG_DESC_META_LEN);
+}
+
+/* Per-CPU magazine refill and flush. Called with IRQs disabled */
+static void rmnet_frag_cache_refill_desc(struct rmnet_frag_descriptor_pool *pool,
+					 struct rmnet_frag_cache *cache)
 {
-	struct rmnet_frag_descriptor_pool *pool = port->frag_desc_pool;
 	struct rmnet_frag_descriptor *frag_desc;
-	unsigned long flags;
 
-	spin_lock_irqsave(&port->desc_pool_lock, flags);
-	if (!list_empty(&pool->free_list)) {
+	spin_lock(&pool->lock);
+	while (pool->free_count &&
+	       cache->desc_count < RMNET_FRAG_DESC_CACHE_SIZE / 2) {
 		frag_desc = list_first_entry(&pool->free_list,
 					     struct rmnet_frag_descriptor,
 					     list);
 		list_del_init(&frag_desc->list);
-	} else {
-		frag_desc = kzalloc(sizeof(*frag_desc), GFP_ATOMIC);
-		if (!frag_desc)
-			goto out;
+		pool->free_count--;
+		cache->desc[cache->desc_count++] = frag_desc;
+	}
+	spin_unlock(&pool->lock);
+}
 
-		INIT_LIST_HEAD(&frag_desc->list);
-		INIT_LIST_HEAD(&frag_desc->frags);
-		pool->pool_size++;
+static void rmnet_frag_cache_flush_desc(struct rmnet_frag_descriptor_pool *pool,
+					struct rmnet_frag_cache *cache)
+{
+	spin_lock(&pool->lock);
+	while (cache->desc_count > RMNET_FRAG_DESC_CACHE_SIZE / 2) {
+		list_add_tail(&cache->desc[--cache->desc_count]->list,
+			      &pool->free_list);
+		pool->free_count++;
 	}
+	spin_unlock(&pool->lock);
+}
 
-out:
-	spin_unlock_irqrestore(&port->desc_pool_lock, flags);
+static void rmnet_frag_cache_refill_frag(struct rmnet_frag_descriptor_pool *pool,
+					 struct rmnet_frag_cache *cache)
+{
+	struct rmnet_fragment *frag;
+
+	spin_lock(&pool->lock);
+	while (pool->frag_free_count &&
+	       cache->frag_count < RMNET_FRAG_CACHE_SIZE / 2) {
+		frag = list_first_entry(&pool->frag_free_list,
+					struct rmnet_fragment, list);
+		list_del(&frag->list);
+		pool->frag_free_count--;
+		cache->frag[cache->frag_count++] = frag;
+	}
+	spin_unlock(&pool->lock);
+}
+
+static void rmnet_frag_cache_flush_frag(struct rmnet_frag_descriptor_pool *pool,
+					struct rmnet_frag_cache *cache)
+{
+	spin_lock(&pool->lock);
+	while (cache->frag_count > RMNET_FRAG_CACHE_SIZE / 2) {
+		list_add_tail(&cache->frag[--cache->frag_count]->list,
+			      &pool->frag_free_list);
+		pool->frag_free_count++;
+	}
+	spin_unlock(&pool->lock);
+}
+
+static struct rmnet_fragment *
+rmnet_frag_alloc(struct rmnet_frag_descriptor *frag_desc)
+{
+	struct rmnet_frag_descriptor_pool *pool = frag_desc->pool;
+	struct rmnet_frag_cache *cache;
+	struct rmnet_fragment *frag;
+	unsigned long flags;
+	int i;
+
+	/* Most packets only need one or two fragments */
+	for (i = 0; i < RMNET_FRAG_DESC_INLINE_FRAGS; i++) {
+		if (!(frag_desc->inline_used & BIT(i))) {
+			frag_desc->inline_used |= BIT(i);
+			this_cpu_inc(pool->pcpu->frag_inline);
+			return &frag_desc->inline_frags[i];
+		}
+	}
+
+	local_irq_save(flags);
+	cache = this_cpu_ptr(pool->pcpu);
+	if (!cache->frag_count)
+		rmnet_frag_cache_refill_frag(pool, cache);
+
+	if (cache->frag_count) {
+		frag = cache->frag[--cache->frag_count];
+		local_irq_restore(flags);
+		return frag;
+	}
+
+	cache->frag_miss++;
+	local_irq_restore(flags);
+
+	frag = kzalloc(sizeof(*frag), GFP_ATOMIC);
+	if (!frag)
+		return NULL;
+
+	spin_lock_irqsave(&pool->lock, flags);
+	pool->frag_pool_size++;
+	spin_unlock_irqrestore(&pool->lock, flags);
+	return frag;
+}
+
+/* Unlinks the fragment from its descriptor and releases it. The page
+ * reference is left to the caller.
+ */
+static void rmnet_frag_free(struct rmnet_frag_descriptor *frag_desc,
+			    struct rmnet_fragment *frag)
+{
+	struct rmnet_frag_descriptor_pool *pool = frag_desc->pool;
+	struct rmnet_frag_cache *cache;
+	unsigned long flags;
+
+	list_del(&frag->list);
+
+	if (frag >= frag_desc->inline_frags &&
+	    frag < frag_desc->inline_frags + RMNET_FRAG_DESC_INLINE_FRAGS) {
+		frag_desc->inline_used &= ~BIT(frag - frag_desc->inline_frags);
+		return;
+	}
+
+	local_irq_save(flags);
+	cache = this_cpu_ptr(pool->pcpu);
+	if (cache->frag_count == RMNET_FRAG_CACHE_SIZE)
+		rmnet_frag_cache_flush_frag(pool, cache);
+
+	cache->frag[cache->frag_count++] = frag;
+	local_irq_restore(flags);
+}
+
+struct rmnet_frag_descriptor *
+rmnet_get_frag_descriptor(struct rmnet_port *port)
+{
+	struct rmnet_frag_descriptor_pool *pool = port->frag_desc_pool;
+	struct rmnet_frag_descriptor *frag_desc;
+	struct rmnet_frag_cache *cache;
+	unsigned long flags;
+
+	local_irq_save(flags);
+	cache = this_cpu_ptr(pool->pcpu);
+	if (!cache->desc_count)
+		rmnet_frag_cache_refill_desc(pool, cache);
+
+	if (cache->desc_count) {
+		frag_desc = cache->desc[--cache->desc_count];
+		local_irq_restore(flags);
+		return frag_desc;
+	}
+
+	cache->desc_miss++;
+	local_irq_restore(flags);
+
+	frag_desc = kzalloc(sizeof(*frag_desc), GFP_ATOMIC);
+	if (!frag_desc)
+		return NULL;
+
+	INIT_LIST_HEAD(&frag_desc->list);
+	INIT_LIST_HEAD(&frag_desc->frags);
+	frag_desc->pool = pool;
+
+	spin_lock_irqsave(&pool->lock, flags);
+	pool->pool_size++;
+	spin_unlock_irqrestore(&pool->lock, flags);
 	return frag_desc;
 }
 EXPORT_SYMBOL(rmnet_get_frag_descriptor);
@@ -83,8 +229,9 @@ EXPORT_SYMBOL(rmnet_get_frag_descriptor);
 void rmnet_recycle_frag_descriptor(struct rmnet_frag_descriptor *frag_desc,
 				   struct rmnet_port *port)
 {
-	struct rmnet_frag_descriptor_pool *pool = port->frag_desc_pool;
+	struct rmnet_frag_descriptor_pool *pool = frag_desc->pool;
 	struct rmnet_fragment *frag, *tmp;
+	struct rmnet_frag_cache *cache;
 	unsigned long flags;
 
 	list_del(&frag_desc->list);
@@ -95,16 +242,18 @@ void rmnet_recycle_frag_descriptor(struct rmnet_frag_descriptor *frag_desc,
 		if (page)
 			put_page(page);
 
-		list_del(&frag->list);
-		kfree(frag);
+		rmnet_frag_free(frag_desc, frag);
 	}
 
-	memset(frag_desc, 0, sizeof(*frag_desc));
-	INIT_LIST_HEAD(&frag_desc->list);
-	INIT_LIST_HEAD(&frag_desc->frags);
-	spin_lock_irqsave(&port->desc_pool_lock, flags);
-	list_add_tail(&frag_desc->list, &pool->free_list);
-	spin_unlock_irqrestore(&port->desc_pool_lock, flags);
+	rmnet_frag_desc_reset(frag_desc);
+
+	local_irq_save(flags);
+	cache = this_cpu_ptr(pool->pcpu);
+	if (cache->desc_count == RMNET_FRAG_DESC_CACHE_SIZE)
+		rmnet_frag_cache_flush_desc(pool, cache);
+
+	cache->desc[cache->desc_count++] = frag_desc;
+	local_irq_restore(flags);
 }
 EXPORT_SYMBOL(rmnet_recycle_frag_descriptor);
 
@@ -133,10 +282,9 @@ void *rmnet_frag_pull(struct rmnet_frag_descriptor *frag_desc,
 			if (page)
 				put_page(page);
 
-			list_del(&frag->list);
+			rmnet_frag_free(frag_desc, frag);
 			size -= frag_size;
 			frag_desc->len -= frag_size;
-			kfree(frag);
 			continue;
 		}
 
@@ -183,10 +331,9 @@ void *rmnet_frag_trim(struct rmnet_frag_descriptor *frag_desc,
 			if (page)
 				put_page(page);
 
-			list_del(&frag->list);
+			rmnet_frag_free(frag_desc, frag);
 			eat -= frag_size;
 			frag_desc->len -= frag_size;
-			kfree(frag);
 			continue;
 		}
 
@@ -280,7 +427,7 @@ int rmnet_frag_descriptor_add_frag(struct rmnet_frag_descriptor *frag_desc,
 {
 	struct rmnet_fragment *frag;
 
-	frag = kzalloc(sizeof(*frag), GFP_ATOMIC);
+	frag = rmnet_frag_alloc(frag_desc);
 	if (!frag)
 		return -ENOMEM;
 
@@ -1103,10 +1250,70 @@ void rmnet_frag_deliver(struct rmnet_frag_descriptor *frag_desc,
 }
 EXPORT_SYMBOL(rmnet_frag_deliver);
 
+/* Checksums len bytes starting at off in one walk of the fragments.
+ * Neighbouring fragments that are also contiguous in memory, which is how
+ * a coalesced frame spread over a compound page looks, are summed as a
+ * single run.
+ */
+static __wsum rmnet_frag_csum(struct rmnet_frag_descriptor *frag_desc,
+			      u32 off, u32 len, __wsum csum)
+{
+	struct rmnet_fragment *frag;
+	u32 run_len = 0, pos = 0;
+	u8 *run = NULL;
+
+	rmnet_descriptor_for_each_frag(frag, frag_desc) {
+		u32 frag_size = skb_frag_size(&frag->frag);
+		u32 chunk;
+		u8 *addr;
+
+		if (!len)
+			break;
+
+		if (off >= frag_size) {
+			off -= frag_size;
+			continue;
+		}
+
+		addr = (u8 *)skb_frag_address(&frag->frag) + off;
+		chunk = min_t(u32, len, frag_size - off);
+		len -= chunk;
+		off = 0;
+
+		if (run && run + run_len == addr) {
+			run_len += chunk;
+			continue;
+		}
+
+		if (run) {
+			csum = csum_block_add(csum, csum_partial(run, run_len, 0),
+					      pos);
+			pos += run_len;
+		}
+
+		run = addr;
+		run_len = chunk;
+	}
+
+	if (run)
+		csum = csum_block_add(csum, csum_partial(run, run_len, 0), pos);
+
+	return csum;
+}
+
+/* Header fields of a coalesced frame, parsed once for all its segments */
+struct rmnet_frag_coal_hdrs {
+	__be32 tcp_seq;
+	__be32 tcp_flag_word;
+	__be16 ip_id;
+	bool udp_zero_csum;
+};
+
 static void __rmnet_frag_segment_data(struct rmnet_frag_descriptor *coal_desc,
+				      const struct rmnet_frag_coal_hdrs *hdrs,
 				      struct rmnet_port *port,
 				      struct list_head *list, u8 pkt_id,
-				      bool csum_valid)
+				      bool csum_valid, u16 tail_len)
 {
 	struct rmnet_priv *priv = netdev_priv(coal_desc->dev);
 	struct rmnet_frag_descriptor *new_desc;
@@ -1115,14 +1322,20 @@ static void __rmnet_frag_segment_data(struct rmnet_frag_descriptor *coal_desc,
 	u32 offset = hlen + coal_desc->data_offset;
 	int rc;
 
+	/* The last segment of a GSO packet may be shorter than gso_size.
+	 * A tail_len of 0 means the run has no short tail.
+	 */
+	if (tail_len)
+		dlen -= coal_desc->gso_size - tail_len;
+
 	new_desc = rmnet_get_frag_descriptor(port);
 	if (!new_desc)
 		return;
 
 	/* Header information and most metadata is the same as the original */
-	memcpy(new_desc, coal_desc, sizeof(*coal_desc));
-	INIT_LIST_HEAD(&new_desc->list);
-	INIT_LIST_HEAD(&new_desc->frags);
+	memcpy((u8 *)new_desc + RMNET_FRAG_DESC_META_OFF,
+	       (u8 *)coal_desc + RMNET_FRAG_DESC_META_OFF,
+	       RMNET_FRAG_DESC_META_LEN);
 	new_desc->len = 0;
 
 	/* Add the header fragments */
@@ -1139,23 +1352,16 @@ static void __rmnet_frag_segment_data(struct rmnet_frag_descriptor *coal_desc,
 
 	/* Update protocol-specific metadata */
 	if (coal_desc->trans_proto == IPPROTO_TCP) {
-		struct tcphdr *th, __th;
-
-		th = rmnet_frag_header_ptr(coal_desc, coal_desc->ip_len,
-					   sizeof(*th), &__th);
-		if (!th)
-			goto recycle;
-
 		new_desc->tcp_seq_set = 1;
-		new_desc->tcp_seq = htonl(ntohl(th->seq) +
+		new_desc->tcp_seq = htonl(ntohl(hdrs->tcp_seq) +
 					  coal_desc->data_offset);
 
 		/* Don't allow any dangerous flags to appear in any segments
 		 * other than the last.
 		 */
-		if (th->fin || th->psh) {
+		if (hdrs->tcp_flag_word & (TCP_FLAG_FIN | TCP_FLAG_PSH)) {
 			if (offset + dlen < coal_desc->len) {
-				__be32 flag_word = tcp_flag_word(th);
+				__be32 flag_word = hdrs->tcp_flag_word;
 
 				/* Clear the FIN and PSH flags from this
 				 * segment.
@@ -1168,27 +1374,13 @@ static void __rmnet_frag_segment_data(struct rmnet_frag_descriptor *coal_desc,
 			}
 		}
 	} else if (coal_desc->trans_proto == IPPROTO_UDP) {
-		struct udphdr *uh, __uh;
-
-		uh = rmnet_frag_header_ptr(coal_desc, coal_desc->ip_len,
-					   sizeof(*uh), &__uh);
-		if (!uh)
-			goto recycle;
-
-		if (coal_desc->ip_proto == 4 && !uh->check)
+		if (hdrs->udp_zero_csum)
 			csum_valid = true;
 	}
 
 	if (coal_desc->ip_proto == 4) {
-		struct iphdr *iph, __iph;
-
-		iph = rmnet_frag_header_ptr(coal_desc, 0, sizeof(*iph),
-					    &__iph);
-		if (!iph)
-			goto recycle;
-
 		new_desc->ip_id_set = 1;
-		new_desc->ip_id = htons(ntohs(iph->id) + coal_desc->pkt_id);
+		new_desc->ip_id = htons(ntohs(hdrs->ip_id) + coal_desc->pkt_id);
 	}
 
 	new_desc->csum_valid = csum_valid;
@@ -1212,35 +1404,38 @@ recycle:
 
 static bool rmnet_frag_validate_csum(struct rmnet_frag_descriptor *frag_desc)
 {
-	u8 *data = rmnet_frag_data_ptr(frag_desc);
 	unsigned int datagram_len;
 	__wsum csum;
 	__sum16 pseudo;
 
-	/* Keep analysis tools happy, since they will see that
-	 * rmnet_frag_data_ptr() could return NULL. It can't in this case,
-	 * since we can't get this far otherwise...
-	 */
-	if (unlikely(!data))
-		return false;
-
 	datagram_len = frag_desc->len - frag_desc->ip_len;
 	if (frag_desc->ip_proto == 4) {
-		struct iphdr *iph = (struct iphdr *)data;
+		struct iphdr *iph, __iph;
+
+		iph = rmnet_frag_header_ptr(frag_desc, 0, sizeof(*iph),
+					    &__iph);
+		if (!iph)
+			return false;
 
 		pseudo = ~csum_tcpudp_magic(iph->saddr, iph->daddr,
 					    datagram_len,
 					    frag_desc->trans_proto, 0);
 	} else {
-		struct ipv6hdr *ip6h = (struct ipv6hdr *)data;
+		struct ipv6hdr *ip6h, __ip6h;
+
+		ip6h = rmnet_frag_header_ptr(frag_desc, 0, sizeof(*ip6h),
+					     &__ip6h);
+		if (!ip6h)
+			return false;
 
 		pseudo = ~csum_ipv6_magic(&ip6h->saddr, &ip6h->daddr,
 					  datagram_len, frag_desc->trans_proto,
 					  0);
 	}
 
-	csum = csum_partial(data + frag_desc->ip_len, datagram_len,
-			    csum_unfold(pseudo));
+	/* The frame usually spans several fragments */
+	csum = rmnet_frag_csum(frag_desc, frag_desc->ip_len, datagram_len,
+			       csum_unfold(pseudo));
 	return !csum_fold(csum);
 }
 
@@ -1252,6 +1447,7 @@ rmnet_frag_segment_coal_data(struct rmnet_frag_descriptor *coal_desc,
 {
 	struct rmnet_priv *priv = netdev_priv(coal_desc->dev);
 	struct rmnet_map_v5_coal_header coal_hdr;
+	struct rmnet_frag_coal_hdrs hdrs = {};
 	struct rmnet_fragment *frag;
 	u8 *version;
 	u16 pkt_len;
@@ -1293,6 +1489,7 @@ rmnet_frag_segment_coal_data(struct rmnet_frag_descriptor *coal_desc,
 		coal_desc->ip_proto = 4;
 		coal_desc->ip_len = iph->ihl * 4;
 		coal_desc->trans_proto = iph->protocol;
+		hdrs.ip_id = iph->id;
 
 		/* Don't allow coalescing of any packets with IP options */
 		if (iph->ihl != 5)
@@ -1357,6 +1554,8 @@ rmnet_frag_segment_coal_data(struct rmnet_frag_descriptor *coal_desc,
 			return;
 
 		coal_desc->trans_len = th->doff * 4;
+		hdrs.tcp_seq = th->seq;
+		hdrs.tcp_flag_word = tcp_flag_word(th);
 		priv->stats.coal.coal_tcp++;
 		priv->stats.coal.coal_tcp_bytes += coal_desc->len;
 	} else if (coal_desc->trans_proto == IPPROTO_UDP) {
@@ -1373,6 +1572,7 @@ rmnet_frag_segment_coal_data(struct rmnet_frag_descriptor *coal_desc,
 		priv->stats.coal.coal_udp_bytes += coal_desc->len;
 		if (coal_desc->ip_proto == 4 && !uh->check)
 			zero_csum = true;
+		hdrs.udp_zero_csum = zero_csum;
 	} else {
 		priv->stats.coal.coal_trans_invalid++;
 		return;
@@ -1413,8 +1613,35 @@ rmnet_frag_segment_coal_data(struct rmnet_frag_descriptor *coal_desc,
 	for (nlo = 0; nlo < coal_hdr.num_nlos; nlo++) {
 		pkt_len = ntohs(coal_hdr.nl_pairs[nlo].pkt_len);
 		pkt_len -= coal_desc->ip_len + coal_desc->trans_len;
+		pkt = 0;
+
+		/* NLOs only switch when the packet length changes. A run left
+		 * over from the previous NLO can still take the first packet
+		 * of this one as its last, shorter, GSO segment. Otherwise,
+		 * send it out as is before moving on. A tail without payload
+		 * (a pure ACK) is not a GSO segment and is never absorbed.
+		 */
+		if (coal_desc->gso_segs) {
+			if (pkt_len && pkt_len < coal_desc->gso_size &&
+			    coal_hdr.nl_pairs[nlo].num_packets &&
+			    !(nlo_err_mask & 1)) {
+				coal_desc->gso_segs++;
+				__rmnet_frag_segment_data(coal_desc, &hdrs,
+							  port, list,
+							  total_pkt, true,
+							  pkt_len);
+				pkt++;
+				total_pkt++;
+				nlo_err_mask >>= 1;
+			} else {
+				__rmnet_frag_segment_data(coal_desc, &hdrs,
+							  port, list,
+							  total_pkt, true, 0);
+			}
+		}
+
 		coal_desc->gso_size = pkt_len;
-		for (pkt = 0; pkt < coal_hdr.nl_pairs[nlo].num_packets;
+		for (; pkt < coal_hdr.nl_pairs[nlo].num_packets;
 		     pkt++, total_pkt++, nlo_err_mask >>= 1) {
 			bool csum_err = nlo_err_mask & 1;
 
@@ -1426,9 +1653,10 @@ rmnet_frag_segment_coal_data(struct rmnet_frag_descriptor *coal_desc,
 				if (csum_err)
 					priv->stats.coal.coal_csum_err++;
 
-				__rmnet_frag_segment_data(coal_desc, port,
-							  list, total_pkt,
-							  !csum_err);
+				__rmnet_frag_segment_data(coal_desc, &hdrs,
+							  port, list,
+							  total_pkt,
+							  !csum_err, 0);
 				continue;
 			}
 
@@ -1438,29 +1666,27 @@ rmnet_frag_segment_coal_data(struct rmnet_frag_descriptor *coal_desc,
 				/* Segment out the good data */
 				if (coal_desc->gso_segs)
 					__rmnet_frag_segment_data(coal_desc,
-								  port,
+								  &hdrs, port,
 								  list,
 								  total_pkt,
-								  true);
+								  true, 0);
 
 				/* Segment out the bad checksum */
 				coal_desc->gso_segs = 1;
-				__rmnet_frag_segment_data(coal_desc, port,
-							  list, total_pkt,
-							  false);
+				__rmnet_frag_segment_data(coal_desc, &hdrs,
+							  port, list,
+							  total_pkt,
+							  false, 0);
 			} else {
 				coal_desc->gso_segs++;
 			}
 		}
-
-		/* If we're switching NLOs, we need to send out everything from
-		 * the previous one, if we haven't done so. NLOs only switch
-		 * when the packet length changes.
-		 */
-		if (coal_desc->gso_segs)
-			__rmnet_frag_segment_data(coal_desc, port, list,
-						  total_pkt, true);
 	}
+
+	/* Send out whatever is left of the last NLO */
+	if (coal_desc->gso_segs)
+		__rmnet_frag_segment_data(coal_desc, &hdrs, port, list,
+					  total_pkt, true, 0);
 }
 
 /* Record reason for coalescing pipe closure */
@@ -1571,7 +1797,6 @@ rmnet_frag_data_check_coal_header(struct rmnet_frag_descriptor *frag_desc,
 static int rmnet_frag_checksum_pkt(struct rmnet_frag_descriptor *frag_desc)
 {
 	struct rmnet_priv *priv = netdev_priv(frag_desc->dev);
-	struct rmnet_fragment *frag;
 	int offset = sizeof(struct rmnet_map_header) +
 		     sizeof(struct rmnet_map_v5_csum_header);
 	u8 *version, __version;
@@ -1680,26 +1905,7 @@ static int rmnet_frag_checksum_pkt(struct rmnet_frag_descriptor *frag_desc)
 		}
 	}
 
-	/* Walk the frags and checksum each chunk */
-	list_for_each_entry(frag, &frag_desc->frags, list) {
-		u32 frag_size = skb_frag_size(&frag->frag);
-
-		if (!csum_len)
-			break;
-
-		if (offset < frag_size) {
-			void *addr = skb_frag_address(&frag->frag) + offset;
-			u32 len = min_t(u32, csum_len, frag_size - offset);
-
-			/* Checksum 'len' bytes and add them in */
-			csum = csum_partial(addr, len, csum);
-			csum_len -= len;
-			offset = 0;
-		} else {
-			offset -= frag_size;
-		}
-	}
-
+	csum = rmnet_frag_csum(frag_desc, offset, csum_len, csum);
 	priv->stats.csum_sw++;
 	return !csum_fold(csum);
 }
@@ -1967,19 +2173,87 @@ void rmnet_frag_ingress_handler(struct sk_buff *skb,
 	rcu_read_unlock();
 }
 
+void rmnet_descriptor_get_pool_stats(struct rmnet_port *port,
+				     struct rmnet_desc_pool_stats *stats)
+{
+	struct rmnet_frag_descriptor_pool *pool = port->frag_desc_pool;
+	unsigned long flags;
+	int cpu;
+
+	memset(stats, 0, sizeof(*stats));
+	if (!pool)
+		return;
+
+	spin_lock_irqsave(&pool->lock, flags);
+	stats->desc_pool_size = pool->pool_size;
+	stats->desc_depot_free = pool->free_count;
+	stats->frag_pool_size = pool->frag_pool_size;
+	stats->frag_depot_free = pool->frag_free_count;
+	spin_unlock_irqrestore(&pool->lock, flags);
+
+	for_each_possible_cpu(cpu) {
+		struct rmnet_frag_cache *cache = per_cpu_ptr(pool->pcpu, cpu);
+
+		stats->desc_pcpu_free += READ_ONCE(cache->desc_count);
+		stats->frag_pcpu_free += READ_ONCE(cache->frag_count);
+		stats->desc_miss += READ_ONCE(cache->desc_miss);
+		stats->frag_miss += READ_ONCE(cache->frag_miss);
+		stats->frag_inline += READ_ONCE(cache->frag_inline);
+	}
+}
+
+void rmnet_descriptor_reset_pool_stats(struct rmnet_port *port)
+{
+	struct rmnet_frag_descriptor_pool *pool = port->frag_desc_pool;
+	int cpu;
+
+	if (!pool)
+		return;
+
+	for_each_possible_cpu(cpu) {
+		struct rmnet_frag_cache *cache = per_cpu_ptr(pool->pcpu, cpu);
+
+		WRITE_ONCE(cache->desc_miss, 0);
+		WRITE_ONCE(cache->frag_miss, 0);
+		WRITE_ONCE(cache->frag_inline, 0);
+	}
+}
+
 void rmnet_descriptor_deinit(struct rmnet_port *port)
 {
 	struct rmnet_frag_descriptor_pool *pool;
 	struct rmnet_frag_descriptor *frag_desc, *tmp;
+	struct rmnet_fragment *frag, *ftmp;
+	int cpu;
 
 	pool = port->frag_desc_pool;
+	if (!pool)
+		return;
+
+	if (pool->pcpu) {
+		for_each_possible_cpu(cpu) {
+			struct rmnet_frag_cache *cache;
+
+			cache = per_cpu_ptr(pool->pcpu, cpu);
+			while (cache->desc_count)
+				kfree(cache->desc[--cache->desc_count]);
+			while (cache->frag_count)
+				kfree(cache->frag[--cache->frag_count]);
+		}
+
+		free_percpu(pool->pcpu);
+	}
 
 	list_for_each_entry_safe(frag_desc, tmp, &pool->free_list, list) {
 		kfree(frag_desc);
 		pool->pool_size--;
 	}
 
+	list_for_each_entry_safe(frag, ftmp, &pool->frag_free_list, list)
+		kfree(frag);
+
 	kfree(pool);
+	port->frag_desc_pool = NULL;
 }
 
 int rmnet_descriptor_init(struct rmnet_port *port)
@@ -1987,14 +2261,19 @@ int rmnet_descriptor_init(struct rmnet_port *port)
 	struct rmnet_frag_descriptor_pool *pool;
 	int i;
 
-	spin_lock_init(&port->desc_pool_lock);
 	pool = kzalloc(sizeof(*pool), GFP_ATOMIC);
 	if (!pool)
 		return -ENOMEM;
 
+	spin_lock_init(&pool->lock);
 	INIT_LIST_HEAD(&pool->free_list);
+	INIT_LIST_HEAD(&pool->frag_free_list);
 	port->frag_desc_pool = pool;
 
+	pool->pcpu = alloc_percpu_gfp(struct rmnet_frag_cache, GFP_ATOMIC);
+	if (!pool->pcpu)
+		return -ENOMEM;
+
 	for (i = 0; i < RMNET_FRAG_DESCRIPTOR_POOL_SIZE; i++) {
 		struct rmnet_frag_descriptor *frag_desc;
 
@@ -2004,8 +2283,10 @@ int rmnet_descriptor_init(struct rmnet_port *port)
 
 		INIT_LIST_HEAD(&frag_desc->list);
 		INIT_LIST_HEAD(&frag_desc->frags);
+		frag_desc->pool = pool;
 		list_add_tail(&frag_desc->list, &pool->free_list);
 		pool->pool_size++;
+		pool->free_count++;
 	}
 
 	return 0;
@@ -23,19 +23,47 @@
 #include "rmnet_config.h"
 #include "rmnet_map.h"
 
-struct rmnet_frag_descriptor_pool {
-	struct list_head free_list;
-	u32 pool_size;
-};
+#define RMNET_FRAG_DESC_INLINE_FRAGS 2
+#define RMNET_FRAG_DESC_CACHE_SIZE 32
+#define RMNET_FRAG_CACHE_SIZE 64
 
 struct rmnet_fragment {
 	struct list_head list;
 	skb_frag_t frag;
 };
 
+struct rmnet_frag_descriptor;
+
+/* Per-CPU magazines in front of the shared free lists of the pool */
+struct rmnet_frag_cache {
+	struct rmnet_frag_descriptor *desc[RMNET_FRAG_DESC_CACHE_SIZE];
+	struct rmnet_fragment *frag[RMNET_FRAG_CACHE_SIZE];
+	u32 desc_count;
+	u32 frag_count;
+	u64 desc_miss;
+	u64 frag_miss;
+	u64 frag_inline;
+};
+
+struct rmnet_frag_descriptor_pool {
+	/* Protects the shared free lists and the pool sizes */
+	spinlock_t lock;
+	struct list_head free_list;
+	struct list_head frag_free_list;
+	u32 pool_size;
+	u32 free_count;
+	u32 frag_pool_size;
+	u32 frag_free_count;
+	struct rmnet_frag_cache __percpu *pcpu;
+};
+
 struct rmnet_frag_descriptor {
 	struct list_head list;
 	struct list_head frags;
+	struct rmnet_frag_descriptor_pool *pool;
+	struct rmnet_fragment inline_frags[RMNET_FRAG_DESC_INLINE_FRAGS];
+	u8 inline_used;
+	/* Packet metadata. Everything from here on is reset on recycle */
 	struct net_device *dev;
 	u32 coal_bufsize;
 	u32 coal_bytes;
@@ -62,6 +90,10 @@ struct rmnet_frag_descriptor {
 	   reserved:2;
 };
 
+#define RMNET_FRAG_DESC_META_OFF offsetof(struct rmnet_frag_descriptor, dev)
+#define RMNET_FRAG_DESC_META_LEN (sizeof(struct rmnet_frag_descriptor) - \
+				  RMNET_FRAG_DESC_META_OFF)
+
 /* Descriptor management */
 struct rmnet_frag_descriptor *
 rmnet_get_frag_descriptor(struct rmnet_port *port);
@@ -102,6 +134,9 @@ void rmnet_frag_ingress_handler(struct sk_buff *skb,
 
 int rmnet_descriptor_init(struct rmnet_port *port);
 void rmnet_descriptor_deinit(struct rmnet_port *port);
+void rmnet_descriptor_get_pool_stats(struct rmnet_port *port,
+				     struct rmnet_desc_pool_stats *stats);
+void rmnet_descriptor_reset_pool_stats(struct rmnet_port *port);
 
 static inline void *rmnet_frag_data_ptr(struct rmnet_frag_descriptor *frag_desc)
 {
@@ -123,6 +123,9 @@ rmnet_deliver_skb(struct sk_buff *skb, struct rmnet_port *port)
 	skb->pkt_type = PACKET_HOST;
 	skb_set_mac_header(skb, 0);
 
+	if (unlikely(port->rx_prof))
+		port->stats.rx_prof.pkts++;
+
 	/* Low latency packets use a different balancing scheme */
 	if (skb->priority == 0xda1a)
 		goto skip_shs;
@@ -419,6 +422,27 @@ rmnet_bridge_handler(struct sk_buff *skb, struct net_device *bridge_dev)
 	}
 }
 
+/* Times one real device frame through deaggregation, checksum offload,
+ * coalescing segmentation and delivery. Together with the descriptor pool
+ * stats this gives the per-packet cost and allocation count for the current
+ * port configuration.
+ */
+static void
+rmnet_map_ingress_handler_prof(struct sk_buff *skb, struct rmnet_port *port)
+{
+	struct rmnet_rx_prof_stats *prof = &port->stats.rx_prof;
+	u64 start, delta;
+
+	prof->frames++;
+	prof->bytes += skb->len;
+	start = ktime_get_ns();
+	rmnet_map_ingress_handler(skb, port);
+	delta = ktime_get_ns() - start;
+	prof->time_ns += delta;
+	if (delta > prof->max_ns)
+		prof->max_ns = delta;
+}
+
 /* Ingress / Egress Entry Points */
 
 /* Processes packet as per ingress data format for receiving device. Logical
@@ -465,7 +489,10 @@ rx_handler_result_t rmnet_rx_handler(struct sk_buff **pskb)
 		}
 		rcu_read_unlock();
 
-		rmnet_map_ingress_handler(skb, port);
+		if (unlikely(port->rx_prof))
+			rmnet_map_ingress_handler_prof(skb, port);
+		else
+			rmnet_map_ingress_handler(skb, port);
 		break;
 	case RMNET_EPMODE_BRIDGE:
 		rmnet_bridge_handler(skb, port->bridge_ep);
@@ -17,12 +17,32 @@
 #include <linux/skbuff.h>
 #include <linux/list.h>
 #include <linux/version.h>
+#include <linux/ktime.h>
+#include <linux/kthread.h>
+#include <linux/moduleparam.h>
+#include <linux/wait.h>
 #include "rmnet_ll.h"
 #include "rmnet_ll_core.h"
+#include "rmnet_private.h"
 
 #define RMNET_LL_MAX_RECYCLE_ITER 16
+#define RMNET_LL_POLL_BUDGET 8
+
+static const u32 rmnet_ll_lat_bounds[RMNET_LL_LAT_BUCKETS - 1] = {
+	50, 100, 250, 500, 1000, 2000, 5000,
+};
 
 static struct rmnet_ll_stats rmnet_ll_stats;
+/* Set while this CPU is busy polling the channel */
+static DEFINE_PER_CPU(bool, rmnet_ll_polling);
+
+/* Busy poll window armed by every LL TX, 0 disables busy polling */
+static unsigned int rmnet_ll_busy_poll_usecs;
+static struct task_struct *rmnet_ll_poll_task;
+static DEFINE_MUTEX(rmnet_ll_poll_mutex);
+static DECLARE_WAIT_QUEUE_HEAD(rmnet_ll_poll_wq);
+/* ktime_get_ns() at which the current window closes */
+static u64 rmnet_ll_poll_end;
 /* For TX sync with DMA operations */
 DEFINE_SPINLOCK(rmnet_ll_tx_lock);
 
@@ -142,10 +162,155 @@ out:
 	return;
 }
 
+/* Hand an RX packet to the stack. Packets found by a busy poller skip the
+ * backlog and softirq and are processed right away in its context.
+ */
+void rmnet_ll_rx_deliver(struct sk_buff *skb)
+{
+	if (__this_cpu_read(rmnet_ll_polling)) {
+		rmnet_ll_stats.busy_poll_pkts++;
+		netif_receive_skb(skb);
+		return;
+	}
+
+	netif_rx(skb);
+}
+
+/* Account the time since rmnet_ll_send_skb() took a packet. The transport
+ * calls this when the packet leaves its hands: on TX completion for MHI,
+ * on handoff to the HW for IPA, which does not report completions.
+ */
+void rmnet_ll_tx_latency(ktime_t start)
+{
+	u64 usecs;
+	int i;
+
+	if (!start)
+		return;
+
+	usecs = ktime_us_delta(ktime_get(), start);
+	for (i = 0; i < ARRAY_SIZE(rmnet_ll_lat_bounds); i++)
+		if (usecs < rmnet_ll_lat_bounds[i])
+			break;
+
+	rmnet_ll_stats.tx_lat[i]++;
+}
+
+/* Poll the channel for RX completions until the window armed by the last
+ * TX closes. Returns the number of packets delivered.
+ */
+static int rmnet_ll_busy_poll(void)
+{
+	int work = 0;
+	int rc;
+
+	rmnet_ll_stats.busy_poll++;
+	do {
+		local_bh_disable();
+		__this_cpu_write(rmnet_ll_polling, true);
+		rc = rmnet_ll_client.poll(RMNET_LL_POLL_BUDGET);
+		__this_cpu_write(rmnet_ll_polling, false);
+		local_bh_enable();
+		if (rc < 0)
+			return work ? work : rc;
+
+		work += rc;
+		cpu_relax();
+	} while (ktime_get_ns() < READ_ONCE(rmnet_ll_poll_end) &&
+		 !need_resched());
+
+	return work;
+}
+
+static bool rmnet_ll_poll_armed(void)
+{
+	return kthread_should_stop() ||
+	       ktime_get_ns() < READ_ONCE(rmnet_ll_poll_end);
+}
+
+/* Sleeps until an LL TX arms a window, then polls for the response. The
+ * thread can be pinned next to the latency sensitive application.
+ */
+static int rmnet_ll_poll_thread(void *data)
+{
+	while (!kthread_should_stop()) {
+		wait_event_interruptible(rmnet_ll_poll_wq,
+					 rmnet_ll_poll_armed());
+		if (kthread_should_stop())
+			break;
+
+		/* Channel not up, wait for the next TX to try again */
+		if (rmnet_ll_busy_poll() < 0)
+			WRITE_ONCE(rmnet_ll_poll_end, 0);
+
+		cond_resched();
+	}
+
+	return 0;
+}
+
+static int rmnet_ll_busy_poll_set(const char *val,
+				  const struct kernel_param *kp)
+{
+	struct task_struct *task;
+	unsigned int usecs;
+	int rc;
+
+	rc = kstrtouint(val, 0, &usecs);
+	if (rc)
+		return rc;
+
+	if (usecs && !rmnet_ll_client.poll)
+		return -EOPNOTSUPP;
+
+	mutex_lock(&rmnet_ll_poll_mutex);
+	if (usecs && !rmnet_ll_poll_task) {
+		task = kthread_run(rmnet_ll_poll_thread, NULL, "rmnet_ll_poll");
+		if (IS_ERR(task)) {
+			rc = PTR_ERR(task);
+			goto out;
+		}
+
+		rmnet_ll_poll_task = task;
+	}
+
+	WRITE_ONCE(rmnet_ll_busy_poll_usecs, usecs);
+	if (!usecs && rmnet_ll_poll_task) {
+		kthread_stop(rmnet_ll_poll_task);
+		rmnet_ll_poll_task = NULL;
+	}
+
+out:
+	mutex_unlock(&rmnet_ll_poll_mutex);
+	return rc;
+}
+
+static const struct kernel_param_ops rmnet_ll_busy_poll_ops = {
+	.set = rmnet_ll_busy_poll_set,
+	.get = param_get_uint,
+};
+
+module_param_cb(rmnet_ll_busy_poll_usecs, &rmnet_ll_busy_poll_ops,
+		&rmnet_ll_busy_poll_usecs, 0644);
+MODULE_PARM_DESC(rmnet_ll_busy_poll_usecs,
+		 "Busy poll the LL channel for this long after each TX");
+
 int rmnet_ll_send_skb(struct sk_buff *skb)
 {
+	unsigned int usecs = READ_ONCE(rmnet_ll_busy_poll_usecs);
+	ktime_t now = ktime_get();
 	int rc;
 
+	/* Start of the TX latency measurement, see rmnet_ll_tx_latency().
+	 * skb->tstamp belongs to the stack, keep ours in the CB.
+	 */
+	RMNET_SKB_CB(skb)->ll_tx_start = now;
+	if (usecs) {
+		WRITE_ONCE(rmnet_ll_poll_end,
+			   ktime_to_ns(now) + (u64)usecs * NSEC_PER_USEC);
+		wake_up(&rmnet_ll_poll_wq);
+	}
+
 	spin_lock_bh(&rmnet_ll_tx_lock);
 	rc = rmnet_ll_client.tx(skb);
 	spin_unlock_bh(&rmnet_ll_tx_lock);
@@ -169,5 +334,13 @@ int rmnet_ll_init(void)
 
 void rmnet_ll_exit(void)
 {
+	mutex_lock(&rmnet_ll_poll_mutex);
+	WRITE_ONCE(rmnet_ll_busy_poll_usecs, 0);
+	if (rmnet_ll_poll_task) {
+		kthread_stop(rmnet_ll_poll_task);
+		rmnet_ll_poll_task = NULL;
+	}
+	mutex_unlock(&rmnet_ll_poll_mutex);
+
 	rmnet_ll_client.exit();
 }
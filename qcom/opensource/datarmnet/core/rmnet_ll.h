@@ -18,6 +18,9 @@
 
 #include <linux/skbuff.h>
 
+/* TX queue to completion latency buckets, upper bounds in usec */
+#define RMNET_LL_LAT_BUCKETS 8
+
 struct rmnet_ll_stats {
 		u64 tx_queue;
 		u64 tx_queue_err;
@@ -35,6 +38,9 @@ struct rmnet_ll_stats {
 		u64 tx_fc_queued;
 		u64 tx_fc_sent;
 		u64 tx_fc_err;
+		u64 busy_poll;
+		u64 busy_poll_pkts;
+		u64 tx_lat[RMNET_LL_LAT_BUCKETS];
 };
 
 int rmnet_ll_send_skb(struct sk_buff *skb);
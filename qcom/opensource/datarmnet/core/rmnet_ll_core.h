@@ -50,6 +50,8 @@ struct rmnet_ll_endpoint {
  * buffer_queue: Queue an allocated buffer to the HW for RX. Optional.
  * query_free_descriptors: Return number of free RX descriptors. Optional.
  * tx: Send an SKB over the channel in the TX direction.
+ * poll: Process up to budget RX completions from the calling context.
+ *	 Returns the number processed. Optional.
  * init: Initialization callback on module load
  * exit: Exit callback on module unload
  */
@@ -58,6 +60,7 @@ struct rmnet_ll_client_ops {
 			    struct rmnet_ll_buffer *ll_buf);
 	int (*query_free_descriptors)(struct rmnet_ll_endpoint *ll_ep);
 	int (*tx)(struct sk_buff *skb);
+	int (*poll)(int budget);
 	int (*init)(void);
 	int (*exit)(void);
 };
@@ -65,5 +68,7 @@ struct rmnet_ll_client_ops {
 int rmnet_ll_buffer_pool_alloc(struct rmnet_ll_endpoint *ll_ep);
 void rmnet_ll_buffer_pool_free(struct rmnet_ll_endpoint *ll_ep);
 void rmnet_ll_buffers_recycle(struct rmnet_ll_endpoint *ll_ep);
+void rmnet_ll_rx_deliver(struct sk_buff *skb);
+void rmnet_ll_tx_latency(ktime_t start);
 
 #endif
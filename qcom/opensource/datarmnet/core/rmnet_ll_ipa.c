@@ -23,6 +23,7 @@
 #include <linux/version.h>
 #include "rmnet_ll.h"
 #include "rmnet_ll_core.h"
+#include "rmnet_private.h"
 
 #define IPA_RMNET_LL_RECEIVE 1
 #define IPA_RMNET_LL_FLOW_EVT 2
@@ -46,21 +47,26 @@ static void rmnet_ll_ipa_tx_pending(struct tasklet_struct *t)
 {
 	struct rmnet_ll_stats *stats = rmnet_ll_get_stats();
 	struct sk_buff *skb;
+	ktime_t start;
 	int rc;
 
 	spin_lock_bh(&rmnet_ll_tx_lock);
 
 	while ((skb = __skb_dequeue(&tx_pending_list))) {
+		/* IPA owns the SKB once it takes it */
+		start = RMNET_SKB_CB(skb)->ll_tx_start;
 		rc = ipa_rmnet_ll_xmit(skb);
 		if (rc == -EAGAIN) {
 			stats->tx_disabled++;
 			__skb_queue_head(&tx_pending_list, skb);
 			break;
 		}
-		if (rc >= 0)
+		if (rc >= 0) {
 			stats->tx_fc_sent++;
-		else
+			rmnet_ll_tx_latency(start);
+		} else {
 			stats->tx_fc_err++;
+		}
 	}
 
 	spin_unlock_bh(&rmnet_ll_tx_lock);
@@ -97,7 +103,7 @@ static void rmnet_ll_ipa_rx(void *arg, void *rx_data)
 	}
 
 	stats->rx_pkts++;
-	netif_rx(skb);
+	rmnet_ll_rx_deliver(skb);
 }
 
 static void rmnet_ll_ipa_probe(void *arg)
@@ -153,6 +159,7 @@ static void rmnet_ll_ipa_ready(void * __unused)
 static int rmnet_ll_ipa_tx(struct sk_buff *skb)
 {
 	struct rmnet_ll_stats *stats = rmnet_ll_get_stats();
+	ktime_t start;
 	int rc;
 
 	if (!rmnet_ll_ipa_ep)
@@ -161,11 +168,14 @@ static int rmnet_ll_ipa_tx(struct sk_buff *skb)
 	if (!skb_queue_empty(&tx_pending_list))
 		goto queue_skb;
 
+	start = RMNET_SKB_CB(skb)->ll_tx_start;
 	rc = ipa_rmnet_ll_xmit(skb);
 
 	/* rc >=0: success, return number of free descriptors left */
-	if (rc >= 0)
+	if (rc >= 0) {
+		rmnet_ll_tx_latency(start);
 		return 0;
+	}
 
 	/* IPA handles freeing the SKB on failure */
 	if (rc != -EAGAIN)
@@ -21,6 +21,7 @@
 #include <linux/mm.h>
 #include "rmnet_ll.h"
 #include "rmnet_ll_core.h"
+#include "rmnet_private.h"
 
 static struct rmnet_ll_endpoint *rmnet_ll_mhi_ep;
 
@@ -68,7 +69,7 @@ static void rmnet_ll_mhi_rx(struct mhi_device *mhi_dev, struct mhi_result *res)
 	 */
 	skb->priority = 0xda1a;
 	stats->rx_pkts++;
-	netif_rx(skb);
+	rmnet_ll_rx_deliver(skb);
 	rmnet_ll_buffers_recycle(ll_ep);
 	return;
 
@@ -90,6 +91,7 @@ static void rmnet_ll_mhi_tx_complete(struct mhi_device *mhi_dev,
 	else
 		stats->tx_complete++;
 
+	rmnet_ll_tx_latency(RMNET_SKB_CB(skb)->ll_tx_start);
 	dev_kfree_skb_any(skb);
 }
 
@@ -217,6 +219,17 @@ static int rmnet_ll_mhi_tx(struct sk_buff *skb)
 	return rc;
 }
 
+static int rmnet_ll_mhi_poll(int budget)
+{
+	struct rmnet_ll_endpoint *ll_ep = rmnet_ll_mhi_ep;
+
+	if (!ll_ep)
+		return -ENODEV;
+
+	/* Completions are handed to rmnet_ll_mhi_rx() from here */
+	return mhi_poll(ll_ep->priv, budget);
+}
+
 static int rmnet_ll_mhi_init(void)
 {
 	return mhi_driver_register(&rmnet_ll_driver);
@@ -233,6 +246,7 @@ struct rmnet_ll_client_ops rmnet_ll_client = {
 	.buffer_queue = rmnet_ll_mhi_queue,
 	.query_free_descriptors = rmnet_ll_mhi_query_free_descriptors,
 	.tx = rmnet_ll_mhi_tx,
+	.poll = rmnet_ll_mhi_poll,
 	.init = rmnet_ll_mhi_init,
 	.exit = rmnet_ll_mhi_exit,
 };
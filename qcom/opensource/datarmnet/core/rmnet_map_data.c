@@ -1273,7 +1273,7 @@ static void rmnet_map_flush_tx_packet_work(struct work_struct *work)
 			skb = state->agg_skb;
 			state->agg_skb = NULL;
 			state->agg_count = 0;
-			memset(&state->agg_time, 0, sizeof(state->agg_time));
+			state->agg_time = 0;
 		}
 		state->agg_state = 0;
 	}
@@ -1326,6 +1326,105 @@ static void rmnet_map_linearize_copy(struct sk_buff *dst, struct sk_buff *src)
 	}
 }
 
+static bool rmnet_map_agg_chainable(struct rmnet_aggregation_state *state,
+				     struct rmnet_port *port,
+				     struct sk_buff *skb)
+{
+	/* Only worth it when there is paged data to reference, and only
+	 * if the transport can take a scatter-gather aggregate.
+	 */
+	return state->agg_chain_ok && skb_shinfo(skb)->nr_frags &&
+	       (port->dev->features & NETIF_F_SG) &&
+	       !skb_has_frag_list(skb) && !skb_zcopy(skb);
+}
+
+/* Appends src to the aggregate without copying its paged data. The linear
+ * part, which holds the MAP and IP headers, is copied into a small page
+ * fragment and the page fragments of src are referenced as is.
+ */
+static int rmnet_map_chain_frags(struct rmnet_aggregation_state *state,
+				 struct sk_buff *dst, struct sk_buff *src)
+{
+	struct skb_shared_info *dshinfo = skb_shinfo(dst);
+	struct skb_shared_info *sshinfo = skb_shinfo(src);
+	unsigned int linear = skb_headlen(src);
+	int i, nr = dshinfo->nr_frags;
+
+	if (nr + sshinfo->nr_frags + 1 > MAX_SKB_FRAGS)
+		return -ENOSPC;
+
+	if (linear) {
+		struct page *page;
+		void *va;
+
+		va = page_frag_alloc(&state->agg_hdr_cache, linear,
+				     GFP_ATOMIC);
+		if (!va)
+			return -ENOMEM;
+
+		memcpy(va, src->data, linear);
+		page = virt_to_head_page(va);
+		skb_fill_page_desc(dst, nr++, page,
+				   (u8 *)va - (u8 *)page_address(page),
+				   linear);
+	}
+
+	for (i = 0; i < sshinfo->nr_frags; i++) {
+		skb_frag_t *frag = &sshinfo->frags[i];
+
+		__skb_frag_ref(frag);
+		skb_fill_page_desc(dst, nr++, skb_frag_page(frag),
+				   skb_frag_off(frag), skb_frag_size(frag));
+	}
+
+	dst->len += src->len;
+	dst->data_len += src->len;
+	dst->truesize += src->len;
+	return 0;
+}
+
+static struct sk_buff *
+rmnet_map_chain_start(struct rmnet_aggregation_state *state,
+		      struct sk_buff *skb)
+{
+	struct skb_shared_info *sshinfo = skb_shinfo(skb);
+	unsigned int linear = skb_headlen(skb);
+	struct sk_buff *agg_skb;
+	int i;
+
+	/* The first packet's headers go in the linear area so that the
+	 * aggregate always starts with a MAP header in skb->data.
+	 */
+	agg_skb = alloc_skb(linear, GFP_ATOMIC);
+	if (!agg_skb)
+		return NULL;
+
+	skb_put_data(agg_skb, skb->data, linear);
+	for (i = 0; i < sshinfo->nr_frags; i++) {
+		skb_frag_t *frag = &sshinfo->frags[i];
+
+		__skb_frag_ref(frag);
+		skb_fill_page_desc(agg_skb, i, skb_frag_page(frag),
+				   skb_frag_off(frag), skb_frag_size(frag));
+	}
+
+	agg_skb->len += skb->data_len;
+	agg_skb->data_len += skb->data_len;
+	agg_skb->truesize += skb->data_len;
+	return agg_skb;
+}
+
+static void rmnet_map_drain_hdr_cache(struct rmnet_aggregation_state *state)
+{
+	struct page_frag_cache *nc = &state->agg_hdr_cache;
+
+	if (!nc->va)
+		return;
+
+	__page_frag_cache_drain(virt_to_head_page(nc->va), nc->pagecnt_bias);
+	nc->va = NULL;
+}
+
 static void rmnet_free_agg_pages(struct rmnet_aggregation_state *state)
 {
 	struct rmnet_agg_page *agg_page, *idx;
@@ -1450,7 +1549,7 @@ void rmnet_map_send_agg_skb(struct rmnet_aggregation_state *state)
 	/* Reset the aggregation state */
 	state->agg_skb = NULL;
 	state->agg_count = 0;
-	memset(&state->agg_time, 0, sizeof(state->agg_time));
+	state->agg_time = 0;
 	state->agg_state = 0;
 	state->send_agg_skb(agg_skb);
 	spin_unlock_bh(&state->agg_lock);
@@ -1461,16 +1560,24 @@ void rmnet_map_tx_aggregate(struct sk_buff *skb, struct rmnet_port *port,
 			    bool low_latency)
 {
 	struct rmnet_aggregation_state *state;
-	struct timespec64 diff, last;
+	ktime_t now, last;
+	bool chain;
 	int size;
 
 	state = &port->agg_state[(low_latency) ? RMNET_LL_AGG_STATE :
 						 RMNET_DEFAULT_AGG_STATE];
 
+	/* A single monotonic read per packet, taken outside of the lock.
+	 * It may be slightly older than agg_last if another CPU got the
+	 * lock first, which just makes the deltas below negative.
+	 */
+	now = ktime_get();
+	chain = rmnet_map_agg_chainable(state, port, skb);
+
 new_packet:
 	spin_lock_bh(&state->agg_lock);
-	memcpy(&last, &state->agg_last, sizeof(last));
-	ktime_get_real_ts64(&state->agg_last);
+	last = state->agg_last;
+	state->agg_last = now;
 
 	if ((port->data_format & RMNET_EGRESS_FORMAT_PRIORITY) &&
 	    (RMNET_LLM(skb->priority) || RMNET_APS_LLB(skb->priority))) {
@@ -1486,10 +1593,9 @@ new_packet:
 		/* Check to see if we should agg first. If the traffic is very
 		 * sparse, don't aggregate. We will need to tune this later
 		 */
-		diff = timespec64_sub(state->agg_last, last);
 		size = state->params.agg_size - skb->len;
 
-		if (diff.tv_sec > 0 || diff.tv_nsec > rmnet_agg_bypass_time ||
+		if (ktime_sub(now, last) > rmnet_agg_bypass_time ||
 		    size <= 0) {
 			skb->protocol = htons(ETH_P_MAP);
 			state->send_agg_skb(skb);
@@ -1497,38 +1603,54 @@ new_packet:
 			return;
 		}
 
-		state->agg_skb = rmnet_map_build_skb(state);
+		if (chain)
+			state->agg_skb = rmnet_map_chain_start(state, skb);
+		else
+			state->agg_skb = rmnet_map_build_skb(state);
+
 		if (!state->agg_skb) {
 			state->agg_skb = NULL;
 			state->agg_count = 0;
-			memset(&state->agg_time, 0, sizeof(state->agg_time));
+			state->agg_time = 0;
 			skb->protocol = htons(ETH_P_MAP);
 			state->send_agg_skb(skb);
 			spin_unlock_bh(&state->agg_lock);
 			return;
 		}
 
-		rmnet_map_linearize_copy(state->agg_skb, skb);
+		if (chain)
+			state->stats->ul_agg_chain++;
+		else
+			rmnet_map_linearize_copy(state->agg_skb, skb);
+
+		state->agg_chain = chain;
 		state->agg_skb->dev = skb->dev;
 		state->agg_skb->protocol = htons(ETH_P_MAP);
 		state->agg_count = 1;
-		ktime_get_real_ts64(&state->agg_time);
-		dev_kfree_skb_any(skb);
+		state->agg_time = now;
 		goto schedule;
 	}
-	diff = timespec64_sub(state->agg_last, state->agg_time);
-	size = skb_tailroom(state->agg_skb);
+
+	if (state->agg_chain)
+		size = state->params.agg_size - state->agg_skb->len;
+	else
+		size = skb_tailroom(state->agg_skb);
 
 	if (skb->len > size ||
 	    state->agg_count >= state->params.agg_count ||
-	    diff.tv_sec > 0 || diff.tv_nsec > rmnet_agg_time_limit) {
-		rmnet_map_send_agg_skb(state);
-		goto new_packet;
+	    ktime_sub(now, state->agg_time) > rmnet_agg_time_limit)
+		goto flush;
+
+	if (state->agg_chain) {
+		/* Out of fragment slots, or a packet we can't reference */
+		if (skb_has_frag_list(skb) || skb_zcopy(skb) ||
+		    rmnet_map_chain_frags(state, state->agg_skb, skb))
+			goto flush;
+	} else {
+		rmnet_map_linearize_copy(state->agg_skb, skb);
 	}
 
-	rmnet_map_linearize_copy(state->agg_skb, skb);
 	state->agg_count++;
-	dev_kfree_skb_any(skb);
 
 schedule:
 	if (state->agg_state != -EINPROGRESS) {
@@ -1538,6 +1660,14 @@ schedule:
 			      HRTIMER_MODE_REL);
 	}
 	spin_unlock_bh(&state->agg_lock);
+
+	/* The aggregate holds its own references to any pages of skb */
+	dev_kfree_skb_any(skb);
+	return;
+
+flush:
+	rmnet_map_send_agg_skb(state);
+	goto new_packet;
 }
 
 void rmnet_map_update_ul_agg_config(struct rmnet_aggregation_state *state,
@@ -1585,6 +1715,7 @@ void rmnet_map_tx_aggregate_init(struct rmnet_port *port)
 		state->hrtimer.function = rmnet_map_flush_tx_packet_queue;
 		INIT_WORK(&state->agg_wq, rmnet_map_flush_tx_packet_work);
 		state->stats = &port->stats.agg;
+		state->agg_chain_ok = (i == RMNET_DEFAULT_AGG_STATE);
 
 		/* Since PAGE_SIZE - 1 is specified here, no pages are
 		 * pre-allocated. This is done to reduce memory usage in cases
@@ -1620,14 +1751,14 @@ void rmnet_map_tx_aggregate_exit(struct rmnet_port *port)
 				kfree_skb(state->agg_skb);
 				state->agg_skb = NULL;
 				state->agg_count = 0;
-				memset(&state->agg_time, 0,
-				       sizeof(state->agg_time));
+				state->agg_time = 0;
 			}
 
 			state->agg_state = 0;
 		}
 
 		rmnet_free_agg_pages(state);
+		rmnet_map_drain_hdr_cache(state);
 		spin_unlock_bh(&state->agg_lock);
 	}
 }
@@ -1659,7 +1790,7 @@ void rmnet_map_tx_qmap_cmd(struct sk_buff *qmap_skb, u8 ch, bool flush)
 		agg_skb = state->agg_skb;
 		state->agg_skb = NULL;
 		state->agg_count = 0;
-		memset(&state->agg_time, 0, sizeof(state->agg_time));
+		state->agg_time = 0;
 		state->agg_state = 0;
 		state->send_agg_skb(agg_skb);
 		spin_unlock_bh(&state->agg_lock);
@@ -14,6 +14,7 @@
 #define _RMNET_PRIVATE_H_
 
 #include <linux/types.h>
+#include <linux/ktime.h>
 
 #define RMNET_MAX_PACKET_SIZE      16384
 #define RMNET_DFLT_PACKET_SIZE     1500
@@ -56,6 +57,9 @@ struct rmnet_skb_cb {
 	/* coalescing stats */
 	u32 coal_bytes;
 	u32 coal_bufsize;
+
+	/* LL TX queue time */
+	ktime_t ll_tx_start;
 };
 
 #define RMNET_SKB_CB(skb) ((struct rmnet_skb_cb *)(skb)->cb)
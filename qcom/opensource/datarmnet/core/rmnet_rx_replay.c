@@ -0,0 +1,260 @@
+/* Copyright (c) 2026 Qualcomm Innovation Center, Inc. All rights reserved.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 and
+ * only version 2 as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * RMNET ingress replay
+ *
+ * Feeds recorded MAP frames through rmnet_rx_handler() on an idle raw IP
+ * real device (e.g. a tun device) and checks the rx-profile counters
+ * against what each frame must deliver. Trigger with
+ *   echo <real_dev> > /sys/module/rmnet_core/parameters/rmnet_rx_replay
+ * with at least one rmnet device on top and rmnet_shs/rmnet_perf unloaded,
+ * since those hold packets past the end of the run.
+ */
+
+#include <linux/module.h>
+#include <linux/netdevice.h>
+#include <linux/skbuff.h>
+#include <linux/if_arp.h>
+#include <linux/hashtable.h>
+#include <linux/rtnetlink.h>
+#include "rmnet_config.h"
+#include "rmnet_handlers.h"
+#include "rmnet_private.h"
+#include "rmnet_map.h"
+#include "rmnet_descriptor.h"
+
+#define RMNET_RX_REPLAY_ITERS 1000
+
+/* IPv4/UDP 192.0.2.1:4000 -> 192.0.2.2:4001, 4 bytes of payload */
+#define RMNET_RX_REPLAY_PKT \
+	0x45, 0x00, 0x00, 0x20, 0x00, 0x01, 0x00, 0x00, \
+	0x40, 0x11, 0xf6, 0xc8, 0xc0, 0x00, 0x02, 0x01, \
+	0xc0, 0x00, 0x02, 0x02, 0x0f, 0xa0, 0x0f, 0xa1, \
+	0x00, 0x0c, 0x00, 0x00, 0x72, 0x6d, 0x6e, 0x74
+
+/* MAPv1 aggregate of two packets. Byte 1 of each QMAP header is the mux ID
+ * and is rewritten to match the endpoint under test.
+ */
+static const u8 rmnet_rx_replay_mapv1[] = {
+	0x00, 0x00, 0x00, 0x20, RMNET_RX_REPLAY_PKT,
+	0x00, 0x00, 0x00, 0x20, RMNET_RX_REPLAY_PKT,
+};
+
+/* MAPv4: every packet is followed by a DL checksum trailer the hardware
+ * did not validate.
+ */
+static const u8 rmnet_rx_replay_mapv4[] = {
+	0x00, 0x00, 0x00, 0x20, RMNET_RX_REPLAY_PKT,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x20, RMNET_RX_REPLAY_PKT,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+};
+
+/* MAPv5: next header bit set, followed by a checksum offload header with
+ * csum_valid_required set.
+ */
+static const u8 rmnet_rx_replay_mapv5[] = {
+	0x40, 0x00, 0x00, 0x20, 0x04, 0x80, 0x00, 0x00, RMNET_RX_REPLAY_PKT,
+	0x40, 0x00, 0x00, 0x20, 0x04, 0x80, 0x00, 0x00, RMNET_RX_REPLAY_PKT,
+};
+
+struct rmnet_rx_replay_case {
+	const char *name;
+	const u8 *frame;
+	u32 len;
+	u32 stride;
+	u32 pkts;
+	u32 data_format;
+	bool frags;
+};
+
+static const struct rmnet_rx_replay_case rmnet_rx_replay_cases[] = {
+	{
+		.name = "mapv1 skb",
+		.frame = rmnet_rx_replay_mapv1,
+		.len = sizeof(rmnet_rx_replay_mapv1),
+		.stride = sizeof(rmnet_rx_replay_mapv1) / 2,
+		.pkts = 2,
+		.data_format = RMNET_FLAGS_INGRESS_DEAGGREGATION,
+	},
+	{
+		.name = "mapv4 skb csum",
+		.frame = rmnet_rx_replay_mapv4,
+		.len = sizeof(rmnet_rx_replay_mapv4),
+		.stride = sizeof(rmnet_rx_replay_mapv4) / 2,
+		.pkts = 2,
+		.data_format = RMNET_FLAGS_INGRESS_DEAGGREGATION |
+			       RMNET_FLAGS_INGRESS_MAP_CKSUMV4,
+	},
+	{
+		.name = "mapv5 desc csum",
+		.frame = rmnet_rx_replay_mapv5,
+		.len = sizeof(rmnet_rx_replay_mapv5),
+		.stride = sizeof(rmnet_rx_replay_mapv5) / 2,
+		.pkts = 2,
+		.data_format = RMNET_FLAGS_INGRESS_DEAGGREGATION |
+			       RMNET_PRIV_FLAGS_INGRESS_MAP_CKSUMV5,
+		.frags = true,
+	},
+};
+
+static struct sk_buff *
+rmnet_rx_replay_build(struct net_device *real_dev, const u8 *frame, u32 len,
+		      bool frags)
+{
+	struct sk_buff *skb;
+	struct page *page;
+
+	if (!frags) {
+		skb = netdev_alloc_skb(real_dev, len);
+		if (!skb)
+			return NULL;
+
+		skb_put_data(skb, frame, len);
+		goto out;
+	}
+
+	page = dev_alloc_page();
+	if (!page)
+		return NULL;
+
+	skb = netdev_alloc_skb(real_dev, 0);
+	if (!skb) {
+		put_page(page);
+		return NULL;
+	}
+
+	memcpy(page_address(page), frame, len);
+	skb_add_rx_frag(skb, 0, page, 0, len, PAGE_SIZE);
+
+out:
+	skb->dev = real_dev;
+	skb->protocol = htons(ETH_P_MAP);
+	return skb;
+}
+
+static int rmnet_rx_replay_run(struct net_device *real_dev,
+			       struct rmnet_port *port, u8 mux_id,
+			       const struct rmnet_rx_replay_case *tc)
+{
+	struct rmnet_rx_prof_stats *prof = &port->stats.rx_prof;
+	struct rmnet_desc_pool_stats pool_start, pool_end;
+	u8 frame[sizeof(rmnet_rx_replay_mapv4)];
+	u64 allocs;
+	u32 off;
+	int i;
+
+	if (tc->len > sizeof(frame))
+		return -EINVAL;
+
+	memcpy(frame, tc->frame, tc->len);
+	for (off = 0; off < tc->len; off += tc->stride)
+		frame[off + 1] = mux_id;
+
+	port->data_format = tc->data_format;
+	memset(prof, 0, sizeof(*prof));
+	rmnet_descriptor_get_pool_stats(port, &pool_start);
+	WRITE_ONCE(port->rx_prof, true);
+
+	for (i = 0; i < RMNET_RX_REPLAY_ITERS; i++) {
+		struct sk_buff *skb;
+
+		skb = rmnet_rx_replay_build(real_dev, frame, tc->len,
+					    tc->frags);
+		if (!skb)
+			break;
+
+		local_bh_disable();
+		rcu_read_lock();
+		rmnet_rx_handler(&skb);
+		rcu_read_unlock();
+		local_bh_enable();
+	}
+
+	WRITE_ONCE(port->rx_prof, false);
+	rmnet_descriptor_get_pool_stats(port, &pool_end);
+	allocs = (pool_end.desc_miss - pool_start.desc_miss) +
+		 (pool_end.frag_miss - pool_start.frag_miss);
+
+	pr_info("%s(): %s: %llu frames %llu pkts %llu ns/pkt max %llu ns, %llu pool misses\n",
+		__func__, tc->name, prof->frames, prof->pkts,
+		prof->pkts ? div64_u64(prof->time_ns, prof->pkts) : 0,
+		prof->max_ns, allocs);
+
+	if (prof->frames != RMNET_RX_REPLAY_ITERS ||
+	    prof->bytes != (u64)RMNET_RX_REPLAY_ITERS * tc->len ||
+	    prof->pkts != (u64)RMNET_RX_REPLAY_ITERS * tc->pkts) {
+		pr_err("%s(): %s: expected %u frames %llu bytes %llu pkts, got %llu %llu %llu\n",
+		       __func__, tc->name, RMNET_RX_REPLAY_ITERS,
+		       (u64)RMNET_RX_REPLAY_ITERS * tc->len,
+		       (u64)RMNET_RX_REPLAY_ITERS * tc->pkts,
+		       prof->frames, prof->bytes, prof->pkts);
+		return -EIO;
+	}
+
+	return 0;
+}
+
+static int rmnet_rx_replay_set(const char *val, const struct kernel_param *kp)
+{
+	char name[IFNAMSIZ];
+	struct net_device *real_dev;
+	struct rmnet_endpoint *ep = NULL;
+	struct rmnet_port *port;
+	u32 data_format;
+	int bkt, i, rc = 0;
+
+	strscpy(name, val, sizeof(name));
+	strim(name);
+
+	rtnl_lock();
+	real_dev = __dev_get_by_name(&init_net, name);
+	port = real_dev ? rmnet_get_port(real_dev) : NULL;
+	if (!port || port->rmnet_mode != RMNET_EPMODE_VND) {
+		rc = -ENODEV;
+		goto out;
+	}
+
+	/* rmnet_map_ingress_handler() pushes an Ethernet header back on
+	 * ARPHRD_ETHER devices, which the fixtures do not carry.
+	 */
+	if (real_dev->type == ARPHRD_ETHER) {
+		rc = -EOPNOTSUPP;
+		goto out;
+	}
+
+	hash_for_each(port->muxed_ep, bkt, ep, hlnode)
+		break;
+
+	if (!ep) {
+		rc = -ENOENT;
+		goto out;
+	}
+
+	data_format = port->data_format;
+	for (i = 0; i < ARRAY_SIZE(rmnet_rx_replay_cases) && !rc; i++)
+		rc = rmnet_rx_replay_run(real_dev, port, ep->mux_id,
+					 &rmnet_rx_replay_cases[i]);
+
+	port->data_format = data_format;
+
+out:
+	rtnl_unlock();
+	return rc;
+}
+
+static const struct kernel_param_ops rmnet_rx_replay_ops = {
+	.set = rmnet_rx_replay_set,
+};
+
+module_param_cb(rmnet_rx_replay, &rmnet_rx_replay_ops, NULL, 0200);
+MODULE_PARM_DESC(rmnet_rx_replay,
+		 "Replay recorded MAP frames on this real device and check the RX profile counters");
@@ -34,6 +34,7 @@
 #include "rmnet_genl.h"
 #include "rmnet_ll.h"
 #include "rmnet_ctl.h"
+#include "rmnet_descriptor.h"
 
 #include "qmi_rmnet.h"
 #include "rmnet_qmi.h"
@@ -561,6 +562,7 @@ static const char rmnet_port_gstrings_stats[][ETH_GSTRING_LEN] = {
 	"DL trailer pkts received",
 	"UL agg reuse",
 	"UL agg alloc",
+	"UL agg chained",
 	"DL chaining [0-10)",
 	"DL chaining [10-20)",
 	"DL chaining [20-30)",
@@ -574,6 +576,20 @@ static const char rmnet_port_gstrings_stats[][ETH_GSTRING_LEN] = {
 	"DL chaining frags [8-11]",
 	"DL chaining frags [12-15]",
 	"DL chaining frags = 16",
+	"Desc pool size",
+	"Desc pool shared free",
+	"Desc pool per-CPU free",
+	"Desc pool misses",
+	"Frag pool size",
+	"Frag pool shared free",
+	"Frag pool per-CPU free",
+	"Frag pool misses",
+	"Frag inline used",
+	"RX prof frames",
+	"RX prof bytes",
+	"RX prof pkts",
+	"RX prof time ns",
+	"RX prof max frame ns",
 };
 
 static const char rmnet_ll_gstrings_stats[][ETH_GSTRING_LEN] = {
@@ -593,6 +609,16 @@ static const char rmnet_ll_gstrings_stats[][ETH_GSTRING_LEN] = {
 	"LL TX FC queued",
 	"LL TX FC sent",
 	"LL TX FC err",
+	"LL busy poll calls",
+	"LL busy poll RX packets",
+	"LL TX latency [0-50us)",
+	"LL TX latency [50-100us)",
+	"LL TX latency [100-250us)",
+	"LL TX latency [250-500us)",
+	"LL TX latency [500us-1ms)",
+	"LL TX latency [1-2ms)",
+	"LL TX latency [2-5ms)",
+	"LL TX latency >= 5ms",
 };
 
 static const char rmnet_qmap_gstrings_stats[][ETH_GSTRING_LEN] = {
@@ -603,11 +629,21 @@ static const char rmnet_qmap_gstrings_stats[][ETH_GSTRING_LEN] = {
 	"QMAP TX complete (MHI)",
 };
 
+#define RMNET_PRIV_FLAG_RX_PROF BIT(0)
+
+static const char rmnet_priv_flags_strings[][ETH_GSTRING_LEN] = {
+	"rx-profile",
+};
+
 static void rmnet_get_strings(struct net_device *dev, u32 stringset, u8 *buf)
 {
 	size_t off = 0;
 
 	switch (stringset) {
+	case ETH_SS_PRIV_FLAGS:
+		memcpy(buf, &rmnet_priv_flags_strings,
+		       sizeof(rmnet_priv_flags_strings));
+		break;
 	case ETH_SS_STATS:
 		memcpy(buf, &rmnet_gstrings_stats,
 		       sizeof(rmnet_gstrings_stats));
@@ -633,6 +669,8 @@ static int rmnet_get_sset_count(struct net_device *dev, int sset)
 		       ARRAY_SIZE(rmnet_port_gstrings_stats) +
 		       ARRAY_SIZE(rmnet_ll_gstrings_stats) +
 		       ARRAY_SIZE(rmnet_qmap_gstrings_stats);
+	case ETH_SS_PRIV_FLAGS:
+		return ARRAY_SIZE(rmnet_priv_flags_strings);
 	default:
 		return -EOPNOTSUPP;
 	}
@@ -656,6 +694,7 @@ static void rmnet_get_ethtool_stats(struct net_device *dev,
 
 	stp = &port->stats;
 	llp = rmnet_ll_get_stats();
+	rmnet_descriptor_get_pool_stats(port, &stp->desc_pool);
 
 	memcpy(data, st, ARRAY_SIZE(rmnet_gstrings_stats) * sizeof(u64));
 	off += ARRAY_SIZE(rmnet_gstrings_stats);
@@ -686,6 +725,7 @@ static int rmnet_stats_reset(struct net_device *dev)
 	stp = &port->stats;
 
 	memset(stp, 0, sizeof(*stp));
+	rmnet_descriptor_reset_pool_stats(port);
 
 	st = &priv->stats;
 
@@ -694,11 +734,44 @@ static int rmnet_stats_reset(struct net_device *dev)
 	return 0;
 }
 
+static u32 rmnet_get_priv_flags(struct net_device *dev)
+{
+	struct rmnet_priv *priv = netdev_priv(dev);
+	struct rmnet_port *port;
+	u32 flags = 0;
+
+	port = rmnet_get_port(priv->real_dev);
+	if (port && port->rx_prof)
+		flags |= RMNET_PRIV_FLAG_RX_PROF;
+
+	return flags;
+}
+
+static int rmnet_set_priv_flags(struct net_device *dev, u32 flags)
+{
+	struct rmnet_priv *priv = netdev_priv(dev);
+	struct rmnet_port *port;
+	bool rx_prof = !!(flags & RMNET_PRIV_FLAG_RX_PROF);
+
+	port = rmnet_get_port(priv->real_dev);
+	if (!port)
+		return -EINVAL;
+
+	/* Start every profiling run from a clean slate */
+	if (rx_prof && !port->rx_prof)
+		memset(&port->stats.rx_prof, 0, sizeof(port->stats.rx_prof));
+
+	WRITE_ONCE(port->rx_prof, rx_prof);
+	return 0;
+}
+
 static const struct ethtool_ops rmnet_ethtool_ops = {
 	.get_ethtool_stats = rmnet_get_ethtool_stats,
 	.get_strings = rmnet_get_strings,
 	.get_sset_count = rmnet_get_sset_count,
 	.nway_reset = rmnet_stats_reset,
+	.get_priv_flags = rmnet_get_priv_flags,
+	.set_priv_flags = rmnet_set_priv_flags,
 };
 
 /* Called by kernel whenever a new rmnet<n> device is created. Sets MTU,
@@ -145,6 +145,29 @@ dp_rx_set_msdu_lmac_id(qdf_nbuf_t nbuf, uint32_t peer_mdata)
 }
 #endif
 
+/**
+ * dp_rx_sg_create_be() - Assemble an MSDU spread across multiple nbufs
+ * @soc: DP SOC handle
+ * @vdev: DP vdev the MSDU is received on
+ * @nbuf: first nbuf of the MSDU
+ *
+ * Continuation nbufs are attached as page frags when enabled and the
+ * frame goes up as 802.3. Raw and native wifi decap consumers walk the
+ * frag_list of the MSDU, so they keep the frag_list layout.
+ *
+ * Return: head nbuf of the MSDU
+ */
+static inline qdf_nbuf_t
+dp_rx_sg_create_be(struct dp_soc *soc, struct dp_vdev *vdev, qdf_nbuf_t nbuf)
+{
+	if (wlan_cfg_is_rx_sg_page_frag_enabled(soc->wlan_cfg_ctx) &&
+	    vdev->rx_decap_type == htt_cmn_pkt_type_ethernet &&
+	    !qdf_nbuf_is_raw_frame(nbuf))
+		return dp_rx_sg_create_page_frag(soc, nbuf);
+
+	return dp_rx_sg_create(soc, nbuf);
+}
+
 /**
  * dp_rx_process_be() - Brain of the Rx processing functionality
  *		     Called from the bottom half (tasklet/NET_RX_SOFTIRQ)
@@ -163,10 +186,8 @@ uint32_t dp_rx_process_be(struct dp_intr *int_ctx,
 			  uint32_t quota)
 {
 	hal_ring_desc_t ring_desc;
-	hal_ring_desc_t last_prefetched_hw_desc;
 	hal_soc_handle_t hal_soc;
 	struct dp_rx_desc *rx_desc = NULL;
-	struct dp_rx_desc *last_prefetched_sw_desc = NULL;
 	qdf_nbuf_t nbuf, next;
 	bool near_full;
 	union dp_rx_desc_list_elem_t *head[WLAN_MAX_MLO_CHIPS][MAX_PDEV_CNT];
@@ -218,6 +239,7 @@ uint32_t dp_rx_process_be(struct dp_intr *int_ctx,
 	uint32_t old_tid;
 	uint32_t peer_ext_stats;
 	uint32_t dsf;
+	uint32_t prefetch_depth;
 
 	DP_HIST_INIT();
 
@@ -228,6 +250,7 @@ uint32_t dp_rx_process_be(struct dp_intr *int_ctx,
 	scn = soc->hif_handle;
 	intr_id = int_ctx->dp_intr_id;
 	num_entries = hal_srng_get_num_entries(hal_soc, hal_ring_hdl);
+	prefetch_depth = wlan_cfg_get_rx_prefetch_depth(soc->wlan_cfg_ctx);
 	dp_runtime_pm_mark_last_busy(soc);
 
 more_data:
@@ -281,9 +304,8 @@ more_data:
 		num_pending = quota;
 
 	dp_srng_dst_inv_cached_descs(soc, hal_ring_hdl, num_pending);
-	last_prefetched_hw_desc = dp_srng_dst_prefetch_32_byte_desc(hal_soc,
-							    hal_ring_hdl,
-							    num_pending);
+	dp_rx_prefetch_hw_sw_nbuf_desc_prime_be(soc, hal_soc, hal_ring_hdl,
+						prefetch_depth, num_pending);
 	/*
 	 * start reaping the buffers from reo ring and queue
 	 * them in per vdev queue.
@@ -503,11 +525,8 @@ more_data:
 			 &tail[rx_desc->chip_id][rx_desc->pool_id], rx_desc);
 		num_rx_bufs_reaped++;
 
-		dp_rx_prefetch_hw_sw_nbuf_32_byte_desc(soc, hal_soc,
-					       num_pending,
-					       hal_ring_hdl,
-					       &last_prefetched_hw_desc,
-					       &last_prefetched_sw_desc);
+		dp_rx_prefetch_hw_sw_nbuf_desc_be(soc, hal_soc, hal_ring_hdl,
+						  prefetch_depth, num_pending);
 
 		/*
 		 * only if complete msdu is received for scatter case,
@@ -715,7 +734,7 @@ done:
 			qdf_nbuf_pull_head(nbuf, soc->rx_pkt_tlv_size);
 		} else if (qdf_nbuf_is_rx_chfrag_cont(nbuf)) {
 			msdu_len = QDF_NBUF_CB_RX_PKT_LEN(nbuf);
-			nbuf = dp_rx_sg_create(soc, nbuf);
+			nbuf = dp_rx_sg_create_be(soc, vdev, nbuf);
 			next = nbuf->next;
 
 			if (qdf_nbuf_is_raw_frame(nbuf)) {
@@ -878,9 +897,9 @@ done:
 				  deliver_list_tail,
 				  nbuf);
 
-		DP_PEER_TO_STACK_INCC_PKT(txrx_peer, 1,
-					  QDF_NBUF_CB_RX_PKT_LEN(nbuf),
-					  enh_flag);
+		DP_PEER_TO_STACK_RING_INCC_PKT(txrx_peer, reo_ring_num, 1,
+					       QDF_NBUF_CB_RX_PKT_LEN(nbuf),
+					       enh_flag);
 		if (qdf_unlikely(txrx_peer->in_twt))
 			DP_PEER_PER_PKT_STATS_INC_PKT(txrx_peer,
 						      rx.to_stack_twt, 1,
@@ -424,70 +424,113 @@ void dp_rx_prefetch_nbuf_data_be(qdf_nbuf_t nbuf, qdf_nbuf_t next)
 #endif
 
 #ifdef QCA_DP_RX_HW_SW_NBUF_DESC_PREFETCH
+/* Ring desc, SW Rx desc and nbuf are each fetched by their own stage */
+#define DP_RX_PREFETCH_STAGES 3
+
 /**
- * dp_rx_cookie_2_va_rxdma_buf_prefetch() - function to prefetch the SW desc
+ * dp_rx_prefetch_hw_sw_nbuf_desc_be() - Run one step of the REO ring
+ *					 prefetch pipeline
  * @soc: Handle to DP Soc structure
- * @cookie: cookie used to lookup virtual address
+ * @hal_soc: Handle to HAL Soc structure
+ * @hal_ring_hdl: Destination ring pointer
+ * @depth: distance, in ring entries, of the first stage from the TP
+ * @num_pending: number of entries left to reap in this loop
+ *
+ * Called once per reaped entry, with the TP at the next entry to reap.
+ * The entry @depth slots ahead has its ring desc prefetched; by the time
+ * it is @depth / DP_RX_PREFETCH_STAGES slots closer its ring desc is in
+ * cache and the SW Rx desc it points at is prefetched, and one more such
+ * distance later the nbuf is prefetched from the cached SW Rx desc. The
+ * three misses of an entry are thereby overlapped with the processing of
+ * the entries ahead of it instead of being taken back to back.
+ *
+ * nbuf->data is not prefetched here: the buffer is invalidated on unmap,
+ * so the TLVs are prefetched in the delivery loop instead.
  *
- * Return: prefetched Rx descriptor virtual address
+ * Return: None
  */
-static inline
-void *dp_rx_va_prefetch(void *last_prefetched_hw_desc)
+static inline void
+dp_rx_prefetch_hw_sw_nbuf_desc_be(struct dp_soc *soc,
+				  hal_soc_handle_t hal_soc,
+				  hal_ring_handle_t hal_ring_hdl,
+				  uint32_t depth, uint32_t num_pending)
 {
-	void *prefetch_desc;
+	uint32_t step = depth / DP_RX_PREFETCH_STAGES;
+	hal_ring_desc_t ring_desc;
+	struct dp_rx_desc *rx_desc;
+	qdf_nbuf_t nbuf;
+
+	if (depth < num_pending) {
+		ring_desc = hal_srng_dst_get_ahead(hal_soc, hal_ring_hdl,
+						   depth);
+		qdf_prefetch(ring_desc);
+	}
+
+	depth -= step;
+	if (depth < num_pending) {
+		ring_desc = hal_srng_dst_get_ahead(hal_soc, hal_ring_hdl,
+						   depth);
+		qdf_prefetch((void *)hal_rx_get_reo_desc_va(ring_desc));
+	}
 
-	prefetch_desc = (void *)hal_rx_get_reo_desc_va(last_prefetched_hw_desc);
-	qdf_prefetch(prefetch_desc);
-	return prefetch_desc;
+	depth -= step;
+	if (depth < num_pending) {
+		ring_desc = hal_srng_dst_get_ahead(hal_soc, hal_ring_hdl,
+						   depth);
+		rx_desc = (struct dp_rx_desc *)
+				hal_rx_get_reo_desc_va(ring_desc);
+		/* VA is not filled when HW cookie conversion failed */
+		if (qdf_unlikely(!rx_desc))
+			return;
+
+		nbuf = rx_desc->nbuf;
+		qdf_prefetch((uint8_t *)nbuf);
+		qdf_prefetch((uint8_t *)nbuf + 64);
+	}
 }
 
 /**
- * dp_rx_prefetch_hw_sw_nbuf_desc() - function to prefetch HW and SW desc
- * @soc: Handle to HAL Soc structure
- * @num_entries: valid number of HW descriptors
+ * dp_rx_prefetch_hw_sw_nbuf_desc_prime_be() - Fill the REO ring prefetch
+ *					       pipeline
+ * @soc: Handle to DP Soc structure
+ * @hal_soc: Handle to HAL Soc structure
  * @hal_ring_hdl: Destination ring pointer
- * @last_prefetched_hw_desc: pointer to the last prefetched HW descriptor
- * @last_prefetched_sw_desc: input & output param of last prefetch SW desc
+ * @depth: distance, in ring entries, of the first stage from the TP
+ * @num_pending: number of entries to reap in this loop
+ *
+ * Prefetches the ring descs the later stages will look at before the
+ * pipeline has reached them on its own.
  *
  * Return: None
  */
 static inline void
-dp_rx_prefetch_hw_sw_nbuf_32_byte_desc(struct dp_soc *soc,
-			       hal_soc_handle_t hal_soc,
-			       uint32_t num_entries,
-			       hal_ring_handle_t hal_ring_hdl,
-			       hal_ring_desc_t *last_prefetched_hw_desc,
-			       struct dp_rx_desc **last_prefetched_sw_desc)
+dp_rx_prefetch_hw_sw_nbuf_desc_prime_be(struct dp_soc *soc,
+					hal_soc_handle_t hal_soc,
+					hal_ring_handle_t hal_ring_hdl,
+					uint32_t depth, uint32_t num_pending)
 {
-	if (*last_prefetched_sw_desc) {
-		qdf_prefetch((uint8_t *)(*last_prefetched_sw_desc)->nbuf);
-		qdf_prefetch((uint8_t *)(*last_prefetched_sw_desc)->nbuf + 64);
-	}
+	uint32_t i;
 
-	if (num_entries) {
-		*last_prefetched_sw_desc =
-			dp_rx_va_prefetch(*last_prefetched_hw_desc);
-
-		if ((uintptr_t)*last_prefetched_hw_desc & 0x3f)
-			*last_prefetched_hw_desc =
-				hal_srng_dst_prefetch_next_cached_desc(hal_soc,
-					  hal_ring_hdl,
-					  (uint8_t *)*last_prefetched_hw_desc);
-		else
-			*last_prefetched_hw_desc =
-				hal_srng_dst_get_next_32_byte_desc(hal_soc,
-				   hal_ring_hdl,
-				   (uint8_t *)*last_prefetched_hw_desc);
-	}
+	if (depth > num_pending)
+		depth = num_pending;
+
+	for (i = 0; i < depth; i++)
+		qdf_prefetch(hal_srng_dst_get_ahead(hal_soc, hal_ring_hdl, i));
 }
 #else
 static inline void
-dp_rx_prefetch_hw_sw_nbuf_32_byte_desc(struct dp_soc *soc,
-			       hal_soc_handle_t hal_soc,
-			       uint32_t num_entries,
-			       hal_ring_handle_t hal_ring_hdl,
-			       hal_ring_desc_t *last_prefetched_hw_desc,
-			       struct dp_rx_desc **last_prefetched_sw_desc)
+dp_rx_prefetch_hw_sw_nbuf_desc_be(struct dp_soc *soc,
+				  hal_soc_handle_t hal_soc,
+				  hal_ring_handle_t hal_ring_hdl,
+				  uint32_t depth, uint32_t num_pending)
+{
+}
+
+static inline void
+dp_rx_prefetch_hw_sw_nbuf_desc_prime_be(struct dp_soc *soc,
+					hal_soc_handle_t hal_soc,
+					hal_ring_handle_t hal_ring_hdl,
+					uint32_t depth, uint32_t num_pending)
 {
 }
 #endif
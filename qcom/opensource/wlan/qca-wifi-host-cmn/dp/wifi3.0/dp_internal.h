@@ -1180,6 +1180,15 @@ void DP_PRINT_STATS(const char *fmt, ...);
 }
 #endif
 
+#ifdef DP_PEER_RX_RING_STATS
+#define DP_PEER_TO_STACK_RING_INC_PKT(_handle, _ring, _count, _bytes) \
+	DP_PEER_STATS_FLAT_INC_PKT(_handle, rx_ring_stats[_ring].to_stack, \
+				   _count, _bytes)
+#else
+#define DP_PEER_TO_STACK_RING_INC_PKT(_handle, _ring, _count, _bytes) \
+	DP_PEER_STATS_FLAT_INC_PKT(_handle, to_stack, _count, _bytes)
+#endif
+
 #if defined(QCA_VDEV_STATS_HW_OFFLOAD_SUPPORT) && \
 	defined(QCA_ENHANCED_STATS_SUPPORT)
 #define DP_PEER_TO_STACK_INCC_PKT(_handle, _count, _bytes, _cond) \
@@ -1188,6 +1197,12 @@ void DP_PRINT_STATS(const char *fmt, ...);
 		DP_PEER_STATS_FLAT_INC_PKT(_handle, to_stack, _count, _bytes); \
 }
 
+#define DP_PEER_TO_STACK_RING_INCC_PKT(_handle, _ring, _count, _bytes, _cond) \
+{ \
+	if (_cond || !(_handle->hw_txrx_stats_en)) \
+		DP_PEER_TO_STACK_RING_INC_PKT(_handle, _ring, _count, _bytes); \
+}
+
 #define DP_PEER_TO_STACK_DECC(_handle, _count, _cond) \
 { \
 	if (_cond || !(_handle->hw_txrx_stats_en)) \
@@ -1212,6 +1227,12 @@ void DP_PRINT_STATS(const char *fmt, ...);
 		DP_PEER_STATS_FLAT_INC_PKT(_handle, to_stack, _count, _bytes); \
 }
 
+#define DP_PEER_TO_STACK_RING_INCC_PKT(_handle, _ring, _count, _bytes, _cond) \
+{ \
+	if (!(_handle->hw_txrx_stats_en)) \
+		DP_PEER_TO_STACK_RING_INC_PKT(_handle, _ring, _count, _bytes); \
+}
+
 #define DP_PEER_TO_STACK_DECC(_handle, _count, _cond) \
 { \
 	if (!(_handle->hw_txrx_stats_en)) \
@@ -1233,6 +1254,9 @@ void DP_PRINT_STATS(const char *fmt, ...);
 #define DP_PEER_TO_STACK_INCC_PKT(_handle, _count, _bytes, _cond) \
 	DP_PEER_STATS_FLAT_INC_PKT(_handle, to_stack, _count, _bytes);
 
+#define DP_PEER_TO_STACK_RING_INCC_PKT(_handle, _ring, _count, _bytes, _cond) \
+	DP_PEER_TO_STACK_RING_INC_PKT(_handle, _ring, _count, _bytes);
+
 #define DP_PEER_TO_STACK_DECC(_handle, _count, _cond) \
 	DP_PEER_STATS_FLAT_DEC(_handle, to_stack.num, _count);
 
@@ -1243,6 +1267,89 @@ void DP_PRINT_STATS(const char *fmt, ...);
 	DP_PEER_PER_PKT_STATS_INC_PKT(_handle, rx.bcast, _count, _bytes);
 #endif
 
+#ifdef DP_PEER_RX_RING_STATS
+/**
+ * dp_txrx_peer_get_to_stack() - Get packets sent up the stack for a peer
+ * @txrx_peer: DP txrx_peer handle
+ * @to_stack: filled with the peer counter plus the per REO ring deltas
+ *
+ * Return: None
+ */
+static inline void
+dp_txrx_peer_get_to_stack(struct dp_txrx_peer *txrx_peer,
+			  struct cdp_pkt_info *to_stack)
+{
+	uint8_t ring;
+
+	to_stack->num = txrx_peer->to_stack.num;
+	to_stack->bytes = txrx_peer->to_stack.bytes;
+	for (ring = 0; ring < CDP_MAX_RX_RINGS; ring++) {
+		to_stack->num += txrx_peer->rx_ring_stats[ring].to_stack.num;
+		to_stack->bytes +=
+			txrx_peer->rx_ring_stats[ring].to_stack.bytes;
+	}
+}
+
+/**
+ * dp_txrx_peer_rx_ring_stats_aggr() - Add per REO ring deltas of a peer
+ * @txrx_peer: DP txrx_peer handle
+ * @rx: Rx stats to add to
+ *
+ * to_stack is not added here, it is read with dp_txrx_peer_get_to_stack()
+ * along with the other basic stats.
+ *
+ * Return: None
+ */
+static inline void
+dp_txrx_peer_rx_ring_stats_aggr(struct dp_txrx_peer *txrx_peer,
+				struct cdp_rx_stats *rx)
+{
+	struct dp_peer_rx_ring_stats *ring_stats;
+	uint8_t ring;
+
+	for (ring = 0; ring < CDP_MAX_RX_RINGS; ring++) {
+		ring_stats = &txrx_peer->rx_ring_stats[ring];
+		rx->rcvd_reo[ring].num += ring_stats->rcvd.num;
+		rx->rcvd_reo[ring].bytes += ring_stats->rcvd.bytes;
+		rx->non_amsdu_cnt += ring_stats->non_amsdu_cnt;
+		rx->amsdu_cnt += ring_stats->amsdu_cnt;
+		rx->rx_retries += ring_stats->rx_retries;
+	}
+}
+
+/**
+ * dp_txrx_peer_rx_ring_stats_clr() - Clear per REO ring deltas of a peer
+ * @txrx_peer: DP txrx_peer handle
+ *
+ * Return: None
+ */
+static inline void
+dp_txrx_peer_rx_ring_stats_clr(struct dp_txrx_peer *txrx_peer)
+{
+	qdf_mem_zero(txrx_peer->rx_ring_stats,
+		     sizeof(txrx_peer->rx_ring_stats));
+}
+#else
+static inline void
+dp_txrx_peer_get_to_stack(struct dp_txrx_peer *txrx_peer,
+			  struct cdp_pkt_info *to_stack)
+{
+	to_stack->num = txrx_peer->to_stack.num;
+	to_stack->bytes = txrx_peer->to_stack.bytes;
+}
+
+static inline void
+dp_txrx_peer_rx_ring_stats_aggr(struct dp_txrx_peer *txrx_peer,
+				struct cdp_rx_stats *rx)
+{
+}
+
+static inline void
+dp_txrx_peer_rx_ring_stats_clr(struct dp_txrx_peer *txrx_peer)
+{
+}
+#endif
+
 #ifdef ENABLE_DP_HIST_STATS
 #define DP_HIST_INIT() \
 	uint32_t num_of_packets[MAX_PDEV_CNT] = {0};
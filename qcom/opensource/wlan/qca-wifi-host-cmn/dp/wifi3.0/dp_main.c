@@ -7854,6 +7854,50 @@ void dp_peer_hw_txrx_stats_init(struct dp_soc *soc,
 }
 #endif
 
+#ifdef DP_PEER_RX_RING_STATS
+/*
+ * dp_txrx_peer_mem_alloc() - Allocate a txrx_peer on a cache line boundary
+ *
+ * rx_ring_stats only keeps the REO rings off each other's cache lines if
+ * the txrx_peer starts on one, which qdf_mem_malloc() does not promise,
+ * e.g. with the MEMORY_DEBUG header in front of the buffer.
+ *
+ * Return: zeroed txrx_peer, or NULL on failure
+ */
+static struct dp_txrx_peer *dp_txrx_peer_mem_alloc(void)
+{
+	struct dp_txrx_peer *txrx_peer;
+	uint32_t size = sizeof(*txrx_peer);
+	qdf_dma_addr_t paddr_unaligned, paddr_aligned;
+	void *mem_unaligned;
+
+	txrx_peer = qdf_aligned_malloc(&size, &mem_unaligned,
+				       &paddr_unaligned, &paddr_aligned,
+				       QDF_CACHE_LINE_SZ);
+	if (!txrx_peer)
+		return NULL;
+
+	txrx_peer->mem_unaligned = mem_unaligned;
+
+	return txrx_peer;
+}
+
+static void dp_txrx_peer_mem_free(struct dp_txrx_peer *txrx_peer)
+{
+	qdf_mem_free(txrx_peer->mem_unaligned);
+}
+#else
+static inline struct dp_txrx_peer *dp_txrx_peer_mem_alloc(void)
+{
+	return qdf_mem_malloc(sizeof(struct dp_txrx_peer));
+}
+
+static inline void dp_txrx_peer_mem_free(struct dp_txrx_peer *txrx_peer)
+{
+	qdf_mem_free(txrx_peer);
+}
+#endif
+
 static QDF_STATUS dp_txrx_peer_detach(struct dp_soc *soc, struct dp_peer *peer)
 {
 	struct dp_txrx_peer *txrx_peer;
@@ -7874,7 +7918,7 @@ static QDF_STATUS dp_txrx_peer_detach(struct dp_soc *soc, struct dp_peer *peer)
 		dp_peer_jitter_stats_ctx_dealloc(pdev, txrx_peer);
 		dp_peer_sawf_stats_ctx_free(soc, txrx_peer);
 
-		qdf_mem_free(txrx_peer);
+		dp_txrx_peer_mem_free(txrx_peer);
 	}
 
 	return QDF_STATUS_SUCCESS;
@@ -7885,7 +7929,7 @@ static QDF_STATUS dp_txrx_peer_attach(struct dp_soc *soc, struct dp_peer *peer)
 	struct dp_txrx_peer *txrx_peer;
 	struct dp_pdev *pdev;
 
-	txrx_peer = (struct dp_txrx_peer *)qdf_mem_malloc(sizeof(*txrx_peer));
+	txrx_peer = dp_txrx_peer_mem_alloc();
 
 	if (!txrx_peer)
 		return QDF_STATUS_E_NOMEM; /* failure */
@@ -7941,6 +7985,7 @@ void dp_txrx_peer_stats_clr(struct dp_txrx_peer *txrx_peer)
 	txrx_peer->comp_pkt.bytes = 0;
 	txrx_peer->to_stack.num = 0;
 	txrx_peer->to_stack.bytes = 0;
+	dp_txrx_peer_rx_ring_stats_clr(txrx_peer);
 
 	DP_STATS_CLR(txrx_peer);
 	dp_peer_delay_stats_ctx_clr(txrx_peer);
@@ -8952,6 +8997,18 @@ free_vdev:
 
 qdf_export_symbol(dp_vdev_unref_delete);
 
+/*
+ * dp_peer_free_rcu() - free a peer once RCU readers are done with it
+ * @head: rcu head embedded in the peer
+ *
+ */
+static void dp_peer_free_rcu(struct qdf_rcu_head *head)
+{
+	struct dp_peer *peer = qdf_container_of(head, struct dp_peer, rcu);
+
+	qdf_mem_free(peer);
+}
+
 /*
  * dp_peer_unref_delete() - unref and delete peer
  * @peer_handle:    Datapath peer handle
@@ -9024,7 +9081,8 @@ void dp_peer_unref_delete(struct dp_peer *peer, enum dp_mod_id mod_id)
 		dp_txrx_peer_detach(soc, peer);
 		dp_cfg_event_record_peer_evt(soc, DP_CFG_EVENT_PEER_UNREF_DEL,
 					     peer, vdev, 0);
-		qdf_mem_free(peer);
+		/* lockless hash lookups may still be looking at the peer */
+		qdf_call_rcu(&peer->rcu, dp_peer_free_rcu);
 
 		/*
 		 * Decrement ref count taken at peer create
@@ -9983,6 +10041,7 @@ void dp_get_peer_basic_stats(struct dp_peer *peer,
 			     struct cdp_peer_stats *peer_stats)
 {
 	struct dp_txrx_peer *txrx_peer;
+	struct cdp_pkt_info to_stack;
 
 	txrx_peer = dp_get_txrx_peer(peer);
 	if (!txrx_peer)
@@ -9991,8 +10050,10 @@ void dp_get_peer_basic_stats(struct dp_peer *peer,
 	peer_stats->tx.comp_pkt.num += txrx_peer->comp_pkt.num;
 	peer_stats->tx.comp_pkt.bytes += txrx_peer->comp_pkt.bytes;
 	peer_stats->tx.tx_failed += txrx_peer->tx_failed;
-	peer_stats->rx.to_stack.num += txrx_peer->to_stack.num;
-	peer_stats->rx.to_stack.bytes += txrx_peer->to_stack.bytes;
+	dp_txrx_peer_get_to_stack(txrx_peer, &to_stack);
+	peer_stats->rx.to_stack.num += to_stack.num;
+	peer_stats->rx.to_stack.bytes += to_stack.bytes;
+	dp_txrx_peer_rx_ring_stats_aggr(txrx_peer, &peer_stats->rx);
 }
 #else
 static inline
@@ -10000,6 +10061,7 @@ void dp_get_peer_basic_stats(struct dp_peer *peer,
 			     struct cdp_peer_stats *peer_stats)
 {
 	struct dp_txrx_peer *txrx_peer;
+	struct cdp_pkt_info to_stack;
 
 	txrx_peer = dp_get_txrx_peer(peer);
 	if (!txrx_peer)
@@ -10008,8 +10070,10 @@ void dp_get_peer_basic_stats(struct dp_peer *peer,
 	peer_stats->tx.comp_pkt.num += txrx_peer->comp_pkt.num;
 	peer_stats->tx.comp_pkt.bytes += txrx_peer->comp_pkt.bytes;
 	peer_stats->tx.tx_failed += txrx_peer->tx_failed;
-	peer_stats->rx.to_stack.num += txrx_peer->to_stack.num;
-	peer_stats->rx.to_stack.bytes += txrx_peer->to_stack.bytes;
+	dp_txrx_peer_get_to_stack(txrx_peer, &to_stack);
+	peer_stats->rx.to_stack.num += to_stack.num;
+	peer_stats->rx.to_stack.bytes += to_stack.bytes;
+	dp_txrx_peer_rx_ring_stats_aggr(txrx_peer, &peer_stats->rx);
 }
 #endif
 
@@ -19,6 +19,7 @@
 
 #include <qdf_types.h>
 #include <qdf_lock.h>
+#include <qdf_rcu.h>
 #include <hal_hw_headers.h>
 #include "dp_htt.h"
 #include "dp_types.h"
@@ -393,6 +394,41 @@ dp_peer_find_hash_index(struct dp_soc *soc,
 	return index;
 }
 
+/*
+ * dp_peer_hash_bin_insert() - publish a peer at the tail of a hash bin
+ * @bin: hash bin the peer's mac address maps to
+ * @peer: peer handle
+ *
+ * Caller must hold peer_hash_lock.
+ *
+ * return: none
+ */
+static inline void dp_peer_hash_bin_insert(struct dp_peer_hash_bin *bin,
+					   struct dp_peer *peer)
+{
+	qdf_write_seqcount_begin(&bin->seq);
+	qdf_hlist_add_tail_rcu(&peer->hash_node, &bin->head);
+	qdf_write_seqcount_end(&bin->seq);
+}
+
+/*
+ * dp_peer_hash_bin_delete() - unlink a peer from a hash bin
+ * @bin: hash bin the peer's mac address maps to
+ * @peer: peer handle
+ *
+ * Caller must hold peer_hash_lock. Lookups may still be walking the peer,
+ * so its memory is only released after an RCU grace period.
+ *
+ * return: none
+ */
+static inline void dp_peer_hash_bin_delete(struct dp_peer_hash_bin *bin,
+					   struct dp_peer *peer)
+{
+	qdf_write_seqcount_begin(&bin->seq);
+	qdf_hlist_del_init_rcu(&peer->hash_node);
+	qdf_write_seqcount_end(&bin->seq);
+}
+
 /*
  * dp_peer_find_hash_find() - returns legacy or mlo link peer from
  *			      peer_hash_table matching vdev_id and mac_address
@@ -411,7 +447,9 @@ struct dp_peer *dp_peer_find_hash_find(
 				enum dp_mod_id mod_id)
 {
 	union dp_align_mac_addr local_mac_addr_aligned, *mac_addr;
+	struct dp_peer_hash_bin *bin;
 	uint32_t index;
+	unsigned int seq;
 	struct dp_peer *peer;
 
 	if (!soc->peer_hash.bins)
@@ -426,21 +464,37 @@ struct dp_peer *dp_peer_find_hash_find(
 		mac_addr = &local_mac_addr_aligned;
 	}
 	index = dp_peer_find_hash_index(soc, mac_addr);
-	qdf_spin_lock_bh(&soc->peer_hash_lock);
-	TAILQ_FOREACH(peer, &soc->peer_hash.bins[index], hash_list_elem) {
-		if (dp_peer_find_mac_addr_cmp(mac_addr, &peer->mac_addr) == 0 &&
-		    ((peer->vdev->vdev_id == vdev_id) ||
-		     (vdev_id == DP_VDEV_ALL))) {
-			/* take peer reference before returning */
+	bin = &soc->peer_hash.bins[index];
+
+	qdf_rcu_read_lock();
+	do {
+		seq = qdf_read_seqcount_begin(&bin->seq);
+		qdf_hlist_for_each_entry_rcu(peer, &bin->head, hash_node) {
+			if (dp_peer_find_mac_addr_cmp(mac_addr,
+						      &peer->mac_addr))
+				continue;
+
+			/*
+			 * Take the reference before looking at peer->vdev:
+			 * a peer whose count already dropped to zero may have
+			 * released its vdev and is only waiting for the grace
+			 * period to be freed.
+			 */
 			if (dp_peer_get_ref(soc, peer, mod_id) !=
 						QDF_STATUS_SUCCESS)
-				peer = NULL;
+				continue;
 
-			qdf_spin_unlock_bh(&soc->peer_hash_lock);
-			return peer;
+			if ((peer->vdev->vdev_id == vdev_id) ||
+			    (vdev_id == DP_VDEV_ALL)) {
+				qdf_rcu_read_unlock();
+				return peer;
+			}
+
+			dp_peer_unref_delete(peer, mod_id);
 		}
-	}
-	qdf_spin_unlock_bh(&soc->peer_hash_lock);
+	} while (qdf_read_seqcount_retry(&bin->seq, seq));
+	qdf_rcu_read_unlock();
+
 	return NULL; /* failure */
 }
 
@@ -456,6 +510,8 @@ qdf_export_symbol(dp_peer_find_hash_find);
 static void dp_peer_find_hash_detach(struct dp_soc *soc)
 {
 	if (soc->peer_hash.bins) {
+		/* let deferred peer frees finish before the table goes */
+		qdf_rcu_barrier();
 		qdf_mem_free(soc->peer_hash.bins);
 		soc->peer_hash.bins = NULL;
 		qdf_spinlock_destroy(&soc->peer_hash_lock);
@@ -484,14 +540,16 @@ static QDF_STATUS dp_peer_find_hash_attach(struct dp_soc *soc)
 
 	soc->peer_hash.mask = hash_elems - 1;
 	soc->peer_hash.idx_bits = log2;
-	/* allocate an array of TAILQ peer object lists */
+	/* allocate an array of RCU protected peer object lists */
 	soc->peer_hash.bins = qdf_mem_malloc(
-		hash_elems * sizeof(TAILQ_HEAD(anonymous_tail_q, dp_peer)));
+		hash_elems * sizeof(*soc->peer_hash.bins));
 	if (!soc->peer_hash.bins)
 		return QDF_STATUS_E_NOMEM;
 
-	for (i = 0; i < hash_elems; i++)
-		TAILQ_INIT(&soc->peer_hash.bins[i]);
+	for (i = 0; i < hash_elems; i++) {
+		qdf_hlist_head_init(&soc->peer_hash.bins[i].head);
+		qdf_seqcount_init(&soc->peer_hash.bins[i].seq);
+	}
 
 	qdf_spinlock_create(&soc->peer_hash_lock);
 
@@ -535,8 +593,7 @@ void dp_peer_find_hash_add(struct dp_soc *soc, struct dp_peer *peer)
 		 * this ensures that if two entries with the same MAC address
 		 * are stored, the one added first will be found first.
 		 */
-		TAILQ_INSERT_TAIL(&soc->peer_hash.bins[index], peer,
-				  hash_list_elem);
+		dp_peer_hash_bin_insert(&soc->peer_hash.bins[index], peer);
 
 		qdf_spin_unlock_bh(&soc->peer_hash_lock);
 	} else if (peer->peer_type == CDP_MLD_PEER_TYPE) {
@@ -564,19 +621,19 @@ void dp_peer_find_hash_remove(struct dp_soc *soc, struct dp_peer *peer)
 
 	if (peer->peer_type == CDP_LINK_PEER_TYPE) {
 		/* Check if tail is not empty before delete*/
-		QDF_ASSERT(!TAILQ_EMPTY(&soc->peer_hash.bins[index]));
+		QDF_ASSERT(!qdf_hlist_empty(&soc->peer_hash.bins[index].head));
 
 		qdf_spin_lock_bh(&soc->peer_hash_lock);
-		TAILQ_FOREACH(tmppeer, &soc->peer_hash.bins[index],
-			      hash_list_elem) {
+		qdf_hlist_for_each_entry(tmppeer,
+					 &soc->peer_hash.bins[index].head,
+					 hash_node) {
 			if (tmppeer == peer) {
 				found = 1;
 				break;
 			}
 		}
 		QDF_ASSERT(found);
-		TAILQ_REMOVE(&soc->peer_hash.bins[index], peer,
-			     hash_list_elem);
+		dp_peer_hash_bin_delete(&soc->peer_hash.bins[index], peer);
 
 		dp_peer_unref_delete(peer, DP_MOD_ID_CONFIG);
 		qdf_spin_unlock_bh(&soc->peer_hash_lock);
@@ -601,14 +658,16 @@ static QDF_STATUS dp_peer_find_hash_attach(struct dp_soc *soc)
 
 	soc->peer_hash.mask = hash_elems - 1;
 	soc->peer_hash.idx_bits = log2;
-	/* allocate an array of TAILQ peer object lists */
+	/* allocate an array of RCU protected peer object lists */
 	soc->peer_hash.bins = qdf_mem_malloc(
-		hash_elems * sizeof(TAILQ_HEAD(anonymous_tail_q, dp_peer)));
+		hash_elems * sizeof(*soc->peer_hash.bins));
 	if (!soc->peer_hash.bins)
 		return QDF_STATUS_E_NOMEM;
 
-	for (i = 0; i < hash_elems; i++)
-		TAILQ_INIT(&soc->peer_hash.bins[i]);
+	for (i = 0; i < hash_elems; i++) {
+		qdf_hlist_head_init(&soc->peer_hash.bins[i].head);
+		qdf_seqcount_init(&soc->peer_hash.bins[i].seq);
+	}
 
 	qdf_spinlock_create(&soc->peer_hash_lock);
 	return QDF_STATUS_SUCCESS;
@@ -617,6 +676,8 @@ static QDF_STATUS dp_peer_find_hash_attach(struct dp_soc *soc)
 static void dp_peer_find_hash_detach(struct dp_soc *soc)
 {
 	if (soc->peer_hash.bins) {
+		/* let deferred peer frees finish before the table goes */
+		qdf_rcu_barrier();
 		qdf_mem_free(soc->peer_hash.bins);
 		soc->peer_hash.bins = NULL;
 		qdf_spinlock_destroy(&soc->peer_hash_lock);
@@ -644,7 +705,7 @@ void dp_peer_find_hash_add(struct dp_soc *soc, struct dp_peer *peer)
 	 * the same MAC address are stored, the one added first will be
 	 * found first.
 	 */
-	TAILQ_INSERT_TAIL(&soc->peer_hash.bins[index], peer, hash_list_elem);
+	dp_peer_hash_bin_insert(&soc->peer_hash.bins[index], peer);
 
 	qdf_spin_unlock_bh(&soc->peer_hash_lock);
 }
@@ -657,17 +718,18 @@ void dp_peer_find_hash_remove(struct dp_soc *soc, struct dp_peer *peer)
 
 	index = dp_peer_find_hash_index(soc, &peer->mac_addr);
 	/* Check if tail is not empty before delete*/
-	QDF_ASSERT(!TAILQ_EMPTY(&soc->peer_hash.bins[index]));
+	QDF_ASSERT(!qdf_hlist_empty(&soc->peer_hash.bins[index].head));
 
 	qdf_spin_lock_bh(&soc->peer_hash_lock);
-	TAILQ_FOREACH(tmppeer, &soc->peer_hash.bins[index], hash_list_elem) {
+	qdf_hlist_for_each_entry(tmppeer, &soc->peer_hash.bins[index].head,
+				 hash_node) {
 		if (tmppeer == peer) {
 			found = 1;
 			break;
 		}
 	}
 	QDF_ASSERT(found);
-	TAILQ_REMOVE(&soc->peer_hash.bins[index], peer, hash_list_elem);
+	dp_peer_hash_bin_delete(&soc->peer_hash.bins[index], peer);
 
 	dp_peer_unref_delete(peer, DP_MOD_ID_CONFIG);
 	qdf_spin_unlock_bh(&soc->peer_hash_lock);
@@ -1088,7 +1150,8 @@ static bool dp_peer_exist_on_pdev(struct dp_soc *soc,
 	}
 	index = dp_peer_find_hash_index(soc, mac_addr);
 	qdf_spin_lock_bh(&soc->peer_hash_lock);
-	TAILQ_FOREACH(peer, &soc->peer_hash.bins[index], hash_list_elem) {
+	qdf_hlist_for_each_entry(peer, &soc->peer_hash.bins[index].head,
+				 hash_node) {
 		if (dp_peer_find_mac_addr_cmp(mac_addr, &peer->mac_addr) == 0 &&
 		    (peer->vdev->pdev == pdev)) {
 			found = true;
@@ -1132,7 +1195,8 @@ static bool dp_peer_exist_on_pdev(struct dp_soc *soc,
 	}
 	index = dp_peer_find_hash_index(soc, mac_addr);
 	qdf_spin_lock_bh(&soc->peer_hash_lock);
-	TAILQ_FOREACH(peer, &soc->peer_hash.bins[index], hash_list_elem) {
+	qdf_hlist_for_each_entry(peer, &soc->peer_hash.bins[index].head,
+				 hash_node) {
 		if (dp_peer_find_mac_addr_cmp(mac_addr, &peer->mac_addr) == 0 &&
 		    (peer->vdev->pdev == pdev)) {
 			found = true;
@@ -2575,15 +2639,16 @@ void dp_peer_find_hash_erase(struct dp_soc *soc)
 	 * it's known that the soc is no longer in use.
 	 */
 	for (i = 0; i <= soc->peer_hash.mask; i++) {
-		if (!TAILQ_EMPTY(&soc->peer_hash.bins[i])) {
-			struct dp_peer *peer, *peer_next;
+		if (!qdf_hlist_empty(&soc->peer_hash.bins[i].head)) {
+			struct dp_peer *peer;
+			struct qdf_hlist_node *peer_next;
 
 			/*
-			 * TAILQ_FOREACH_SAFE must be used here to avoid any
-			 * memory access violation after peer is freed
+			 * qdf_hlist_for_each_entry_safe must be used here to
+			 * avoid any memory access violation after peer is freed
 			 */
-			TAILQ_FOREACH_SAFE(peer, &soc->peer_hash.bins[i],
-				hash_list_elem, peer_next) {
+			qdf_hlist_for_each_entry_safe(peer, peer_next,
+				&soc->peer_hash.bins[i].head, hash_node) {
 				/*
 				 * Don't remove the peer from the hash table -
 				 * that would modify the list we are currently
@@ -4195,6 +4260,7 @@ static void dp_peer_rx_tids_init(struct dp_peer *peer)
 			rx_tid_defrag->defrag_timeout_ms = 0;
 			rx_tid_defrag->defrag_waitlist_elem.tqe_next = NULL;
 			rx_tid_defrag->defrag_waitlist_elem.tqe_prev = NULL;
+			rx_tid_defrag->on_waitlist = false;
 			rx_tid_defrag->base.head = NULL;
 			rx_tid_defrag->base.tail = NULL;
 			rx_tid_defrag->tid = tid;
@@ -4237,6 +4303,7 @@ static void dp_peer_rx_tids_init(struct dp_peer *peer)
 		rx_tid_defrag->defrag_timeout_ms = 0;
 		rx_tid_defrag->defrag_waitlist_elem.tqe_next = NULL;
 		rx_tid_defrag->defrag_waitlist_elem.tqe_prev = NULL;
+		rx_tid_defrag->on_waitlist = false;
 		rx_tid_defrag->defrag_peer = peer->txrx_peer;
 	}
 }
@@ -1713,17 +1713,54 @@ static inline uint32_t dp_get_l3_hdr_pad_len(struct dp_soc *soc,
 }
 
 /**
- * dp_rx_sg_create() - create a frag_list for MSDUs which are spread across
- *		     multiple nbufs.
+ * dp_rx_sg_attach() - attach the continuation buffers of an MSDU to the
+ *		       first buffer
+ * @parent: first nbuf of the msdu
+ * @frag_list: remaining nbufs of the msdu, NULL terminated
+ * @frag_list_len: total length of @frag_list
+ * @page_frag: attach the nbufs as page frags where possible
+ *
+ * nbufs are merged into @parent in order as long as that needs no copy
+ * of more than the tailroom of @parent; the first one that can not be
+ * merged and all after it are put on the frag_list of @parent.
+ *
+ * Return: None
+ */
+static void dp_rx_sg_attach(qdf_nbuf_t parent, qdf_nbuf_t frag_list,
+			    uint16_t frag_list_len, bool page_frag)
+{
+	qdf_nbuf_t next;
+	uint16_t len;
+
+	while (page_frag && frag_list) {
+		next = frag_list->next;
+		len = qdf_nbuf_len(frag_list);
+		frag_list->next = NULL;
+
+		if (!qdf_nbuf_try_coalesce(parent, frag_list)) {
+			frag_list->next = next;
+			break;
+		}
+
+		frag_list_len -= len;
+		frag_list = next;
+	}
+
+	if (frag_list)
+		qdf_nbuf_append_ext_list(parent, frag_list, frag_list_len);
+}
+
+/**
+ * __dp_rx_sg_create() - assemble an MSDU which is spread across multiple
+ *			 nbufs
  * @soc: DP SOC handle
  * @nbuf: pointer to the first msdu of an amsdu.
+ * @page_frag: attach continuation nbufs as page frags where possible
  *
- * This function implements the creation of RX frag_list for cases
- * where an MSDU is spread across multiple nbufs.
- *
- * Return: returns the head nbuf which contains complete frag_list.
+ * Return: returns the head nbuf which contains the complete msdu.
  */
-qdf_nbuf_t dp_rx_sg_create(struct dp_soc *soc, qdf_nbuf_t nbuf)
+static qdf_nbuf_t
+__dp_rx_sg_create(struct dp_soc *soc, qdf_nbuf_t nbuf, bool page_frag)
 {
 	qdf_nbuf_t parent, frag_list, next = NULL;
 	uint16_t frag_list_len = 0;
@@ -1813,7 +1850,7 @@ qdf_nbuf_t dp_rx_sg_create(struct dp_soc *soc, qdf_nbuf_t nbuf)
 	} while (!last_nbuf);
 
 	qdf_nbuf_set_rx_chfrag_start(nbuf, 0);
-	qdf_nbuf_append_ext_list(parent, frag_list, frag_list_len);
+	dp_rx_sg_attach(parent, frag_list, frag_list_len, page_frag);
 	parent->next = next;
 
 	qdf_nbuf_pull_head(parent,
@@ -1821,6 +1858,16 @@ qdf_nbuf_t dp_rx_sg_create(struct dp_soc *soc, qdf_nbuf_t nbuf)
 	return parent;
 }
 
+qdf_nbuf_t dp_rx_sg_create(struct dp_soc *soc, qdf_nbuf_t nbuf)
+{
+	return __dp_rx_sg_create(soc, nbuf, false);
+}
+
+qdf_nbuf_t dp_rx_sg_create_page_frag(struct dp_soc *soc, qdf_nbuf_t nbuf)
+{
+	return __dp_rx_sg_create(soc, nbuf, true);
+}
+
 #ifdef DP_RX_SG_FRAME_SUPPORT
 /**
  * dp_rx_is_sg_supported() - SG packets processing supported or not.
@@ -2513,6 +2560,50 @@ dp_peer_update_rx_pkt_per_lmac(struct dp_txrx_peer *txrx_peer,
 }
 #endif
 
+#ifdef DP_PEER_RX_RING_STATS
+/**
+ * dp_rx_msdu_ring_stats_update() - update per msdu stats kept per REO ring
+ * @txrx_peer: pointer to the txrx peer object.
+ * @nbuf: pointer to the first msdu of an amsdu.
+ * @ring_id: reo dest ring number on which pkt is reaped.
+ * @msdu_len: msdu length.
+ * @is_not_amsdu: msdu is not part of an amsdu.
+ *
+ * Return: void
+ */
+static inline void
+dp_rx_msdu_ring_stats_update(struct dp_txrx_peer *txrx_peer, qdf_nbuf_t nbuf,
+			     uint8_t ring_id, uint16_t msdu_len,
+			     bool is_not_amsdu)
+{
+	struct dp_peer_rx_ring_stats *ring_stats =
+					&txrx_peer->rx_ring_stats[ring_id];
+
+	ring_stats->rcvd.num++;
+	ring_stats->rcvd.bytes += msdu_len;
+	if (is_not_amsdu)
+		ring_stats->non_amsdu_cnt++;
+	else
+		ring_stats->amsdu_cnt++;
+	if (qdf_nbuf_is_rx_retry_flag(nbuf))
+		ring_stats->rx_retries++;
+}
+#else
+static inline void
+dp_rx_msdu_ring_stats_update(struct dp_txrx_peer *txrx_peer, qdf_nbuf_t nbuf,
+			     uint8_t ring_id, uint16_t msdu_len,
+			     bool is_not_amsdu)
+{
+	DP_PEER_PER_PKT_STATS_INC_PKT(txrx_peer, rx.rcvd_reo[ring_id], 1,
+				      msdu_len);
+	DP_PEER_PER_PKT_STATS_INCC(txrx_peer, rx.non_amsdu_cnt, 1,
+				   is_not_amsdu);
+	DP_PEER_PER_PKT_STATS_INCC(txrx_peer, rx.amsdu_cnt, 1, !is_not_amsdu);
+	DP_PEER_PER_PKT_STATS_INCC(txrx_peer, rx.rx_retries, 1,
+				   qdf_nbuf_is_rx_retry_flag(nbuf));
+}
+#endif
+
 /**
  * dp_rx_msdu_stats_update() - update per msdu stats.
  * @soc: core txrx main context
@@ -2540,13 +2631,8 @@ void dp_rx_msdu_stats_update(struct dp_soc *soc, qdf_nbuf_t nbuf,
 	dp_rx_msdu_stats_update_prot_cnts(vdev, nbuf, txrx_peer);
 	is_not_amsdu = qdf_nbuf_is_rx_chfrag_start(nbuf) &
 			qdf_nbuf_is_rx_chfrag_end(nbuf);
-	DP_PEER_PER_PKT_STATS_INC_PKT(txrx_peer, rx.rcvd_reo[ring_id], 1,
-				      msdu_len);
-	DP_PEER_PER_PKT_STATS_INCC(txrx_peer, rx.non_amsdu_cnt, 1,
-				   is_not_amsdu);
-	DP_PEER_PER_PKT_STATS_INCC(txrx_peer, rx.amsdu_cnt, 1, !is_not_amsdu);
-	DP_PEER_PER_PKT_STATS_INCC(txrx_peer, rx.rx_retries, 1,
-				   qdf_nbuf_is_rx_retry_flag(nbuf));
+	dp_rx_msdu_ring_stats_update(txrx_peer, nbuf, ring_id, msdu_len,
+				     is_not_amsdu);
 	dp_peer_update_rx_pkt_per_lmac(txrx_peer, nbuf);
 	tid_stats->msdu_cnt++;
 	if (qdf_unlikely(qdf_nbuf_is_da_mcbc(nbuf) &&
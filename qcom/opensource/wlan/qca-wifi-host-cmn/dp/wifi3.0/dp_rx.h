@@ -898,6 +898,21 @@ dp_rx_wbm_err_process(struct dp_intr *int_ctx, struct dp_soc *soc,
  */
 qdf_nbuf_t dp_rx_sg_create(struct dp_soc *soc, qdf_nbuf_t nbuf);
 
+/**
+ * dp_rx_sg_create_page_frag() - attach the buffers of an MSDU which is
+ *				 spread across multiple nbufs as page frags
+ * @soc: core txrx main context
+ * @nbuf: pointer to the first msdu of an amsdu.
+ *
+ * Same as dp_rx_sg_create(), except that the continuation buffers are
+ * attached as page frags of the first nbuf where possible, and only the
+ * ones that can not be are put on its frag_list. Callers that walk the
+ * frag_list of the result must use dp_rx_sg_create().
+ *
+ * Return: returns the head nbuf which contains the complete msdu.
+ */
+qdf_nbuf_t dp_rx_sg_create_page_frag(struct dp_soc *soc, qdf_nbuf_t nbuf);
+
 /**
  * dp_rx_is_sg_supported() - SG packets processing supported or not.
  *
@@ -86,6 +86,28 @@ static void dp_rx_defrag_frames_free(qdf_nbuf_t frames)
 	}
 }
 
+/*
+ * dp_rx_defrag_slots_free(): Free fragments held in the per-TID slots
+ * @rx_tid: Pointer to the TID defrag state
+ *
+ * Returns: None
+ */
+static void dp_rx_defrag_slots_free(struct dp_rx_tid_defrag *rx_tid)
+{
+	uint8_t fragno;
+
+	for (fragno = 0; rx_tid->frag_bitmap; fragno++) {
+		if (!(rx_tid->frag_bitmap & (1 << fragno)))
+			continue;
+
+		dp_rx_nbuf_free(rx_tid->frags[fragno]);
+		rx_tid->frags[fragno] = NULL;
+		rx_tid->frag_bitmap &= ~(1 << fragno);
+	}
+
+	rx_tid->frag_complete_mask = 0;
+}
+
 /*
  * dp_rx_clear_saved_desc_info(): Clears descriptor info
  * @txrx peer: Pointer to the peer data structure
@@ -201,6 +223,7 @@ void dp_rx_defrag_waitlist_flush(struct dp_soc *soc)
 
 		TAILQ_REMOVE(&soc->rx.defrag.waitlist, waitlist_elem,
 			     defrag_waitlist_elem);
+		waitlist_elem->on_waitlist = false;
 		DP_STATS_DEC(soc, rx.rx_frag_wait, 1);
 
 		/* Move to temp list and clean-up later */
@@ -253,8 +276,8 @@ void dp_rx_defrag_waitlist_flush(struct dp_soc *soc)
  *
  * Returns: None
  */
-static void dp_rx_defrag_waitlist_add(struct dp_txrx_peer *txrx_peer,
-				      unsigned int tid)
+void dp_rx_defrag_waitlist_add(struct dp_txrx_peer *txrx_peer,
+			       unsigned int tid)
 {
 	struct dp_soc *psoc = txrx_peer->vdev->pdev->soc;
 	struct dp_rx_tid_defrag *waitlist_elem = &txrx_peer->rx_tid[tid];
@@ -270,6 +293,7 @@ static void dp_rx_defrag_waitlist_add(struct dp_txrx_peer *txrx_peer,
 
 	TAILQ_INSERT_TAIL(&psoc->rx.defrag.waitlist, waitlist_elem,
 			  defrag_waitlist_elem);
+	waitlist_elem->on_waitlist = true;
 	DP_STATS_INC(psoc, rx.rx_frag_wait, 1);
 	qdf_spin_unlock_bh(&psoc->rx.defrag.defrag_lock);
 }
@@ -279,7 +303,8 @@ static void dp_rx_defrag_waitlist_add(struct dp_txrx_peer *txrx_peer,
  * @txrx peer: Pointer to the peer data structure
  * @tid: Transmit ID (TID)
  *
- * Remove fragments from waitlist
+ * Remove fragments from waitlist. The TID is unlinked directly instead of
+ * searching the list for it, so this is O(1) in the waitlist length.
  *
  * Returns: None
  */
@@ -289,7 +314,6 @@ void dp_rx_defrag_waitlist_remove(struct dp_txrx_peer *txrx_peer,
 	struct dp_pdev *pdev = txrx_peer->vdev->pdev;
 	struct dp_soc *soc = pdev->soc;
 	struct dp_rx_tid_defrag *waitlist_elm;
-	struct dp_rx_tid_defrag *tmp;
 
 	dp_debug("Removing TID %u to waitlist for peer %pK peer_id = %d ",
 		 tid, txrx_peer, txrx_peer->peer_id);
@@ -299,26 +323,76 @@ void dp_rx_defrag_waitlist_remove(struct dp_txrx_peer *txrx_peer,
 		qdf_assert_always(0);
 	}
 
+	waitlist_elm = &txrx_peer->rx_tid[tid];
+
 	qdf_spin_lock_bh(&soc->rx.defrag.defrag_lock);
-	TAILQ_FOREACH_SAFE(waitlist_elm, &soc->rx.defrag.waitlist,
-			   defrag_waitlist_elem, tmp) {
-		struct dp_txrx_peer *peer_on_waitlist;
+	if (waitlist_elm->on_waitlist) {
+		TAILQ_REMOVE(&soc->rx.defrag.waitlist,
+			     waitlist_elm, defrag_waitlist_elem);
+		waitlist_elm->on_waitlist = false;
+		DP_STATS_DEC(soc, rx.rx_frag_wait, 1);
+	}
+	qdf_spin_unlock_bh(&soc->rx.defrag.defrag_lock);
+}
 
-		/* get address of current peer */
-		peer_on_waitlist = waitlist_elm->defrag_peer;
+QDF_STATUS dp_rx_defrag_slot_insert(struct dp_rx_tid_defrag *rx_tid,
+				    qdf_nbuf_t frag, uint8_t fragno,
+				    uint8_t more_frag, qdf_nbuf_t *head_addr,
+				    qdf_nbuf_t *tail_addr,
+				    uint8_t *all_frag_present)
+{
+	uint16_t frag_bit = 1 << fragno;
+	uint16_t complete_mask;
+	uint8_t last_fragno;
+	uint8_t i;
 
-		/* Ensure it is TID for same peer */
-		if (peer_on_waitlist == txrx_peer && waitlist_elm->tid == tid) {
-			TAILQ_REMOVE(&soc->rx.defrag.waitlist,
-				     waitlist_elm, defrag_waitlist_elem);
-			DP_STATS_DEC(soc, rx.rx_frag_wait, 1);
-		}
+	*all_frag_present = 0;
+
+	/* Duplicate fragment */
+	if (rx_tid->frag_bitmap & frag_bit)
+		return QDF_STATUS_E_ALREADY;
+
+	/* Past the fragment that had more_frag clear */
+	if (rx_tid->frag_complete_mask &&
+	    (frag_bit & ~rx_tid->frag_complete_mask))
+		return QDF_STATUS_E_INVAL;
+
+	if (!more_frag) {
+		complete_mask = (frag_bit << 1) - 1;
+
+		/* Fragments were already stored past this one */
+		if (rx_tid->frag_bitmap & ~complete_mask)
+			return QDF_STATUS_E_INVAL;
+
+		rx_tid->frag_complete_mask = complete_mask;
 	}
-	qdf_spin_unlock_bh(&soc->rx.defrag.defrag_lock);
+
+	rx_tid->frags[fragno] = frag;
+	rx_tid->frag_bitmap |= frag_bit;
+
+	if (!rx_tid->frag_complete_mask ||
+	    rx_tid->frag_bitmap != rx_tid->frag_complete_mask)
+		return QDF_STATUS_SUCCESS;
+
+	/* All fragments are in, hand them over as an ordered chain */
+	last_fragno = qdf_fls(rx_tid->frag_complete_mask) - 1;
+	for (i = 0; i < last_fragno; i++)
+		qdf_nbuf_set_next(rx_tid->frags[i], rx_tid->frags[i + 1]);
+	qdf_nbuf_set_next(rx_tid->frags[last_fragno], NULL);
+
+	*head_addr = rx_tid->frags[0];
+	*tail_addr = rx_tid->frags[last_fragno];
+
+	qdf_mem_zero(rx_tid->frags, sizeof(rx_tid->frags));
+	rx_tid->frag_bitmap = 0;
+	rx_tid->frag_complete_mask = 0;
+	*all_frag_present = 1;
+
+	return QDF_STATUS_SUCCESS;
 }
 
 /*
- * dp_rx_defrag_fraglist_insert(): Create a per-sequence fragment list
+ * dp_rx_defrag_fraglist_insert(): Store a fragment of the current sequence
  * @txrx_peer: Pointer to the peer data structure
  * @tid: Transmit ID (TID)
  * @head_addr: Pointer to head list
@@ -326,7 +400,8 @@ void dp_rx_defrag_waitlist_remove(struct dp_txrx_peer *txrx_peer,
  * @frag: Incoming fragment
  * @all_frag_present: Flag to indicate whether all fragments are received
  *
- * Build a per-tid, per-sequence fragment list.
+ * Fragments are kept in per-TID slots indexed by fragment number, see
+ * dp_rx_defrag_slot_insert(). A fragment that is not stored is freed.
  *
  * Returns: Success, if inserted
  */
@@ -336,109 +411,31 @@ dp_rx_defrag_fraglist_insert(struct dp_txrx_peer *txrx_peer, unsigned int tid,
 			     qdf_nbuf_t frag, uint8_t *all_frag_present)
 {
 	struct dp_soc *soc = txrx_peer->vdev->pdev->soc;
-	qdf_nbuf_t next;
-	qdf_nbuf_t prev = NULL;
-	qdf_nbuf_t cur;
-	uint16_t head_fragno, cur_fragno, next_fragno;
-	uint8_t last_morefrag = 1, count = 0;
 	struct dp_rx_tid_defrag *rx_tid = &txrx_peer->rx_tid[tid];
 	uint8_t *rx_desc_info;
+	uint8_t cur_fragno;
+	QDF_STATUS status;
 
 	qdf_assert(frag);
 	qdf_assert(head_addr);
 	qdf_assert(tail_addr);
 
-	*all_frag_present = 0;
 	rx_desc_info = qdf_nbuf_data(frag);
 	cur_fragno = dp_rx_frag_get_mpdu_frag_number(soc, rx_desc_info);
 
 	dp_debug("cur_fragno %d\n", cur_fragno);
-	/* If this is the first fragment */
-	if (!(*head_addr)) {
-		*head_addr = *tail_addr = frag;
-		qdf_nbuf_set_next(*tail_addr, NULL);
-		rx_tid->curr_frag_num = cur_fragno;
-
-		goto insert_done;
-	}
-
-	/* In sequence fragment */
-	if (cur_fragno > rx_tid->curr_frag_num) {
-		qdf_nbuf_set_next(*tail_addr, frag);
-		*tail_addr = frag;
-		qdf_nbuf_set_next(*tail_addr, NULL);
-		rx_tid->curr_frag_num = cur_fragno;
-	} else {
-		/* Out of sequence fragment */
-		cur = *head_addr;
-		rx_desc_info = qdf_nbuf_data(cur);
-		head_fragno = dp_rx_frag_get_mpdu_frag_number(soc,
-							      rx_desc_info);
-
-		if (cur_fragno == head_fragno) {
-			dp_rx_nbuf_free(frag);
-			goto insert_fail;
-		} else if (head_fragno > cur_fragno) {
-			qdf_nbuf_set_next(frag, cur);
-			cur = frag;
-			*head_addr = frag; /* head pointer to be updated */
-		} else {
-			while ((cur_fragno > head_fragno) && cur) {
-				prev = cur;
-				cur = qdf_nbuf_next(cur);
-				if (cur) {
-					rx_desc_info = qdf_nbuf_data(cur);
-					head_fragno =
-						dp_rx_frag_get_mpdu_frag_number(
-								soc,
-								rx_desc_info);
-				}
-			}
-
-			if (cur_fragno == head_fragno) {
-				dp_rx_nbuf_free(frag);
-				goto insert_fail;
-			}
-
-			qdf_nbuf_set_next(prev, frag);
-			qdf_nbuf_set_next(frag, cur);
-		}
-	}
-
-	next = qdf_nbuf_next(*head_addr);
-
-	rx_desc_info = qdf_nbuf_data(*tail_addr);
-	last_morefrag = dp_rx_frag_get_more_frag_bit(soc, rx_desc_info);
-
-	/* TODO: optimize the loop */
-	if (!last_morefrag) {
-		/* Check if all fragments are present */
-		do {
-			rx_desc_info = qdf_nbuf_data(next);
-			next_fragno =
-				dp_rx_frag_get_mpdu_frag_number(soc,
-								rx_desc_info);
-			count++;
-
-			if (next_fragno != count)
-				break;
-
-			next = qdf_nbuf_next(next);
-		} while (next);
-
-		if (!next) {
-			*all_frag_present = 1;
-			return QDF_STATUS_SUCCESS;
-		} else {
-			/* revisit */
-		}
+	status = dp_rx_defrag_slot_insert(rx_tid, frag, cur_fragno,
+					  dp_rx_frag_get_more_frag_bit(soc,
+								rx_desc_info),
+					  head_addr, tail_addr,
+					  all_frag_present);
+	if (QDF_IS_STATUS_ERROR(status)) {
+		dp_debug("fragno %d dropped, status %d", cur_fragno, status);
+		dp_rx_nbuf_free(frag);
+		return QDF_STATUS_E_FAILURE;
 	}
 
-insert_done:
 	return QDF_STATUS_SUCCESS;
-
-insert_fail:
-	return QDF_STATUS_E_FAILURE;
 }
 
 
@@ -1641,12 +1638,12 @@ void dp_rx_defrag_cleanup(struct dp_txrx_peer *txrx_peer, unsigned int tid)
 		dp_info("Cleanup self peer %pK and TID %u",
 			txrx_peer, tid);
 	}
+	dp_rx_defrag_slots_free(&txrx_peer->rx_tid[tid]);
 
 	/* Free up saved ring descriptors */
 	dp_rx_clear_saved_desc_info(txrx_peer, tid);
 
 	txrx_peer->rx_tid[tid].defrag_timeout_ms = 0;
-	txrx_peer->rx_tid[tid].curr_frag_num = 0;
 	txrx_peer->rx_tid[tid].curr_seq_num = 0;
 }
 
@@ -1889,9 +1886,9 @@ dp_rx_defrag_store_fragment(struct dp_soc *soc,
 	/*
 	 * !more_frag: no more fragments to be delivered
 	 * !frag_no: packet is not fragmented
-	 * !rx_reorder_array_elem->head: no saved fragments so far
+	 * !rx_tid->frag_bitmap: no saved fragments so far
 	 */
-	if ((!more_frag) && (!fragno) && (!rx_reorder_array_elem->head)) {
+	if ((!more_frag) && (!fragno) && (!rx_tid->frag_bitmap)) {
 		/* We should not get into this situation here.
 		 * It means an unfragmented packet with fragment flag
 		 * is delivered over the REO exception ring.
@@ -1907,7 +1904,7 @@ dp_rx_defrag_store_fragment(struct dp_soc *soc,
 
 	/* Check if the fragment is for the same sequence or a different one */
 	dp_debug("rx_tid %d", tid);
-	if (rx_reorder_array_elem->head) {
+	if (rx_tid->frag_bitmap) {
 		dp_debug("rxseq %d\n", rxseq);
 		if (rxseq != rx_tid->curr_seq_num) {
 
@@ -1958,8 +1955,7 @@ dp_rx_defrag_store_fragment(struct dp_soc *soc,
 	 * before reinjection.
 	 * ring_desc is validated in dp_rx_err_process.
 	 */
-	if ((fragno == 0) && (status == QDF_STATUS_SUCCESS) &&
-			(rx_reorder_array_elem->head == frag)) {
+	if ((fragno == 0) && (status == QDF_STATUS_SUCCESS)) {
 
 		status = dp_rx_defrag_save_info_from_ring_desc(soc, ring_desc,
 							       rx_desc,
@@ -2188,7 +2184,7 @@ QDF_STATUS dp_rx_defrag_add_last_frag(struct dp_soc *soc,
 		goto fail;
 	}
 
-	if (rx_reorder_array_elem->head &&
+	if (rx_tid->frag_bitmap &&
 	    rxseq != rx_tid->curr_seq_num) {
 		/* Drop stored fragments if out of sequence
 		 * fragment is received
@@ -136,9 +136,37 @@ uint8_t dp_rx_get_pkt_dir(struct dp_soc *soc, uint8_t *rx_desc_info)
 void dp_rx_defrag_waitlist_flush(struct dp_soc *soc);
 void dp_rx_reorder_flush_frag(struct dp_txrx_peer *txrx_peer,
 			      unsigned int tid);
+void dp_rx_defrag_waitlist_add(struct dp_txrx_peer *txrx_peer,
+			       unsigned int tid);
 void dp_rx_defrag_waitlist_remove(struct dp_txrx_peer *peer, unsigned int tid);
 void dp_rx_defrag_cleanup(struct dp_txrx_peer *peer, unsigned int tid);
 
+/**
+ * dp_rx_defrag_slot_insert() - store a fragment in the per-TID slots
+ * @rx_tid: TID defrag state
+ * @frag: incoming fragment
+ * @fragno: fragment number of @frag
+ * @more_frag: more fragments bit of @frag
+ * @head_addr: set to the first fragment once the sequence is complete
+ * @tail_addr: set to the last fragment once the sequence is complete
+ * @all_frag_present: set to 1 once the sequence is complete
+ *
+ * Slots are indexed by fragment number, so insertion, duplicate detection
+ * and the completeness check are O(1) whatever order the fragments arrive
+ * in. Once all fragments up to the one with @more_frag clear are in, they
+ * are linked in order, returned through @head_addr/@tail_addr and the
+ * slots are emptied. @frag is not freed on failure.
+ *
+ * Return: QDF_STATUS_SUCCESS if @frag was stored
+ *	   QDF_STATUS_E_ALREADY if @fragno is already stored
+ *	   QDF_STATUS_E_INVAL if @fragno is past the last fragment
+ */
+QDF_STATUS dp_rx_defrag_slot_insert(struct dp_rx_tid_defrag *rx_tid,
+				    qdf_nbuf_t frag, uint8_t fragno,
+				    uint8_t more_frag, qdf_nbuf_t *head_addr,
+				    qdf_nbuf_t *tail_addr,
+				    uint8_t *all_frag_present);
+
 QDF_STATUS dp_rx_defrag_add_last_frag(struct dp_soc *soc,
 				      struct dp_txrx_peer *peer, uint16_t tid,
 				      uint16_t rxseq, qdf_nbuf_t nbuf);
@@ -7757,6 +7757,43 @@ void dp_print_tx_ppeds_stats(struct dp_soc *soc)
 }
 #endif
 
+#ifdef DP_TX_DESC_PCPU_CACHE
+static void dp_print_tx_desc_mag_stats(struct dp_soc *soc)
+{
+	struct dp_tx_desc_mag *mag;
+	uint32_t cached, alloc_hit, alloc_miss, free_hit, free_flush;
+	int pool_id, cpu;
+
+	DP_PRINT_STATS("Tx Desc Per-CPU Cache:");
+	for (pool_id = 0; pool_id < MAX_TXDESC_POOLS; pool_id++) {
+		cached = 0;
+		alloc_hit = 0;
+		alloc_miss = 0;
+		free_hit = 0;
+		free_flush = 0;
+		for (cpu = 0; cpu < DP_TX_DESC_MAG_MAX_CPUS; cpu++) {
+			mag = &soc->tx_desc_mag[pool_id][cpu];
+			cached += mag->count;
+			alloc_hit += mag->alloc_hit;
+			alloc_miss += mag->alloc_miss;
+			free_hit += mag->free_hit;
+			free_flush += mag->free_flush;
+		}
+
+		if (!alloc_hit && !alloc_miss && !free_hit && !free_flush)
+			continue;
+
+		DP_PRINT_STATS("	Pool %d: Cached = %u Alloc hit/miss = %u/%u Free hit/flush = %u/%u",
+			       pool_id, cached, alloc_hit, alloc_miss,
+			       free_hit, free_flush);
+	}
+}
+#else
+static void dp_print_tx_desc_mag_stats(struct dp_soc *soc)
+{
+}
+#endif
+
 void
 dp_print_soc_tx_stats(struct dp_soc *soc)
 {
@@ -7800,6 +7837,7 @@ dp_print_soc_tx_stats(struct dp_soc *soc)
 		       soc->stats.tx.tx_comp_loop_pkt_limit_hit);
 	DP_PRINT_STATS("Tx comp HP out of sync2 = %d",
 		       soc->stats.tx.hp_oos2);
+	dp_print_tx_desc_mag_stats(soc);
 	dp_print_tx_ppeds_stats(soc);
 }
 
@@ -8450,6 +8488,8 @@ static inline
 void dp_update_vdev_basic_stats(struct dp_txrx_peer *txrx_peer,
 				struct cdp_vdev_stats *tgtobj)
 {
+	struct cdp_pkt_info to_stack;
+
 	if (qdf_unlikely(!txrx_peer || !tgtobj))
 		return;
 
@@ -8458,8 +8498,10 @@ void dp_update_vdev_basic_stats(struct dp_txrx_peer *txrx_peer,
 		tgtobj->tx.comp_pkt.bytes += txrx_peer->comp_pkt.bytes;
 		tgtobj->tx.tx_failed += txrx_peer->tx_failed;
 	}
-	tgtobj->rx.to_stack.num += txrx_peer->to_stack.num;
-	tgtobj->rx.to_stack.bytes += txrx_peer->to_stack.bytes;
+	dp_txrx_peer_get_to_stack(txrx_peer, &to_stack);
+	tgtobj->rx.to_stack.num += to_stack.num;
+	tgtobj->rx.to_stack.bytes += to_stack.bytes;
+	dp_txrx_peer_rx_ring_stats_aggr(txrx_peer, &tgtobj->rx);
 }
 
 #ifdef QCA_ENHANCED_STATS_SUPPORT
@@ -6196,6 +6196,9 @@ void dp_tx_desc_flush(struct dp_pdev *pdev, struct dp_vdev *vdev,
 		return;
 	}
 
+	/* Descriptors parked in per-CPU caches are not in use */
+	dp_tx_desc_mag_drain_all(soc);
+
 	for (i = 0; i < MAX_TXDESC_POOLS; i++) {
 		tx_desc_pool = &soc->tx_desc[i];
 		if (!(tx_desc_pool->pool_size) ||
@@ -6282,6 +6285,9 @@ void dp_tx_desc_flush(struct dp_pdev *pdev, struct dp_vdev *vdev,
 		return;
 	}
 
+	/* Descriptors parked in per-CPU caches are not in use */
+	dp_tx_desc_mag_drain_all(soc);
+
 	num_desc = wlan_cfg_get_num_tx_desc(soc->wlan_cfg_ctx);
 	num_pool = wlan_cfg_get_num_tx_desc_pool(soc->wlan_cfg_ctx);
 
@@ -6480,6 +6486,7 @@ void dp_soc_tx_desc_sw_pools_deinit(struct dp_soc *soc)
 
 	num_pool = wlan_cfg_get_num_tx_desc_pool(soc->wlan_cfg_ctx);
 
+	dp_tx_desc_mag_deinit(soc);
 	dp_tx_flow_control_deinit(soc);
 	dp_tx_tso_cmn_desc_pool_deinit(soc, num_pool);
 	dp_tx_ext_desc_pool_deinit(soc, num_pool);
@@ -6615,6 +6622,8 @@ QDF_STATUS dp_soc_tx_desc_sw_pools_init(struct dp_soc *soc)
 	num_desc = wlan_cfg_get_num_tx_desc(soc->wlan_cfg_ctx);
 	num_ext_desc = wlan_cfg_get_num_tx_ext_desc(soc->wlan_cfg_ctx);
 
+	dp_tx_desc_mag_init(soc);
+
 	if (dp_tx_init_static_pools(soc, num_pool, num_desc))
 		goto fail1;
 
@@ -6636,6 +6645,7 @@ fail3:
 fail2:
 	dp_tx_deinit_static_pools(soc, num_pool);
 fail1:
+	dp_tx_desc_mag_deinit(soc);
 	return QDF_STATUS_E_RESOURCES;
 }
 
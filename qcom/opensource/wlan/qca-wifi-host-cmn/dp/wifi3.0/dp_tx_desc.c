@@ -245,6 +245,97 @@ void dp_tx_desc_pool_deinit(struct dp_soc *soc, uint8_t pool_id)
 	TX_DESC_LOCK_DESTROY(&tx_desc_pool->lock);
 }
 
+#ifdef DP_TX_DESC_PCPU_CACHE
+/**
+ * dp_tx_desc_mag_init() - Initialize the per-CPU Tx descriptor caches
+ * @soc: Handle to DP SoC structure
+ *
+ * Return: None
+ */
+void dp_tx_desc_mag_init(struct dp_soc *soc)
+{
+	struct dp_tx_desc_mag *mag;
+	int pool_id, cpu;
+
+	for (pool_id = 0; pool_id < MAX_TXDESC_POOLS; pool_id++) {
+		for (cpu = 0; cpu < DP_TX_DESC_MAG_MAX_CPUS; cpu++) {
+			mag = &soc->tx_desc_mag[pool_id][cpu];
+			qdf_mem_zero(mag, sizeof(*mag));
+			qdf_spinlock_create(&mag->lock);
+		}
+	}
+}
+
+/**
+ * dp_tx_desc_mag_deinit() - De-initialize the per-CPU Tx descriptor caches
+ * @soc: Handle to DP SoC structure
+ *
+ * Descriptors still cached go back to their pools, so this must run
+ * before the pools are de-initialized.
+ *
+ * Return: None
+ */
+void dp_tx_desc_mag_deinit(struct dp_soc *soc)
+{
+	struct dp_tx_desc_mag *mag;
+	int pool_id, cpu;
+
+	dp_tx_desc_mag_drain_all(soc);
+
+	for (pool_id = 0; pool_id < MAX_TXDESC_POOLS; pool_id++) {
+		for (cpu = 0; cpu < DP_TX_DESC_MAG_MAX_CPUS; cpu++) {
+			mag = &soc->tx_desc_mag[pool_id][cpu];
+			qdf_spinlock_destroy(&mag->lock);
+		}
+	}
+}
+
+/**
+ * dp_tx_desc_mag_drain() - Return all cached descriptors of a pool
+ * @soc: Handle to DP SoC structure
+ * @desc_pool_id: Tx descriptor pool
+ *
+ * Must not be called with the pool lock held.
+ *
+ * Return: None
+ */
+void dp_tx_desc_mag_drain(struct dp_soc *soc, uint8_t desc_pool_id)
+{
+	struct dp_tx_desc_s *descs[DP_TX_DESC_MAG_SIZE];
+	struct dp_tx_desc_mag *mag;
+	uint16_t num;
+	int cpu;
+
+	for (cpu = 0; cpu < DP_TX_DESC_MAG_MAX_CPUS; cpu++) {
+		mag = &soc->tx_desc_mag[desc_pool_id][cpu];
+
+		qdf_spin_lock_bh(&mag->lock);
+		num = mag->count;
+		qdf_mem_copy(descs, mag->descs, num * sizeof(*descs));
+		mag->count = 0;
+		qdf_spin_unlock_bh(&mag->lock);
+
+		if (num)
+			dp_tx_desc_pool_put_batch(soc, desc_pool_id,
+						  descs, num);
+	}
+}
+
+/**
+ * dp_tx_desc_mag_drain_all() - Return all cached descriptors of all pools
+ * @soc: Handle to DP SoC structure
+ *
+ * Return: None
+ */
+void dp_tx_desc_mag_drain_all(struct dp_soc *soc)
+{
+	int pool_id;
+
+	for (pool_id = 0; pool_id < MAX_TXDESC_POOLS; pool_id++)
+		dp_tx_desc_mag_drain(soc, pool_id);
+}
+#endif /* DP_TX_DESC_PCPU_CACHE */
+
 /**
  * dp_tx_ext_desc_pool_alloc() - allocate Tx extension Descriptor pool(s)
  * @soc: Handle to DP SoC structure
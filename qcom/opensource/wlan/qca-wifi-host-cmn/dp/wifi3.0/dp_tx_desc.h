@@ -294,7 +294,104 @@ dp_tx_adjust_flow_pool_state(struct dp_soc *soc,
 }
 
 /**
- * dp_tx_desc_alloc() - Allocate a Software Tx descriptor from given pool
+ * dp_tx_desc_pool_has_free() - Check if a descriptor can be taken from pool
+ *
+ * @pool: flow pool
+ *
+ * Caller needs to take lock.
+ *
+ * Return: true if the pool is active and has a free descriptor
+ */
+static inline bool dp_tx_desc_pool_has_free(struct dp_tx_desc_pool_s *pool)
+{
+	return pool->avail_desc &&
+	       pool->status != FLOW_POOL_INVALID &&
+	       pool->status != FLOW_POOL_INACTIVE;
+}
+
+/**
+ * dp_tx_desc_get_locked() - Take a descriptor and apply flow control
+ *
+ * @soc: Handle to DP SoC structure
+ * @pool: flow pool
+ * @desc_pool_id: ID of the flow control pool
+ *
+ * Caller needs to take lock and check dp_tx_desc_pool_has_free().
+ *
+ * Return: TX descriptor
+ */
+static inline struct dp_tx_desc_s *
+dp_tx_desc_get_locked(struct dp_soc *soc, struct dp_tx_desc_pool_s *pool,
+		      uint8_t desc_pool_id)
+{
+	struct dp_tx_desc_s *tx_desc;
+	bool is_pause;
+	enum netif_action_type act = WLAN_NETIF_ACTION_TYPE_NONE;
+	enum dp_fl_ctrl_threshold level = DP_TH_BE_BK;
+	enum netif_reason_type reason;
+
+	tx_desc = dp_tx_get_desc_flow_pool(pool);
+	tx_desc->pool_id = desc_pool_id;
+	tx_desc->flags = DP_TX_DESC_FLAG_ALLOCATED;
+	dp_tx_desc_set_magic(tx_desc, DP_TX_MAGIC_PATTERN_INUSE);
+	is_pause = dp_tx_is_threshold_reached(pool, pool->avail_desc);
+
+	if (qdf_unlikely(pool->status ==
+			 FLOW_POOL_ACTIVE_UNPAUSED_REATTACH)) {
+		dp_tx_adjust_flow_pool_state(soc, pool);
+		is_pause = false;
+	}
+
+	if (qdf_likely(!is_pause))
+		return tx_desc;
+
+	switch (pool->status) {
+	case FLOW_POOL_ACTIVE_UNPAUSED:
+		/* pause network BE\BK queue */
+		act = WLAN_NETIF_BE_BK_QUEUE_OFF;
+		reason = WLAN_DATA_FLOW_CTRL_BE_BK;
+		level = DP_TH_BE_BK;
+		pool->status = FLOW_POOL_BE_BK_PAUSED;
+		break;
+	case FLOW_POOL_BE_BK_PAUSED:
+		/* pause network VI queue */
+		act = WLAN_NETIF_VI_QUEUE_OFF;
+		reason = WLAN_DATA_FLOW_CTRL_VI;
+		level = DP_TH_VI;
+		pool->status = FLOW_POOL_VI_PAUSED;
+		break;
+	case FLOW_POOL_VI_PAUSED:
+		/* pause network VO queue */
+		act = WLAN_NETIF_VO_QUEUE_OFF;
+		reason = WLAN_DATA_FLOW_CTRL_VO;
+		level = DP_TH_VO;
+		pool->status = FLOW_POOL_VO_PAUSED;
+		break;
+	case FLOW_POOL_VO_PAUSED:
+		/* pause network HI PRI queue */
+		act = WLAN_NETIF_PRIORITY_QUEUE_OFF;
+		reason = WLAN_DATA_FLOW_CTRL_PRI;
+		level = DP_TH_HI;
+		pool->status = FLOW_POOL_ACTIVE_PAUSED;
+		break;
+	case FLOW_POOL_ACTIVE_PAUSED:
+		act = WLAN_NETIF_ACTION_TYPE_NONE;
+		break;
+	default:
+		dp_err_rl("pool status is %d!", pool->status);
+		break;
+	}
+
+	if (act != WLAN_NETIF_ACTION_TYPE_NONE) {
+		pool->latest_pause_time[level] = qdf_get_system_timestamp();
+		soc->pause_cb(desc_pool_id, act, reason);
+	}
+
+	return tx_desc;
+}
+
+/**
+ * __dp_tx_desc_alloc() - Allocate a Software Tx descriptor from given pool
  *
  * @soc: Handle to DP SoC structure
  * @desc_pool_id: ID of the flow control fool
@@ -302,84 +399,18 @@ dp_tx_adjust_flow_pool_state(struct dp_soc *soc,
  * Return: TX descriptor allocated or NULL
  */
 static inline struct dp_tx_desc_s *
-dp_tx_desc_alloc(struct dp_soc *soc, uint8_t desc_pool_id)
+__dp_tx_desc_alloc(struct dp_soc *soc, uint8_t desc_pool_id)
 {
 	struct dp_tx_desc_s *tx_desc = NULL;
 	struct dp_tx_desc_pool_s *pool = &soc->tx_desc[desc_pool_id];
-	bool is_pause = false;
-	enum netif_action_type act = WLAN_NETIF_ACTION_TYPE_NONE;
-	enum dp_fl_ctrl_threshold level = DP_TH_BE_BK;
-	enum netif_reason_type reason;
 
 	if (qdf_likely(pool)) {
 		qdf_spin_lock_bh(&pool->flow_pool_lock);
-		if (qdf_likely(pool->avail_desc &&
-		    pool->status != FLOW_POOL_INVALID &&
-		    pool->status != FLOW_POOL_INACTIVE)) {
-			tx_desc = dp_tx_get_desc_flow_pool(pool);
-			tx_desc->pool_id = desc_pool_id;
-			tx_desc->flags = DP_TX_DESC_FLAG_ALLOCATED;
-			dp_tx_desc_set_magic(tx_desc,
-					     DP_TX_MAGIC_PATTERN_INUSE);
-			is_pause = dp_tx_is_threshold_reached(pool,
-							      pool->avail_desc);
-
-			if (qdf_unlikely(pool->status ==
-					 FLOW_POOL_ACTIVE_UNPAUSED_REATTACH)) {
-				dp_tx_adjust_flow_pool_state(soc, pool);
-				is_pause = false;
-			}
-
-			if (qdf_unlikely(is_pause)) {
-				switch (pool->status) {
-				case FLOW_POOL_ACTIVE_UNPAUSED:
-					/* pause network BE\BK queue */
-					act = WLAN_NETIF_BE_BK_QUEUE_OFF;
-					reason = WLAN_DATA_FLOW_CTRL_BE_BK;
-					level = DP_TH_BE_BK;
-					pool->status = FLOW_POOL_BE_BK_PAUSED;
-					break;
-				case FLOW_POOL_BE_BK_PAUSED:
-					/* pause network VI queue */
-					act = WLAN_NETIF_VI_QUEUE_OFF;
-					reason = WLAN_DATA_FLOW_CTRL_VI;
-					level = DP_TH_VI;
-					pool->status = FLOW_POOL_VI_PAUSED;
-					break;
-				case FLOW_POOL_VI_PAUSED:
-					/* pause network VO queue */
-					act = WLAN_NETIF_VO_QUEUE_OFF;
-					reason = WLAN_DATA_FLOW_CTRL_VO;
-					level = DP_TH_VO;
-					pool->status = FLOW_POOL_VO_PAUSED;
-					break;
-				case FLOW_POOL_VO_PAUSED:
-					/* pause network HI PRI queue */
-					act = WLAN_NETIF_PRIORITY_QUEUE_OFF;
-					reason = WLAN_DATA_FLOW_CTRL_PRI;
-					level = DP_TH_HI;
-					pool->status = FLOW_POOL_ACTIVE_PAUSED;
-					break;
-				case FLOW_POOL_ACTIVE_PAUSED:
-					act = WLAN_NETIF_ACTION_TYPE_NONE;
-					break;
-				default:
-					dp_err_rl("pool status is %d!",
-						  pool->status);
-					break;
-				}
-
-				if (act != WLAN_NETIF_ACTION_TYPE_NONE) {
-					pool->latest_pause_time[level] =
-						qdf_get_system_timestamp();
-					soc->pause_cb(desc_pool_id,
-						      act,
-						      reason);
-				}
-			}
-		} else {
+		if (qdf_likely(dp_tx_desc_pool_has_free(pool)))
+			tx_desc = dp_tx_desc_get_locked(soc, pool,
+							desc_pool_id);
+		else
 			pool->pkt_drop_no_desc++;
-		}
 		qdf_spin_unlock_bh(&pool->flow_pool_lock);
 	} else {
 		dp_err_rl("NULL desc pool pool_id %d", desc_pool_id);
@@ -390,24 +421,63 @@ dp_tx_desc_alloc(struct dp_soc *soc, uint8_t desc_pool_id)
 }
 
 /**
- * dp_tx_desc_free() - Fee a tx descriptor and attach it to free list
+ * dp_tx_desc_pool_get_batch() - Take descriptors off a pool in one go
  *
  * @soc: Handle to DP SoC structure
- * @tx_desc: the tx descriptor to be freed
- * @desc_pool_id: ID of the flow control fool
+ * @desc_pool_id: ID of the flow control pool
+ * @descs: array to fill
+ * @num: number of descriptors wanted
  *
- * Return: None
+ * Flow control is applied per descriptor, exactly as for single
+ * allocations. The descriptors are returned without
+ * DP_TX_DESC_FLAG_ALLOCATED set.
+ *
+ * Return: number of descriptors taken
  */
-static inline void
-dp_tx_desc_free(struct dp_soc *soc, struct dp_tx_desc_s *tx_desc,
-		uint8_t desc_pool_id)
+static inline uint16_t
+dp_tx_desc_pool_get_batch(struct dp_soc *soc, uint8_t desc_pool_id,
+			  struct dp_tx_desc_s **descs, uint16_t num)
 {
 	struct dp_tx_desc_pool_s *pool = &soc->tx_desc[desc_pool_id];
+	struct dp_tx_desc_s *tx_desc;
+	uint16_t count = 0;
+
+	qdf_spin_lock_bh(&pool->flow_pool_lock);
+	while (count < num && dp_tx_desc_pool_has_free(pool)) {
+		tx_desc = dp_tx_desc_get_locked(soc, pool, desc_pool_id);
+		/* Free until dp_tx_desc_alloc() hands it out */
+		tx_desc->flags = 0;
+		dp_tx_desc_set_magic(tx_desc, DP_TX_MAGIC_PATTERN_FREE);
+		descs[count++] = tx_desc;
+	}
+	if (!count)
+		pool->pkt_drop_no_desc++;
+	qdf_spin_unlock_bh(&pool->flow_pool_lock);
+
+	return count;
+}
+
+/**
+ * dp_tx_desc_put_locked() - Return a descriptor and apply flow control
+ *
+ * @soc: Handle to DP SoC structure
+ * @pool: flow pool
+ * @tx_desc: the tx descriptor to be freed
+ * @desc_pool_id: ID of the flow control pool
+ *
+ * Caller needs to take lock.
+ *
+ * Return: true if this was the last descriptor of an invalid pool and
+ *	   the pool has been freed
+ */
+static inline bool
+dp_tx_desc_put_locked(struct dp_soc *soc, struct dp_tx_desc_pool_s *pool,
+		      struct dp_tx_desc_s *tx_desc, uint8_t desc_pool_id)
+{
 	qdf_time_t unpause_time = qdf_get_system_timestamp(), pause_dur;
 	enum netif_action_type act = WLAN_WAKE_ALL_NETIF_QUEUE;
 	enum netif_reason_type reason;
 
-	qdf_spin_lock_bh(&pool->flow_pool_lock);
 	tx_desc->vdev_id = DP_INVALID_VDEV_ID;
 	tx_desc->nbuf = NULL;
 	tx_desc->flags = 0;
@@ -470,11 +540,7 @@ dp_tx_desc_free(struct dp_soc *soc, struct dp_tx_desc_s *tx_desc,
 		if (pool->avail_desc == pool->pool_size) {
 			dp_tx_desc_pool_deinit(soc, desc_pool_id);
 			dp_tx_desc_pool_free(soc, desc_pool_id);
-			qdf_spin_unlock_bh(&pool->flow_pool_lock);
-			QDF_TRACE(QDF_MODULE_ID_DP, QDF_TRACE_LEVEL_ERROR,
-				  "%s %d pool is freed!!",
-				  __func__, __LINE__);
-			return;
+			return true;
 		}
 		break;
 
@@ -490,7 +556,34 @@ dp_tx_desc_free(struct dp_soc *soc, struct dp_tx_desc_s *tx_desc,
 	if (act != WLAN_WAKE_ALL_NETIF_QUEUE)
 		soc->pause_cb(pool->flow_pool_id,
 			      act, reason);
+
+	return false;
+}
+
+/**
+ * __dp_tx_desc_free() - Fee a tx descriptor and attach it to free list
+ *
+ * @soc: Handle to DP SoC structure
+ * @tx_desc: the tx descriptor to be freed
+ * @desc_pool_id: ID of the flow control fool
+ *
+ * Return: None
+ */
+static inline void
+__dp_tx_desc_free(struct dp_soc *soc, struct dp_tx_desc_s *tx_desc,
+		  uint8_t desc_pool_id)
+{
+	struct dp_tx_desc_pool_s *pool = &soc->tx_desc[desc_pool_id];
+	bool pool_freed;
+
+	qdf_spin_lock_bh(&pool->flow_pool_lock);
+	pool_freed = dp_tx_desc_put_locked(soc, pool, tx_desc, desc_pool_id);
 	qdf_spin_unlock_bh(&pool->flow_pool_lock);
+
+	if (pool_freed)
+		QDF_TRACE(QDF_MODULE_ID_DP, QDF_TRACE_LEVEL_ERROR,
+			  "%s %d pool is freed!!",
+			  __func__, __LINE__);
 }
 #else /* QCA_AC_BASED_FLOW_CONTROL */
 
@@ -504,7 +597,52 @@ dp_tx_is_threshold_reached(struct dp_tx_desc_pool_s *pool, uint16_t avail_desc)
 }
 
 /**
- * dp_tx_desc_alloc() - Allocate a Software Tx Descriptor from given pool
+ * dp_tx_desc_pool_has_free() - Check if a descriptor can be taken from pool
+ *
+ * @pool: flow pool
+ *
+ * Caller needs to take lock.
+ *
+ * Return: true if the pool is active and has a free descriptor
+ */
+static inline bool dp_tx_desc_pool_has_free(struct dp_tx_desc_pool_s *pool)
+{
+	return pool->status <= FLOW_POOL_ACTIVE_PAUSED && pool->avail_desc;
+}
+
+/**
+ * dp_tx_desc_get_locked() - Take a descriptor and apply flow control
+ *
+ * @soc: Handle to DP SoC structure
+ * @pool: flow pool
+ * @desc_pool_id: ID of the flow control pool
+ * @pause: set if the network queues need to be paused
+ *
+ * Caller needs to take lock and check dp_tx_desc_pool_has_free(), and
+ * to call pause_cb once the lock is dropped if @pause is set.
+ *
+ * Return: TX descriptor
+ */
+static inline struct dp_tx_desc_s *
+dp_tx_desc_get_locked(struct dp_soc *soc, struct dp_tx_desc_pool_s *pool,
+		      uint8_t desc_pool_id, bool *pause)
+{
+	struct dp_tx_desc_s *tx_desc;
+
+	tx_desc = dp_tx_get_desc_flow_pool(pool);
+	tx_desc->pool_id = desc_pool_id;
+	tx_desc->flags = DP_TX_DESC_FLAG_ALLOCATED;
+	dp_tx_desc_set_magic(tx_desc, DP_TX_MAGIC_PATTERN_INUSE);
+	if (qdf_unlikely(pool->avail_desc < pool->stop_th)) {
+		pool->status = FLOW_POOL_ACTIVE_PAUSED;
+		*pause = true;
+	}
+
+	return tx_desc;
+}
+
+/**
+ * __dp_tx_desc_alloc() - Allocate a Software Tx Descriptor from given pool
  *
  * @soc Handle to DP SoC structure
  * @pool_id
@@ -512,34 +650,26 @@ dp_tx_is_threshold_reached(struct dp_tx_desc_pool_s *pool, uint16_t avail_desc)
  * Return:
  */
 static inline struct dp_tx_desc_s *
-dp_tx_desc_alloc(struct dp_soc *soc, uint8_t desc_pool_id)
+__dp_tx_desc_alloc(struct dp_soc *soc, uint8_t desc_pool_id)
 {
 	struct dp_tx_desc_s *tx_desc = NULL;
 	struct dp_tx_desc_pool_s *pool = &soc->tx_desc[desc_pool_id];
+	bool pause = false;
 
 	if (pool) {
 		qdf_spin_lock_bh(&pool->flow_pool_lock);
-		if (pool->status <= FLOW_POOL_ACTIVE_PAUSED &&
-		    pool->avail_desc) {
-			tx_desc = dp_tx_get_desc_flow_pool(pool);
-			tx_desc->pool_id = desc_pool_id;
-			tx_desc->flags = DP_TX_DESC_FLAG_ALLOCATED;
-			dp_tx_desc_set_magic(tx_desc,
-					     DP_TX_MAGIC_PATTERN_INUSE);
-			if (qdf_unlikely(pool->avail_desc < pool->stop_th)) {
-				pool->status = FLOW_POOL_ACTIVE_PAUSED;
-				qdf_spin_unlock_bh(&pool->flow_pool_lock);
-				/* pause network queues */
-				soc->pause_cb(desc_pool_id,
-					       WLAN_STOP_ALL_NETIF_QUEUE,
-					       WLAN_DATA_FLOW_CONTROL);
-			} else {
-				qdf_spin_unlock_bh(&pool->flow_pool_lock);
-			}
-		} else {
+		if (dp_tx_desc_pool_has_free(pool))
+			tx_desc = dp_tx_desc_get_locked(soc, pool,
+							desc_pool_id, &pause);
+		else
 			pool->pkt_drop_no_desc++;
-			qdf_spin_unlock_bh(&pool->flow_pool_lock);
-		}
+		qdf_spin_unlock_bh(&pool->flow_pool_lock);
+
+		/* pause network queues */
+		if (qdf_unlikely(pause))
+			soc->pause_cb(desc_pool_id,
+				       WLAN_STOP_ALL_NETIF_QUEUE,
+				       WLAN_DATA_FLOW_CONTROL);
 	} else {
 		soc->pool_stats.pkt_drop_no_pool++;
 	}
@@ -548,21 +678,64 @@ dp_tx_desc_alloc(struct dp_soc *soc, uint8_t desc_pool_id)
 }
 
 /**
- * dp_tx_desc_free() - Fee a tx descriptor and attach it to free list
+ * dp_tx_desc_pool_get_batch() - Take descriptors off a pool in one go
  *
- * @soc Handle to DP SoC structure
- * @pool_id
- * @tx_desc
+ * @soc: Handle to DP SoC structure
+ * @desc_pool_id: ID of the flow control pool
+ * @descs: array to fill
+ * @num: number of descriptors wanted
  *
- * Return: None
+ * The descriptors are returned without DP_TX_DESC_FLAG_ALLOCATED set.
+ *
+ * Return: number of descriptors taken
  */
-static inline void
-dp_tx_desc_free(struct dp_soc *soc, struct dp_tx_desc_s *tx_desc,
-		uint8_t desc_pool_id)
+static inline uint16_t
+dp_tx_desc_pool_get_batch(struct dp_soc *soc, uint8_t desc_pool_id,
+			  struct dp_tx_desc_s **descs, uint16_t num)
 {
 	struct dp_tx_desc_pool_s *pool = &soc->tx_desc[desc_pool_id];
+	struct dp_tx_desc_s *tx_desc;
+	bool pause = false;
+	uint16_t count = 0;
 
 	qdf_spin_lock_bh(&pool->flow_pool_lock);
+	while (count < num && dp_tx_desc_pool_has_free(pool)) {
+		tx_desc = dp_tx_desc_get_locked(soc, pool, desc_pool_id,
+						&pause);
+		/* Free until dp_tx_desc_alloc() hands it out */
+		tx_desc->flags = 0;
+		dp_tx_desc_set_magic(tx_desc, DP_TX_MAGIC_PATTERN_FREE);
+		descs[count++] = tx_desc;
+	}
+	if (!count)
+		pool->pkt_drop_no_desc++;
+	qdf_spin_unlock_bh(&pool->flow_pool_lock);
+
+	if (qdf_unlikely(pause))
+		soc->pause_cb(desc_pool_id,
+			       WLAN_STOP_ALL_NETIF_QUEUE,
+			       WLAN_DATA_FLOW_CONTROL);
+
+	return count;
+}
+
+/**
+ * dp_tx_desc_put_locked() - Return a descriptor and apply flow control
+ *
+ * @soc: Handle to DP SoC structure
+ * @pool: flow pool
+ * @tx_desc: the tx descriptor to be freed
+ * @desc_pool_id: ID of the flow control pool
+ *
+ * Caller needs to take lock.
+ *
+ * Return: true if this was the last descriptor of an invalid pool and
+ *	   the pool has been freed
+ */
+static inline bool
+dp_tx_desc_put_locked(struct dp_soc *soc, struct dp_tx_desc_pool_s *pool,
+		      struct dp_tx_desc_s *tx_desc, uint8_t desc_pool_id)
+{
 	tx_desc->vdev_id = DP_INVALID_VDEV_ID;
 	tx_desc->nbuf = NULL;
 	tx_desc->flags = 0;
@@ -581,10 +754,7 @@ dp_tx_desc_free(struct dp_soc *soc, struct dp_tx_desc_s *tx_desc,
 		if (pool->avail_desc == pool->pool_size) {
 			dp_tx_desc_pool_deinit(soc, desc_pool_id);
 			dp_tx_desc_pool_free(soc, desc_pool_id);
-			qdf_spin_unlock_bh(&pool->flow_pool_lock);
-			qdf_print("%s %d pool is freed!!",
-				  __func__, __LINE__);
-			return;
+			return true;
 		}
 		break;
 
@@ -596,11 +766,63 @@ dp_tx_desc_free(struct dp_soc *soc, struct dp_tx_desc_s *tx_desc,
 		break;
 	};
 
+	return false;
+}
+
+/**
+ * __dp_tx_desc_free() - Fee a tx descriptor and attach it to free list
+ *
+ * @soc Handle to DP SoC structure
+ * @pool_id
+ * @tx_desc
+ *
+ * Return: None
+ */
+static inline void
+__dp_tx_desc_free(struct dp_soc *soc, struct dp_tx_desc_s *tx_desc,
+		  uint8_t desc_pool_id)
+{
+	struct dp_tx_desc_pool_s *pool = &soc->tx_desc[desc_pool_id];
+	bool pool_freed;
+
+	qdf_spin_lock_bh(&pool->flow_pool_lock);
+	pool_freed = dp_tx_desc_put_locked(soc, pool, tx_desc, desc_pool_id);
 	qdf_spin_unlock_bh(&pool->flow_pool_lock);
+
+	if (pool_freed)
+		qdf_print("%s %d pool is freed!!", __func__, __LINE__);
 }
 
 #endif /* QCA_AC_BASED_FLOW_CONTROL */
 
+/**
+ * dp_tx_desc_pool_put_batch() - Return descriptors to a pool in one go
+ *
+ * @soc: Handle to DP SoC structure
+ * @desc_pool_id: ID of the flow control pool
+ * @descs: descriptors to free
+ * @num: number of descriptors in @descs
+ *
+ * Return: None
+ */
+static inline void
+dp_tx_desc_pool_put_batch(struct dp_soc *soc, uint8_t desc_pool_id,
+			  struct dp_tx_desc_s **descs, uint16_t num)
+{
+	struct dp_tx_desc_pool_s *pool = &soc->tx_desc[desc_pool_id];
+	bool pool_freed = false;
+	uint16_t i;
+
+	qdf_spin_lock_bh(&pool->flow_pool_lock);
+	for (i = 0; i < num && !pool_freed; i++)
+		pool_freed = dp_tx_desc_put_locked(soc, pool, descs[i],
+						   desc_pool_id);
+	qdf_spin_unlock_bh(&pool->flow_pool_lock);
+
+	if (pool_freed)
+		dp_info("pool %d is freed", desc_pool_id);
+}
+
 static inline bool
 dp_tx_desc_thresh_reached(struct cdp_soc_t *soc_hdl, uint8_t vdev_id)
 {
@@ -656,15 +878,15 @@ void dp_tx_prefetch_desc(struct dp_tx_desc_s *tx_desc)
 #endif
 
 /**
- * dp_tx_desc_alloc() - Allocate a Software Tx Descriptor from given pool
+ * __dp_tx_desc_alloc() - Allocate a Software Tx Descriptor from given pool
  *
  * @param soc Handle to DP SoC structure
  * @param pool_id
  *
  * Return:
  */
-static inline struct dp_tx_desc_s *dp_tx_desc_alloc(struct dp_soc *soc,
-						uint8_t desc_pool_id)
+static inline struct dp_tx_desc_s *__dp_tx_desc_alloc(struct dp_soc *soc,
+						      uint8_t desc_pool_id)
 {
 	struct dp_tx_desc_s *tx_desc = NULL;
 	struct dp_tx_desc_pool_s *pool = &soc->tx_desc[desc_pool_id];
@@ -741,15 +963,15 @@ static inline struct dp_tx_desc_s *dp_tx_desc_alloc_multiple(
 }
 
 /**
- * dp_tx_desc_free() - Fee a tx descriptor and attach it to free list
+ * __dp_tx_desc_free() - Fee a tx descriptor and attach it to free list
  *
  * @soc Handle to DP SoC structure
  * @pool_id
  * @tx_desc
  */
 static inline void
-dp_tx_desc_free(struct dp_soc *soc, struct dp_tx_desc_s *tx_desc,
-		uint8_t desc_pool_id)
+__dp_tx_desc_free(struct dp_soc *soc, struct dp_tx_desc_s *tx_desc,
+		  uint8_t desc_pool_id)
 {
 	struct dp_tx_desc_pool_s *pool = NULL;
 	tx_desc->vdev_id = DP_INVALID_VDEV_ID;
@@ -765,8 +987,262 @@ dp_tx_desc_free(struct dp_soc *soc, struct dp_tx_desc_s *tx_desc,
 	TX_DESC_LOCK_UNLOCK(&pool->lock);
 }
 
+/**
+ * dp_tx_desc_pool_get_batch() - Take descriptors off a pool in one go
+ * @soc: Handle to DP SoC structure
+ * @desc_pool_id: pool to take descriptors from
+ * @descs: array to fill
+ * @num: number of descriptors wanted
+ *
+ * The descriptors are returned without DP_TX_DESC_FLAG_ALLOCATED set.
+ *
+ * Return: number of descriptors taken
+ */
+static inline uint16_t
+dp_tx_desc_pool_get_batch(struct dp_soc *soc, uint8_t desc_pool_id,
+			  struct dp_tx_desc_s **descs, uint16_t num)
+{
+	struct dp_tx_desc_pool_s *pool = &soc->tx_desc[desc_pool_id];
+	uint16_t count = 0;
+
+	TX_DESC_LOCK_LOCK(&pool->lock);
+	while (count < num && pool->freelist) {
+		descs[count++] = pool->freelist;
+		pool->freelist = pool->freelist->next;
+	}
+	pool->num_allocated += count;
+	pool->num_free -= count;
+	TX_DESC_LOCK_UNLOCK(&pool->lock);
+
+	return count;
+}
+
+/**
+ * dp_tx_desc_pool_put_batch() - Return descriptors to a pool in one go
+ * @soc: Handle to DP SoC structure
+ * @desc_pool_id: pool the descriptors belong to
+ * @descs: descriptors to free
+ * @num: number of descriptors in @descs
+ *
+ * Return: None
+ */
+static inline void
+dp_tx_desc_pool_put_batch(struct dp_soc *soc, uint8_t desc_pool_id,
+			  struct dp_tx_desc_s **descs, uint16_t num)
+{
+	struct dp_tx_desc_pool_s *pool = &soc->tx_desc[desc_pool_id];
+	uint16_t i;
+
+	for (i = 0; i < num; i++) {
+		descs[i]->vdev_id = DP_INVALID_VDEV_ID;
+		descs[i]->nbuf = NULL;
+		descs[i]->flags = 0;
+	}
+
+	TX_DESC_LOCK_LOCK(&pool->lock);
+	for (i = 0; i < num; i++) {
+		descs[i]->next = pool->freelist;
+		pool->freelist = descs[i];
+	}
+	pool->num_allocated -= num;
+	pool->num_free += num;
+	TX_DESC_LOCK_UNLOCK(&pool->lock);
+}
+
 #endif /* QCA_LL_TX_FLOW_CONTROL_V2 */
 
+#ifdef DP_TX_DESC_PCPU_CACHE
+void dp_tx_desc_mag_init(struct dp_soc *soc);
+void dp_tx_desc_mag_deinit(struct dp_soc *soc);
+void dp_tx_desc_mag_drain(struct dp_soc *soc, uint8_t desc_pool_id);
+void dp_tx_desc_mag_drain_all(struct dp_soc *soc);
+
+/**
+ * dp_tx_desc_pool_cacheable() - Check if descriptors may be cached per CPU
+ * @pool: Tx descriptor pool
+ *
+ * Frees bypass the magazines while a flow pool is paused or going away,
+ * so that flow control sees every descriptor coming back. Descriptors
+ * parked in magazines are accounted as in use, so pausing can happen up
+ * to DP_TX_DESC_MAG_MAX_CPUS magazines early; small pools are not cached
+ * at all to keep that error bounded.
+ *
+ * Return: true if descriptors of @pool can be kept in magazines
+ */
+#ifdef QCA_LL_TX_FLOW_CONTROL_V2
+static inline bool dp_tx_desc_pool_cacheable(struct dp_tx_desc_pool_s *pool)
+{
+	return pool->status == FLOW_POOL_ACTIVE_UNPAUSED &&
+	       pool->pool_size >= DP_TX_DESC_MAG_MIN_POOL_SIZE;
+}
+#else
+static inline bool dp_tx_desc_pool_cacheable(struct dp_tx_desc_pool_s *pool)
+{
+	return pool->num_free + pool->num_allocated >=
+	       DP_TX_DESC_MAG_MIN_POOL_SIZE;
+}
+#endif
+
+/**
+ * dp_tx_desc_mag_get() - Get the magazine of the current CPU for a pool
+ * @soc: Handle to DP SoC structure
+ * @desc_pool_id: Tx descriptor pool
+ *
+ * Return: magazine or NULL if this CPU has none
+ */
+static inline struct dp_tx_desc_mag *
+dp_tx_desc_mag_get(struct dp_soc *soc, uint8_t desc_pool_id)
+{
+	int cpu = qdf_get_cpu();
+
+	if (qdf_unlikely(cpu >= DP_TX_DESC_MAG_MAX_CPUS))
+		return NULL;
+
+	return &soc->tx_desc_mag[desc_pool_id][cpu];
+}
+
+/**
+ * dp_tx_desc_alloc() - Allocate a Software Tx Descriptor
+ * @soc: Handle to DP SoC structure
+ * @desc_pool_id: Tx descriptor pool
+ *
+ * Serve the allocation from the magazine of the current CPU and refill
+ * the magazine with a batch from the pool when it runs empty.
+ *
+ * Return: Tx descriptor or NULL
+ */
+static inline struct dp_tx_desc_s *
+dp_tx_desc_alloc(struct dp_soc *soc, uint8_t desc_pool_id)
+{
+	struct dp_tx_desc_pool_s *pool = &soc->tx_desc[desc_pool_id];
+	struct dp_tx_desc_mag *mag = dp_tx_desc_mag_get(soc, desc_pool_id);
+	struct dp_tx_desc_s *tx_desc;
+
+	if (qdf_unlikely(!mag))
+		return __dp_tx_desc_alloc(soc, desc_pool_id);
+
+	qdf_spin_lock_bh(&mag->lock);
+	if (qdf_unlikely(!mag->count)) {
+		if (!dp_tx_desc_pool_cacheable(pool)) {
+			qdf_spin_unlock_bh(&mag->lock);
+			return __dp_tx_desc_alloc(soc, desc_pool_id);
+		}
+
+		mag->alloc_miss++;
+		mag->count = dp_tx_desc_pool_get_batch(soc, desc_pool_id,
+						       mag->descs,
+						       DP_TX_DESC_MAG_BATCH);
+		if (qdf_unlikely(!mag->count)) {
+			qdf_spin_unlock_bh(&mag->lock);
+			return NULL;
+		}
+	} else {
+		mag->alloc_hit++;
+	}
+	tx_desc = mag->descs[--mag->count];
+	qdf_spin_unlock_bh(&mag->lock);
+
+	/*
+	 * Cached descriptors are free, only now does a flush see this one.
+	 * The caller sets the pdev, drop the one from its last use.
+	 */
+	tx_desc->pool_id = desc_pool_id;
+	tx_desc->pdev = NULL;
+	tx_desc->flags = DP_TX_DESC_FLAG_ALLOCATED;
+	dp_tx_desc_set_magic(tx_desc, DP_TX_MAGIC_PATTERN_INUSE);
+
+	return tx_desc;
+}
+
+/**
+ * dp_tx_desc_free() - Free a Tx descriptor
+ * @soc: Handle to DP SoC structure
+ * @tx_desc: descriptor to free
+ * @desc_pool_id: Tx descriptor pool
+ *
+ * Park the descriptor in the magazine of the current CPU. A full
+ * magazine gives its older half back to the pool; a pool that cannot
+ * be cached gets the whole magazine back along with @tx_desc.
+ *
+ * Return: None
+ */
+static inline void
+dp_tx_desc_free(struct dp_soc *soc, struct dp_tx_desc_s *tx_desc,
+		uint8_t desc_pool_id)
+{
+	struct dp_tx_desc_pool_s *pool = &soc->tx_desc[desc_pool_id];
+	struct dp_tx_desc_mag *mag = dp_tx_desc_mag_get(soc, desc_pool_id);
+	struct dp_tx_desc_s *flush[DP_TX_DESC_MAG_SIZE + 1];
+	uint16_t num_flush;
+
+	if (qdf_unlikely(!mag)) {
+		__dp_tx_desc_free(soc, tx_desc, desc_pool_id);
+		return;
+	}
+
+	tx_desc->vdev_id = DP_INVALID_VDEV_ID;
+	tx_desc->nbuf = NULL;
+	tx_desc->flags = 0;
+	dp_tx_desc_set_magic(tx_desc, DP_TX_MAGIC_PATTERN_FREE);
+
+	qdf_spin_lock_bh(&mag->lock);
+	if (qdf_likely(dp_tx_desc_pool_cacheable(pool))) {
+		if (qdf_likely(mag->count < DP_TX_DESC_MAG_SIZE)) {
+			mag->descs[mag->count++] = tx_desc;
+			mag->free_hit++;
+			qdf_spin_unlock_bh(&mag->lock);
+			return;
+		}
+
+		mag->free_flush++;
+		num_flush = DP_TX_DESC_MAG_BATCH;
+		qdf_mem_copy(flush, mag->descs, num_flush * sizeof(*flush));
+		mag->count -= num_flush;
+		qdf_mem_move(mag->descs, &mag->descs[num_flush],
+			     mag->count * sizeof(*flush));
+		mag->descs[mag->count++] = tx_desc;
+	} else {
+		num_flush = mag->count;
+		qdf_mem_copy(flush, mag->descs, num_flush * sizeof(*flush));
+		mag->count = 0;
+		flush[num_flush++] = tx_desc;
+	}
+	qdf_spin_unlock_bh(&mag->lock);
+
+	dp_tx_desc_pool_put_batch(soc, desc_pool_id, flush, num_flush);
+}
+#else
+static inline void dp_tx_desc_mag_init(struct dp_soc *soc)
+{
+}
+
+static inline void dp_tx_desc_mag_deinit(struct dp_soc *soc)
+{
+}
+
+static inline void dp_tx_desc_mag_drain(struct dp_soc *soc,
+					uint8_t desc_pool_id)
+{
+}
+
+static inline void dp_tx_desc_mag_drain_all(struct dp_soc *soc)
+{
+}
+
+static inline struct dp_tx_desc_s *
+dp_tx_desc_alloc(struct dp_soc *soc, uint8_t desc_pool_id)
+{
+	return __dp_tx_desc_alloc(soc, desc_pool_id);
+}
+
+static inline void
+dp_tx_desc_free(struct dp_soc *soc, struct dp_tx_desc_s *tx_desc,
+		uint8_t desc_pool_id)
+{
+	__dp_tx_desc_free(soc, tx_desc, desc_pool_id);
+}
+#endif /* DP_TX_DESC_PCPU_CACHE */
+
 #ifdef QCA_DP_TX_DESC_ID_CHECK
 /**
  * dp_tx_is_desc_id_valid() - check is the tx desc id valid
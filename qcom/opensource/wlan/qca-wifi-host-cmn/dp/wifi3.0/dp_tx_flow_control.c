@@ -464,6 +464,9 @@ int dp_tx_delete_flow_pool(struct dp_soc *soc, struct dp_tx_desc_pool_s *pool,
 		return -EAGAIN;
 	}
 
+	/* Pull back descriptors parked in the per-CPU caches first */
+	dp_tx_desc_mag_drain(soc, pool->flow_pool_id);
+
 	qdf_spin_lock_bh(&pool->flow_pool_lock);
 	if (!pool->pool_create_cnt) {
 		qdf_spin_unlock_bh(&pool->flow_pool_lock);
@@ -484,6 +487,11 @@ int dp_tx_delete_flow_pool(struct dp_soc *soc, struct dp_tx_desc_pool_s *pool,
 		dp_tx_flow_ctrl_reset_subqueues(soc, pool, pool_status);
 
 		qdf_spin_unlock_bh(&pool->flow_pool_lock);
+		/*
+		 * Frees racing with the drain above may have cached more;
+		 * no new ones are cached now that the pool is invalid.
+		 */
+		dp_tx_desc_mag_drain(soc, pool->flow_pool_id);
 		/* Reset TX desc associated to this Vdev as NULL */
 		vdev = dp_vdev_get_ref_by_id(soc, pool->flow_pool_id,
 					     DP_MOD_ID_MISC);
@@ -27,6 +27,7 @@
 #include <qdf_util.h>
 #include <qdf_list.h>
 #include <qdf_lro.h>
+#include <qdf_rcu.h>
 #include <queue.h>
 #include <htt_common.h>
 #include <htt.h>
@@ -733,6 +734,42 @@ struct dp_tx_desc_pool_s {
 #endif
 };
 
+#ifdef DP_TX_DESC_PCPU_CACHE
+/* Descriptors a per-CPU magazine can hold */
+#define DP_TX_DESC_MAG_SIZE 32
+/* Descriptors moved between a magazine and its pool at a time */
+#define DP_TX_DESC_MAG_BATCH (DP_TX_DESC_MAG_SIZE / 2)
+/* CPUs beyond this use the pool directly */
+#define DP_TX_DESC_MAG_MAX_CPUS CDP_NR_CPUS
+/* Pools smaller than this are not worth caching in front of */
+#define DP_TX_DESC_MAG_MIN_POOL_SIZE \
+	(4 * DP_TX_DESC_MAG_SIZE * DP_TX_DESC_MAG_MAX_CPUS)
+
+/**
+ * struct dp_tx_desc_mag - per-CPU cache of free Tx descriptors
+ * @lock: magazine lock, only contended when the pool drains the magazine
+ * @count: number of descriptors in @descs
+ * @descs: cached descriptors, used as a stack
+ * @alloc_hit: allocations served from the magazine
+ * @alloc_miss: allocations that refilled the magazine from the pool
+ * @free_hit: frees absorbed by the magazine
+ * @free_flush: frees that flushed a batch back to the pool
+ *
+ * Descriptors in a magazine have already been taken off the pool
+ * freelist, so the pool accounts them as in use. Each magazine is
+ * written by its own CPU, so it is kept on cache lines of its own.
+ */
+struct dp_tx_desc_mag {
+	qdf_spinlock_t lock;
+	uint16_t count;
+	struct dp_tx_desc_s *descs[DP_TX_DESC_MAG_SIZE];
+	uint32_t alloc_hit;
+	uint32_t alloc_miss;
+	uint32_t free_hit;
+	uint32_t free_flush;
+} qdf_cacheline_aligned;
+#endif
+
 /**
  * struct dp_txrx_pool_stats - flow pool related statistics
  * @pool_map_count: flow pool map received
@@ -802,6 +839,9 @@ struct dp_peer_delay_stats {
 						  [CDP_MAX_TXRX_CTX];
 };
 
+/* Fragment number is a 4 bit field of the sequence control */
+#define DP_RX_DEFRAG_MAX_FRAGS 16
+
 /* Rx TID defrag*/
 struct dp_rx_tid_defrag {
 	/* TID */
@@ -809,14 +849,24 @@ struct dp_rx_tid_defrag {
 
 	/* only used for defrag right now */
 	TAILQ_ENTRY(dp_rx_tid_defrag) defrag_waitlist_elem;
+	/* set while linked on the soc defrag waitlist */
+	bool on_waitlist;
 
 	/* Store dst desc for reinjection */
 	hal_ring_desc_t dst_ring_desc;
 	struct dp_rx_desc *head_frag_desc;
 
-	/* Sequence and fragments that are being processed currently */
+	/* Sequence that is being processed currently */
 	uint32_t curr_seq_num;
-	uint32_t curr_frag_num;
+
+	/* Fragments of the current sequence, indexed by fragment number */
+	qdf_nbuf_t frags[DP_RX_DEFRAG_MAX_FRAGS];
+	/* Bit n is set if frags[n] holds a fragment */
+	uint16_t frag_bitmap;
+	/* frag_bitmap value once all fragments up to the one with
+	 * more_frag clear are in, 0 until that fragment is received
+	 */
+	uint16_t frag_complete_mask;
 
 	/* TODO: Check the following while adding defragmentation support */
 	struct dp_rx_reorder_array_elem *array;
@@ -2398,6 +2448,11 @@ struct dp_soc {
 
 	/* Tx SW descriptor pool */
 	struct dp_tx_desc_pool_s tx_desc[MAX_TXDESC_POOLS];
+#ifdef DP_TX_DESC_PCPU_CACHE
+	/* Per-CPU Tx SW descriptor caches, in front of tx_desc */
+	struct dp_tx_desc_mag tx_desc_mag[MAX_TXDESC_POOLS]
+					 [DP_TX_DESC_MAG_MAX_CPUS];
+#endif
 
 	/* Tx MSDU Extension descriptor pool */
 	struct dp_tx_ext_desc_pool_s tx_ext_desc[MAX_TXDESC_POOLS];
@@ -2502,7 +2557,7 @@ struct dp_soc {
 	struct {
 		unsigned mask;
 		unsigned idx_bits;
-		TAILQ_HEAD(, dp_peer) * bins;
+		struct dp_peer_hash_bin *bins;
 	} peer_hash;
 
 	/* rx defrag state – TBD: do we need this per radio? */
@@ -2538,7 +2593,7 @@ struct dp_soc {
 		qdf_dma_mem_context(memctx);
 	} me_buf;
 
-	/* Protect peer hash table */
+	/* Serialize peer hash table writers; lookups are RCU protected */
 	DP_MUTEX_TYPE peer_hash_lock;
 	/* Protect peer_id_to_objmap */
 	DP_MUTEX_TYPE peer_map_lock;
@@ -4352,11 +4407,35 @@ struct dp_peer_stats {
 #endif
 };
 
+#ifdef DP_PEER_RX_RING_STATS
+/**
+ * struct dp_peer_rx_ring_stats - Per MSDU peer Rx counters of one REO ring
+ * @to_stack: Packets sent up the stack
+ * @rcvd: Packets received on the ring
+ * @non_amsdu_cnt: Number of MSDUs with no MSDU level aggregation
+ * @amsdu_cnt: Number of MSDUs part of AMSDU
+ * @rx_retries: Retries of packet in rx
+ *
+ * Written only from the ring's own Rx context, and kept on a cache line
+ * of its own so that rings serving the same peer do not share lines.
+ * These are deltas on top of the txrx_peer counters; readers add them.
+ */
+struct dp_peer_rx_ring_stats {
+	struct cdp_pkt_info to_stack;
+	struct cdp_pkt_info rcvd;
+	uint32_t non_amsdu_cnt;
+	uint32_t amsdu_cnt;
+	uint32_t rx_retries;
+} qdf_cacheline_aligned;
+#endif
+
 /**
  * struct dp_txrx_peer: DP txrx_peer structure used in per pkt path
  * @tx_failed: Total Tx failure
  * @cdp_pkt_info comp_pkt: Pkt Info for which completions were received
  * @to_stack: Total packets sent up the stack
+ * @rx_ring_stats: Per REO ring Rx counter deltas
+ * @mem_unaligned: allocation this txrx_peer was aligned in, to be freed
  * @stats: Peer stats
  * @delay_stats: Peer delay stats
  * @jitter_stats: Peer jitter stats
@@ -4380,6 +4459,10 @@ struct dp_txrx_peer {
 	uint32_t tx_failed;
 	struct cdp_pkt_info comp_pkt;
 	struct cdp_pkt_info to_stack;
+#ifdef DP_PEER_RX_RING_STATS
+	struct dp_peer_rx_ring_stats rx_ring_stats[CDP_MAX_RX_RINGS];
+	void *mem_unaligned;
+#endif
 
 	struct dp_peer_stats stats;
 
@@ -4423,6 +4506,17 @@ struct dp_txrx_peer {
 #endif
 };
 
+/**
+ * struct dp_peer_hash_bin - bucket of the soc peer hash table
+ * @head: RCU protected list of link peers hashing to this bucket
+ * @seq: bumped around every insert/remove so that a lockless lookup can
+ *	 tell a genuine miss from a race with a writer
+ */
+struct dp_peer_hash_bin {
+	struct qdf_hlist_head head;
+	struct qdf_seqcount seq;
+};
+
 /* Peer structure for data path state */
 struct dp_peer {
 	struct dp_txrx_peer *txrx_peer;
@@ -4443,8 +4537,12 @@ struct dp_peer {
 
 	/* node in the vdev's list of peers */
 	TAILQ_ENTRY(dp_peer) peer_list_elem;
-	/* node in the hash table bin's list of peers */
+	/* node in the MLD hash table bin's list of peers */
 	TAILQ_ENTRY(dp_peer) hash_list_elem;
+	/* node in the soc hash table bin's list of peers */
+	struct qdf_hlist_node hash_node;
+	/* defers the free until lockless hash lookups are done with it */
+	struct qdf_rcu_head rcu;
 
 	/* TID structures pointer */
 	struct dp_rx_tid *rx_tid;
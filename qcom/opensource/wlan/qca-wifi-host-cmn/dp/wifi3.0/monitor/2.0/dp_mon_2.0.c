@@ -116,9 +116,7 @@ QDF_STATUS dp_mon_pdev_ext_init_2_0(struct dp_pdev *pdev)
 		dp_mon_err("failed to create rxmon wq mon_pdev: %pK", mon_pdev);
 		goto fail;
 	}
-	TAILQ_INIT(&mon_pdev_be->rx_mon_queue);
-
-	qdf_spinlock_create(&mon_pdev_be->rx_mon_wq_lock);
+	dp_rx_mon_ppdu_ring_init(&mon_pdev_be->rx_mon_ppdu_ring);
 
 	return QDF_STATUS_SUCCESS;
 
@@ -149,7 +147,6 @@ QDF_STATUS dp_mon_pdev_ext_deinit_2_0(struct dp_pdev *pdev)
 	qdf_disable_work(&mon_pdev_be->rx_mon_work);
 	dp_rx_mon_drain_wq(pdev);
 	mon_pdev_be->rx_mon_workqueue = NULL;
-	qdf_spinlock_destroy(&mon_pdev_be->rx_mon_wq_lock);
 
 	return QDF_STATUS_SUCCESS;
 }
@@ -26,12 +26,14 @@
 #include <dp_htt.h>
 #include <dp_mon.h>
 #include <dp_tx_mon_2.0.h>
+#include "dp_rx_mon_ppdu_ring.h"
 
 #define DP_MON_RING_FILL_LEVEL_DEFAULT 2048
 #define DP_MON_DATA_BUFFER_SIZE     2048
 #define DP_MON_DESC_MAGIC 0xdeadabcd
 #define DP_MON_MAX_STATUS_BUF 1200
 #define DP_MON_QUEUE_DEPTH_MAX 16
+
 #define DP_MON_MSDU_LOGGING 0
 #define DP_MON_MPDU_LOGGING 1
 
@@ -138,13 +140,13 @@ struct dp_mon_desc_pool {
  * @tx_mon_filter_length: tx monitor filter length
  * @tx_monitor_be: pointer to tx monitor be structure
  * @tx_stats: tx monitor drop stats
- * @rx_mon_wq_lock: Rx mon workqueue lock
  * @rx_mon_workqueue: Rx mon workqueue
  * @rx_mon_work: Rx mon work
- * @rx_mon_queue: RxMON queue
+ * @rx_mon_ppdu_ring: RxMON single producer single consumer ppdu info ring,
+ *		      filled from Rx mon ring processing (under mon_lock)
+ *		      and emptied by @rx_mon_work
  * @rx_mon_free_queue: RxMON ppdu info free element queue
  * @ppdu_info_lock: RxPPDU ppdu info queue lock
- * @rx_mon_queue_depth: RxMON queue depth
  * @desc_count: reaped status desc count
  * @status: reaped status buffer per ppdu
  * @lite_mon_rx_config: rx litemon config
@@ -161,14 +163,12 @@ struct dp_mon_pdev_be {
 	uint8_t tx_mon_filter_length;
 	struct dp_pdev_tx_monitor_be tx_monitor_be;
 	struct dp_tx_monitor_drop_stats tx_stats;
-	qdf_spinlock_t rx_mon_wq_lock;
 	qdf_workqueue_t *rx_mon_workqueue;
 	qdf_work_t rx_mon_work;
 
-	TAILQ_HEAD(, hal_rx_ppdu_info) rx_mon_queue;
+	struct dp_rx_mon_ppdu_ring rx_mon_ppdu_ring;
 	TAILQ_HEAD(, hal_rx_ppdu_info) rx_mon_free_queue;
 	qdf_spinlock_t ppdu_info_lock;
-	uint16_t rx_mon_queue_depth;
 	uint16_t desc_count;
 	struct dp_mon_desc *status[DP_MON_MAX_STATUS_BUF];
 #ifdef QCA_SUPPORT_LITE_MONITOR
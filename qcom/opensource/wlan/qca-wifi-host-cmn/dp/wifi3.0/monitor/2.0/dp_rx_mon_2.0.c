@@ -402,40 +402,6 @@ dp_rx_mon_free_ppdu_info(struct dp_pdev *pdev,
 	__dp_rx_mon_free_ppdu_info(mon_pdev, ppdu_info);
 }
 
-void dp_rx_mon_drain_wq(struct dp_pdev *pdev)
-{
-	struct dp_mon_pdev *mon_pdev;
-	struct hal_rx_ppdu_info *ppdu_info = NULL;
-	struct hal_rx_ppdu_info *temp_ppdu_info = NULL;
-	struct dp_mon_pdev_be *mon_pdev_be;
-
-	if (qdf_unlikely(!pdev)) {
-		dp_mon_debug("Pdev is NULL");
-		return;
-	}
-
-	mon_pdev = (struct dp_mon_pdev *)pdev->monitor_pdev;
-	if (qdf_unlikely(!mon_pdev)) {
-		dp_mon_debug("monitor pdev is NULL");
-		return;
-	}
-
-	mon_pdev_be = dp_get_be_mon_pdev_from_dp_mon_pdev(mon_pdev);
-
-	qdf_spin_lock_bh(&mon_pdev_be->rx_mon_wq_lock);
-	TAILQ_FOREACH_SAFE(ppdu_info,
-			   &mon_pdev_be->rx_mon_queue,
-			   ppdu_list_elem,
-			   temp_ppdu_info) {
-		mon_pdev_be->rx_mon_queue_depth--;
-		TAILQ_REMOVE(&mon_pdev_be->rx_mon_queue,
-			     ppdu_info, ppdu_list_elem);
-
-		dp_rx_mon_free_ppdu_info(pdev, ppdu_info);
-	}
-	qdf_spin_unlock_bh(&mon_pdev_be->rx_mon_wq_lock);
-}
-
 /**
  * dp_rx_mon_deliver_mpdu() - Deliver MPDU to osif layer
  *
@@ -564,6 +530,64 @@ dp_rx_mon_process_ppdu_info(struct dp_pdev *pdev,
 	dp_rx_mon_free_mpdu_queue(mon_pdev, ppdu_info);
 }
 
+/**
+ * dp_rx_mon_ppdu_ring_pop_all() - Empty the PPDU ring
+ * @pdev: DP pdev
+ * @mon_pdev_be: BE monitor pdev
+ * @process: process the ppdu info before freeing it, else only free it
+ *
+ * Only one consumer may run at a time: the Rx mon work, or the drain
+ * once the work is disabled.
+ *
+ * Return: None
+ */
+static void
+dp_rx_mon_ppdu_ring_pop_all(struct dp_pdev *pdev,
+			    struct dp_mon_pdev_be *mon_pdev_be,
+			    bool process)
+{
+	struct dp_mon_pdev *mon_pdev = pdev->monitor_pdev;
+	struct dp_rx_mon_ppdu_ring *ppdu_ring = &mon_pdev_be->rx_mon_ppdu_ring;
+	struct hal_rx_ppdu_info *ppdu_info;
+
+	while ((ppdu_info = dp_rx_mon_ppdu_ring_pop(ppdu_ring))) {
+		if (process) {
+			/*
+			 * Delivery used to run under rx_mon_wq_lock with BH
+			 * disabled, and osif_rx_mon and lite monitor expect
+			 * that. Keep it, one PPDU at a time.
+			 */
+			qdf_local_bh_disable();
+			dp_rx_mon_process_ppdu_info(pdev, ppdu_info);
+			__dp_rx_mon_free_ppdu_info(mon_pdev, ppdu_info);
+			qdf_local_bh_enable();
+		} else {
+			dp_rx_mon_free_ppdu_info(pdev, ppdu_info);
+		}
+	}
+}
+
+void dp_rx_mon_drain_wq(struct dp_pdev *pdev)
+{
+	struct dp_mon_pdev *mon_pdev;
+	struct dp_mon_pdev_be *mon_pdev_be;
+
+	if (qdf_unlikely(!pdev)) {
+		dp_mon_debug("Pdev is NULL");
+		return;
+	}
+
+	mon_pdev = (struct dp_mon_pdev *)pdev->monitor_pdev;
+	if (qdf_unlikely(!mon_pdev)) {
+		dp_mon_debug("monitor pdev is NULL");
+		return;
+	}
+
+	mon_pdev_be = dp_get_be_mon_pdev_from_dp_mon_pdev(mon_pdev);
+
+	dp_rx_mon_ppdu_ring_pop_all(pdev, mon_pdev_be, false);
+}
+
 /**
  * dp_rx_mon_process_ppdu ()-  Deferred monitor processing
  * This workqueue API handles:
@@ -578,8 +602,6 @@ void dp_rx_mon_process_ppdu(void *context)
 {
 	struct dp_pdev *pdev = (struct dp_pdev *)context;
 	struct dp_mon_pdev *mon_pdev;
-	struct hal_rx_ppdu_info *ppdu_info = NULL;
-	struct hal_rx_ppdu_info *temp_ppdu_info = NULL;
 	struct dp_mon_pdev_be *mon_pdev_be;
 
 	if (qdf_unlikely(!pdev)) {
@@ -595,18 +617,7 @@ void dp_rx_mon_process_ppdu(void *context)
 
 	mon_pdev_be = dp_get_be_mon_pdev_from_dp_mon_pdev(mon_pdev);
 
-	qdf_spin_lock_bh(&mon_pdev_be->rx_mon_wq_lock);
-	TAILQ_FOREACH_SAFE(ppdu_info,
-			   &mon_pdev_be->rx_mon_queue,
-			   ppdu_list_elem, temp_ppdu_info) {
-		TAILQ_REMOVE(&mon_pdev_be->rx_mon_queue,
-			     ppdu_info, ppdu_list_elem);
-
-		mon_pdev_be->rx_mon_queue_depth--;
-		dp_rx_mon_process_ppdu_info(pdev, ppdu_info);
-		__dp_rx_mon_free_ppdu_info(mon_pdev, ppdu_info);
-	}
-	qdf_spin_unlock_bh(&mon_pdev_be->rx_mon_wq_lock);
+	dp_rx_mon_ppdu_ring_pop_all(pdev, mon_pdev_be, true);
 }
 
 /**
@@ -632,19 +643,17 @@ dp_rx_mon_add_ppdu_info_to_wq(struct dp_pdev *pdev,
 		return QDF_STATUS_E_FAILURE;
 
 	if (qdf_likely(ppdu_info)) {
-		if (mon_pdev_be->rx_mon_queue_depth < DP_RX_MON_WQ_THRESHOLD) {
-			qdf_spin_lock_bh(&mon_pdev_be->rx_mon_wq_lock);
-			TAILQ_INSERT_TAIL(&mon_pdev_be->rx_mon_queue,
-					  ppdu_info, ppdu_list_elem);
-			mon_pdev_be->rx_mon_queue_depth++;
+		/* mon_lock keeps this single producer across MACs */
+		if (dp_rx_mon_ppdu_ring_push(&mon_pdev_be->rx_mon_ppdu_ring,
+					     ppdu_info)) {
 			mon_pdev->rx_mon_stats.total_ppdu_info_enq++;
 		} else {
 			mon_pdev->rx_mon_stats.total_ppdu_info_drop++;
 			dp_rx_mon_free_ppdu_info(pdev, ppdu_info);
 		}
-		qdf_spin_unlock_bh(&mon_pdev_be->rx_mon_wq_lock);
 
-		if (mon_pdev_be->rx_mon_queue_depth > DP_MON_QUEUE_DEPTH_MAX) {
+		if (dp_rx_mon_ppdu_ring_depth(&mon_pdev_be->rx_mon_ppdu_ring) >
+		    DP_MON_QUEUE_DEPTH_MAX) {
 			qdf_queue_work(0, mon_pdev_be->rx_mon_workqueue,
 				       &mon_pdev_be->rx_mon_work);
 		}
@@ -2075,6 +2084,7 @@ void dp_mon_rx_print_advanced_stats_2_0(struct dp_soc *soc,
 	struct dp_mon_soc *mon_soc = pdev->soc->monitor_soc;
 	struct dp_mon_pdev_be *mon_pdev_be =
 				dp_get_be_mon_pdev_from_dp_mon_pdev(mon_pdev);
+	struct dp_rx_mon_ppdu_ring *ppdu_ring = &mon_pdev_be->rx_mon_ppdu_ring;
 
 	rx_mon_stats = &mon_pdev->rx_mon_stats;
 
@@ -2102,8 +2112,8 @@ void dp_mon_rx_print_advanced_stats_2_0(struct dp_soc *soc,
 		       rx_mon_stats->status_buf_count);
 	DP_PRINT_STATS("pkt_buf_count = %d",
 		       rx_mon_stats->pkt_buf_count);
-	DP_PRINT_STATS("rx_mon_queue_depth= %d",
-		       mon_pdev_be->rx_mon_queue_depth);
+	DP_PRINT_STATS("rx_mon_queue_depth= %u",
+		       dp_rx_mon_ppdu_ring_depth(ppdu_ring));
 	DP_PRINT_STATS("empty_desc= %d",
 		       mon_pdev->rx_mon_stats.empty_desc_ppdu);
 	DP_PRINT_STATS("mpdu_dropped_due_invalid_decap= %d",
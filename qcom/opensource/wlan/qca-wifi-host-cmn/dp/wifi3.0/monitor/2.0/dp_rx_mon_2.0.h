@@ -49,7 +49,8 @@
 			    + (DP_RX_MON_TLV_HDR_MARKER_LEN)\
 			    + (DP_RX_MON_TLV_TOTAL_LEN))
 
-#define DP_RX_MON_WQ_THRESHOLD 128
+/* ppdu info pool size, every ppdu info fits in the PPDU handoff ring */
+#define DP_RX_MON_WQ_THRESHOLD DP_RX_MON_PPDU_RING_SIZE
 /*
  * dp_rx_mon_buffers_alloc() - allocate rx monitor buffers
  * @soc: DP soc handle
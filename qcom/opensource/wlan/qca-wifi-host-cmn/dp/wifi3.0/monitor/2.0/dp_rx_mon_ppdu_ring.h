@@ -0,0 +1,128 @@
+/*
+ * Copyright (c) 2026 Qualcomm Innovation Center, Inc. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#ifndef _DP_RX_MON_PPDU_RING_H_
+#define _DP_RX_MON_PPDU_RING_H_
+
+#include <qdf_atomic.h>
+#include <qdf_types.h>
+#include <qdf_util.h>
+
+/* PPDU handoff ring between Rx mon ring processing and work, power of 2 */
+#define DP_RX_MON_PPDU_RING_SIZE 128
+#define DP_RX_MON_PPDU_RING_MASK (DP_RX_MON_PPDU_RING_SIZE - 1)
+
+QDF_COMPILE_TIME_ASSERT(rx_mon_ppdu_ring_size,
+			(DP_RX_MON_PPDU_RING_SIZE &
+			 (DP_RX_MON_PPDU_RING_SIZE - 1)) == 0);
+
+struct hal_rx_ppdu_info;
+
+/**
+ * struct dp_rx_mon_ppdu_ring - single producer single consumer ring of
+ *				ppdu info
+ * @slots: ppdu info pointers, indexed by head/tail masked to the ring size
+ * @hp: free running head, written by the producer only
+ * @tp: free running tail, written by the consumer only
+ */
+struct dp_rx_mon_ppdu_ring {
+	struct hal_rx_ppdu_info *slots[DP_RX_MON_PPDU_RING_SIZE];
+	qdf_atomic_t hp;
+	qdf_atomic_t tp;
+};
+
+/**
+ * dp_rx_mon_ppdu_ring_init() - Reset the PPDU ring to empty
+ * @ring: PPDU ring
+ *
+ * Return: None
+ */
+static inline void dp_rx_mon_ppdu_ring_init(struct dp_rx_mon_ppdu_ring *ring)
+{
+	qdf_atomic_init(&ring->hp);
+	qdf_atomic_init(&ring->tp);
+}
+
+/**
+ * dp_rx_mon_ppdu_ring_depth() - Number of ppdu info in the PPDU ring
+ * @ring: PPDU ring
+ *
+ * Indices are free running; the difference stays correct across wrap.
+ *
+ * Return: ring depth
+ */
+static inline uint32_t
+dp_rx_mon_ppdu_ring_depth(struct dp_rx_mon_ppdu_ring *ring)
+{
+	return (uint32_t)qdf_atomic_read(&ring->hp) -
+	       (uint32_t)qdf_atomic_read(&ring->tp);
+}
+
+/**
+ * dp_rx_mon_ppdu_ring_push() - Producer side of the PPDU ring
+ * @ring: PPDU ring
+ * @ppdu_info: ppdu info to add
+ *
+ * Only one producer may run at a time.
+ *
+ * Return: true if added, false if the ring is full
+ */
+static inline bool
+dp_rx_mon_ppdu_ring_push(struct dp_rx_mon_ppdu_ring *ring,
+			 struct hal_rx_ppdu_info *ppdu_info)
+{
+	uint32_t hp = qdf_atomic_read(&ring->hp);
+	uint32_t tp = qdf_atomic_read(&ring->tp);
+
+	if (hp - tp >= DP_RX_MON_PPDU_RING_SIZE)
+		return false;
+
+	ring->slots[hp & DP_RX_MON_PPDU_RING_MASK] = ppdu_info;
+	/* Slot must be visible before the consumer sees the new head */
+	qdf_wmb();
+	qdf_atomic_set(&ring->hp, hp + 1);
+
+	return true;
+}
+
+/**
+ * dp_rx_mon_ppdu_ring_pop() - Consumer side of the PPDU ring
+ * @ring: PPDU ring
+ *
+ * Only one consumer may run at a time.
+ *
+ * Return: oldest ppdu info, or NULL if the ring is empty
+ */
+static inline struct hal_rx_ppdu_info *
+dp_rx_mon_ppdu_ring_pop(struct dp_rx_mon_ppdu_ring *ring)
+{
+	struct hal_rx_ppdu_info *ppdu_info;
+	uint32_t tp = qdf_atomic_read(&ring->tp);
+
+	if (tp == (uint32_t)qdf_atomic_read(&ring->hp))
+		return NULL;
+
+	/* Pairs with the write barrier in dp_rx_mon_ppdu_ring_push() */
+	qdf_rmb();
+	ppdu_info = ring->slots[tp & DP_RX_MON_PPDU_RING_MASK];
+	/* Slot is read before it is handed back to the producer */
+	qdf_mb();
+	qdf_atomic_set(&ring->tp, tp + 1);
+
+	return ppdu_info;
+}
+
+#endif /* _DP_RX_MON_PPDU_RING_H_ */
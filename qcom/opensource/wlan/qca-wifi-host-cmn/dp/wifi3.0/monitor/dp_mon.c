@@ -1421,11 +1421,13 @@ void dp_peer_get_tx_rx_stats(struct dp_peer *peer,
 {
 	struct dp_txrx_peer *txrx_peer = NULL;
 	struct dp_peer *tgt_peer = NULL;
+	struct cdp_pkt_info to_stack;
 
 	tgt_peer = dp_get_tgt_peer_from_peer(peer);
 	txrx_peer = tgt_peer->txrx_peer;
-	peer_stats_intf->rx_packet_count = txrx_peer->to_stack.num;
-	peer_stats_intf->rx_byte_count = txrx_peer->to_stack.bytes;
+	dp_txrx_peer_get_to_stack(txrx_peer, &to_stack);
+	peer_stats_intf->rx_packet_count = to_stack.num;
+	peer_stats_intf->rx_byte_count = to_stack.bytes;
 	peer_stats_intf->tx_packet_count =
 			txrx_peer->stats.per_pkt_stats.tx.ucast.num;
 	peer_stats_intf->tx_byte_count =
@@ -2360,7 +2362,7 @@ dp_peer_cal_clients_stats_update(struct dp_soc *soc,
 		return;
 
 	txrx_peer = tgt_peer->txrx_peer;
-	peer_stats_intf.to_stack = txrx_peer->to_stack;
+	dp_txrx_peer_get_to_stack(txrx_peer, &peer_stats_intf.to_stack);
 	peer_stats_intf.tx_success =
 				peer->monitor_peer->stats.tx.tx_ucast_success;
 	peer_stats_intf.tx_ucast =
@@ -2390,7 +2392,7 @@ dp_peer_cal_clients_stats_update(struct dp_soc *soc,
 		return;
 
 	txrx_peer = tgt_peer->txrx_peer;
-	peer_stats_intf.to_stack = txrx_peer->to_stack;
+	dp_txrx_peer_get_to_stack(txrx_peer, &peer_stats_intf.to_stack);
 	peer_stats_intf.tx_success =
 				txrx_peer->stats.per_pkt_stats.tx.tx_success;
 	peer_stats_intf.tx_ucast =
@@ -2738,6 +2740,7 @@ void dp_send_stats_event(struct dp_pdev *pdev, struct dp_peer *peer,
 	struct cdp_interface_peer_stats peer_stats_intf = {0};
 	struct dp_mon_peer *mon_peer = peer->monitor_peer;
 	struct dp_txrx_peer *txrx_peer = NULL;
+	struct cdp_pkt_info to_stack;
 
 	if (qdf_unlikely(!mon_peer))
 		return;
@@ -2747,7 +2750,8 @@ void dp_send_stats_event(struct dp_pdev *pdev, struct dp_peer *peer,
 
 	txrx_peer = dp_get_txrx_peer(peer);
 	if (qdf_likely(txrx_peer)) {
-		peer_stats_intf.rx_byte_count = txrx_peer->to_stack.bytes;
+		dp_txrx_peer_get_to_stack(txrx_peer, &to_stack);
+		peer_stats_intf.rx_byte_count = to_stack.bytes;
 		peer_stats_intf.tx_byte_count =
 			txrx_peer->stats.per_pkt_stats.tx.tx_success.bytes;
 	}
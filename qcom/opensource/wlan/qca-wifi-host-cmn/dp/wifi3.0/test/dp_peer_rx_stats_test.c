@@ -0,0 +1,179 @@
+/*
+ * Copyright (c) 2026 Qualcomm Innovation Center, Inc. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted, provided that the
+ * above copyright notice and this permission notice appear in all
+ * copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#include "dp_types.h"
+#include "dp_internal.h"
+#include "dp_peer_rx_stats_test.h"
+#include "qdf_mem.h"
+#include "qdf_threads.h"
+#include "qdf_time.h"
+#include "qdf_trace.h"
+
+#define dp_peer_rx_stats_ut_rings 4
+#define dp_peer_rx_stats_ut_msdus (1 << 20)
+#define dp_peer_rx_stats_ut_msdu_len 1500
+
+QDF_COMPILE_TIME_ASSERT(dp_peer_rx_stats_ut_rings_check,
+			dp_peer_rx_stats_ut_rings <= CDP_MAX_RX_RINGS);
+
+typedef void (*dp_peer_rx_stats_ut_update)(struct dp_txrx_peer *txrx_peer,
+					   uint8_t ring);
+
+struct dp_peer_rx_stats_ut_ring {
+	struct dp_txrx_peer *txrx_peer;
+	uint8_t ring;
+	dp_peer_rx_stats_ut_update update;
+};
+
+/* every ring updates the txrx_peer counters directly */
+static void dp_peer_rx_stats_ut_update_shared(struct dp_txrx_peer *txrx_peer,
+					      uint8_t ring)
+{
+	DP_PEER_STATS_FLAT_INC_PKT(txrx_peer, to_stack, 1,
+				   dp_peer_rx_stats_ut_msdu_len);
+}
+
+/* every ring updates what DP_PEER_TO_STACK_RING_INC_PKT resolves to */
+static void
+dp_peer_rx_stats_ut_update_per_ring(struct dp_txrx_peer *txrx_peer,
+				    uint8_t ring)
+{
+	DP_PEER_TO_STACK_RING_INC_PKT(txrx_peer, ring, 1,
+				      dp_peer_rx_stats_ut_msdu_len);
+}
+
+/*
+ * One REO ring's Rx context delivering MSDUs of the same peer. The update
+ * is called through a pointer so that each MSDU does its own load and
+ * store, as in the Rx path, instead of being folded into one.
+ */
+static QDF_STATUS dp_peer_rx_stats_ut_reap(void *context)
+{
+	struct dp_peer_rx_stats_ut_ring *ut_ring = context;
+	uint32_t i;
+
+	for (i = 0; i < dp_peer_rx_stats_ut_msdus; i++)
+		ut_ring->update(ut_ring->txrx_peer, ut_ring->ring);
+
+	return QDF_STATUS_SUCCESS;
+}
+
+/* run all rings against one peer, return the per MSDU cost in ps */
+static uint64_t dp_peer_rx_stats_ut_run(struct dp_txrx_peer *txrx_peer,
+					dp_peer_rx_stats_ut_update update)
+{
+	struct dp_peer_rx_stats_ut_ring ut_rings[dp_peer_rx_stats_ut_rings];
+	qdf_thread_t *threads[dp_peer_rx_stats_ut_rings];
+	int64_t start_ns, elapsed_ns;
+	uint8_t ring;
+
+	start_ns = qdf_ktime_to_ns(qdf_ktime_get());
+	for (ring = 0; ring < dp_peer_rx_stats_ut_rings; ring++) {
+		ut_rings[ring].txrx_peer = txrx_peer;
+		ut_rings[ring].ring = ring;
+		ut_rings[ring].update = update;
+		threads[ring] = qdf_thread_run(dp_peer_rx_stats_ut_reap,
+					       &ut_rings[ring]);
+		QDF_BUG(threads[ring]);
+	}
+
+	for (ring = 0; ring < dp_peer_rx_stats_ut_rings; ring++) {
+		if (threads[ring])
+			qdf_thread_join(threads[ring]);
+	}
+	elapsed_ns = qdf_ktime_to_ns(qdf_ktime_get()) - start_ns;
+
+	return qdf_do_div((uint64_t)elapsed_ns * 1000,
+			  dp_peer_rx_stats_ut_rings *
+			  dp_peer_rx_stats_ut_msdus);
+}
+
+#if defined(DP_PEER_RX_RING_STATS) && !defined(DISABLE_DP_STATS)
+/* per ring deltas have a single writer each, so no update may be lost */
+static uint32_t dp_peer_rx_stats_ut_check(struct dp_txrx_peer *txrx_peer)
+{
+	struct cdp_pkt_info to_stack;
+	uint32_t errors = 0;
+
+	dp_txrx_peer_get_to_stack(txrx_peer, &to_stack);
+	if (to_stack.num !=
+	    dp_peer_rx_stats_ut_rings * dp_peer_rx_stats_ut_msdus)
+		errors++;
+	if (to_stack.bytes != (uint64_t)dp_peer_rx_stats_ut_rings *
+			      dp_peer_rx_stats_ut_msdus *
+			      dp_peer_rx_stats_ut_msdu_len)
+		errors++;
+
+	/* the deltas go with the peer counters on stats clear */
+	dp_txrx_peer_rx_ring_stats_clr(txrx_peer);
+	dp_txrx_peer_get_to_stack(txrx_peer, &to_stack);
+	if (to_stack.num || to_stack.bytes)
+		errors++;
+
+	return errors;
+}
+#else
+static inline uint32_t
+dp_peer_rx_stats_ut_check(struct dp_txrx_peer *txrx_peer)
+{
+	return 0;
+}
+#endif
+
+static uint32_t dp_peer_rx_stats_ut_to_stack(void)
+{
+	struct dp_txrx_peer *txrx_peer;
+	uint32_t size = sizeof(*txrx_peer);
+	qdf_dma_addr_t paddr_unaligned, paddr_aligned;
+	void *mem_unaligned;
+	uint64_t shared_ps, per_ring_ps;
+	uint32_t errors;
+
+	/* cache line aligned, as dp_txrx_peer_attach() allocates it */
+	txrx_peer = qdf_aligned_malloc(&size, &mem_unaligned,
+				       &paddr_unaligned, &paddr_aligned,
+				       QDF_CACHE_LINE_SZ);
+	if (!txrx_peer)
+		return 1;
+
+	shared_ps = dp_peer_rx_stats_ut_run(txrx_peer,
+					    dp_peer_rx_stats_ut_update_shared);
+	txrx_peer->to_stack.num = 0;
+	txrx_peer->to_stack.bytes = 0;
+
+	per_ring_ps = dp_peer_rx_stats_ut_run(txrx_peer,
+					dp_peer_rx_stats_ut_update_per_ring);
+
+	dp_info("to_stack per MSDU, %u rings: shared %llu ps, per ring %llu ps",
+		dp_peer_rx_stats_ut_rings, shared_ps, per_ring_ps);
+
+	errors = dp_peer_rx_stats_ut_check(txrx_peer);
+	QDF_BUG(!errors);
+	qdf_mem_free(mem_unaligned);
+
+	return errors;
+}
+
+uint32_t dp_peer_rx_stats_unit_test(void)
+{
+	uint32_t errors = 0;
+
+	errors += dp_peer_rx_stats_ut_to_stack();
+
+	return errors;
+}
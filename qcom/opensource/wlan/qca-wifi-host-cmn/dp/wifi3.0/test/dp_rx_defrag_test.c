@@ -0,0 +1,387 @@
+/*
+ * Copyright (c) 2026 Qualcomm Innovation Center, Inc. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted, provided that the
+ * above copyright notice and this permission notice appear in all
+ * copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#include "dp_types.h"
+#include "dp_rx_defrag.h"
+#include "dp_rx_defrag_test.h"
+#include "qdf_mem.h"
+#include "qdf_nbuf.h"
+#include "qdf_time.h"
+#include "qdf_trace.h"
+
+#define dp_rx_defrag_ut_buf_size 32
+
+#ifndef DISABLE_DP_STATS
+#define dp_rx_defrag_ut_frag_wait(soc) ((soc)->stats.rx.rx_frag_wait)
+#else
+#define dp_rx_defrag_ut_frag_wait(soc) 0
+#endif
+
+struct dp_rx_defrag_ut {
+	struct dp_rx_tid_defrag rx_tid;
+	qdf_nbuf_t frags[DP_RX_DEFRAG_MAX_FRAGS];
+	qdf_nbuf_t head;
+	qdf_nbuf_t tail;
+	uint8_t all_frag_present;
+};
+
+static struct dp_rx_defrag_ut *dp_rx_defrag_ut_create(void)
+{
+	struct dp_rx_defrag_ut *ut;
+	uint8_t i;
+
+	ut = qdf_mem_malloc(sizeof(*ut));
+	if (!ut)
+		return NULL;
+
+	for (i = 0; i < DP_RX_DEFRAG_MAX_FRAGS; i++) {
+		ut->frags[i] = qdf_nbuf_alloc(NULL, dp_rx_defrag_ut_buf_size,
+					      0, 4, false);
+		if (!ut->frags[i])
+			goto free_frags;
+	}
+
+	return ut;
+
+free_frags:
+	while (i--)
+		qdf_nbuf_free(ut->frags[i]);
+	qdf_mem_free(ut);
+
+	return NULL;
+}
+
+static void dp_rx_defrag_ut_destroy(struct dp_rx_defrag_ut *ut)
+{
+	uint8_t i;
+
+	for (i = 0; i < DP_RX_DEFRAG_MAX_FRAGS; i++)
+		qdf_nbuf_free(ut->frags[i]);
+	qdf_mem_free(ut);
+}
+
+static QDF_STATUS
+dp_rx_defrag_ut_insert(struct dp_rx_defrag_ut *ut, uint8_t fragno,
+		       uint8_t more_frag)
+{
+	return dp_rx_defrag_slot_insert(&ut->rx_tid, ut->frags[fragno], fragno,
+					more_frag, &ut->head, &ut->tail,
+					&ut->all_frag_present);
+}
+
+/* check the completed chain is fragments 0..@last_fragno, in order */
+static uint32_t dp_rx_defrag_ut_check_chain(struct dp_rx_defrag_ut *ut,
+					    uint8_t last_fragno)
+{
+	qdf_nbuf_t frag = ut->head;
+	uint32_t errors = 0;
+	uint8_t i;
+
+	if (!ut->all_frag_present)
+		return 1;
+
+	for (i = 0; i <= last_fragno; i++) {
+		if (frag != ut->frags[i]) {
+			errors++;
+			break;
+		}
+		frag = qdf_nbuf_next(frag);
+	}
+
+	if (frag || ut->tail != ut->frags[last_fragno])
+		errors++;
+
+	/* the slots are handed over with the chain */
+	if (ut->rx_tid.frag_bitmap || ut->rx_tid.frag_complete_mask)
+		errors++;
+
+	for (i = 0; i < DP_RX_DEFRAG_MAX_FRAGS; i++)
+		qdf_nbuf_set_next(ut->frags[i], NULL);
+
+	return errors;
+}
+
+static uint32_t dp_rx_defrag_ut_out_of_order(void)
+{
+	static const uint8_t order[] = {2, 0, 3, 1};
+	struct dp_rx_defrag_ut *ut;
+	uint32_t errors = 0;
+	uint8_t i;
+
+	ut = dp_rx_defrag_ut_create();
+	if (!ut)
+		return 1;
+
+	/* fragment 3 is the last one, the sequence completes on the 4th */
+	for (i = 0; i < QDF_ARRAY_SIZE(order); i++) {
+		if (dp_rx_defrag_ut_insert(ut, order[i], order[i] != 3) !=
+		    QDF_STATUS_SUCCESS)
+			errors++;
+		if (ut->all_frag_present != (i == QDF_ARRAY_SIZE(order) - 1))
+			errors++;
+	}
+
+	errors += dp_rx_defrag_ut_check_chain(ut, 3);
+
+	QDF_BUG(!errors);
+	dp_rx_defrag_ut_destroy(ut);
+
+	return errors;
+}
+
+static uint32_t dp_rx_defrag_ut_duplicate(void)
+{
+	struct dp_rx_defrag_ut *ut;
+	qdf_nbuf_t dup;
+	uint32_t errors = 0;
+
+	ut = dp_rx_defrag_ut_create();
+	if (!ut)
+		return 1;
+
+	dup = qdf_nbuf_alloc(NULL, dp_rx_defrag_ut_buf_size, 0, 4, false);
+	if (!dup) {
+		dp_rx_defrag_ut_destroy(ut);
+		return 1;
+	}
+
+	if (dp_rx_defrag_ut_insert(ut, 0, 1) != QDF_STATUS_SUCCESS)
+		errors++;
+
+	/* a second fragment 0 is refused and the first one is kept */
+	if (dp_rx_defrag_slot_insert(&ut->rx_tid, dup, 0, 1, &ut->head,
+				     &ut->tail, &ut->all_frag_present) !=
+	    QDF_STATUS_E_ALREADY)
+		errors++;
+	if (ut->rx_tid.frag_bitmap != 0x1 ||
+	    ut->rx_tid.frags[0] != ut->frags[0])
+		errors++;
+
+	if (dp_rx_defrag_ut_insert(ut, 1, 0) != QDF_STATUS_SUCCESS)
+		errors++;
+
+	errors += dp_rx_defrag_ut_check_chain(ut, 1);
+
+	QDF_BUG(!errors);
+	qdf_nbuf_free(dup);
+	dp_rx_defrag_ut_destroy(ut);
+
+	return errors;
+}
+
+static uint32_t dp_rx_defrag_ut_beyond_last(void)
+{
+	struct dp_rx_defrag_ut *ut;
+	uint32_t errors = 0;
+
+	ut = dp_rx_defrag_ut_create();
+	if (!ut)
+		return 1;
+
+	/* fragment 1 is the last one, fragment 3 cannot belong */
+	if (dp_rx_defrag_ut_insert(ut, 1, 0) != QDF_STATUS_SUCCESS)
+		errors++;
+	if (ut->rx_tid.frag_complete_mask != 0x3)
+		errors++;
+	if (dp_rx_defrag_ut_insert(ut, 3, 1) != QDF_STATUS_E_INVAL)
+		errors++;
+	if (ut->rx_tid.frag_bitmap != 0x2)
+		errors++;
+
+	/* and does not keep the sequence from completing */
+	if (dp_rx_defrag_ut_insert(ut, 0, 1) != QDF_STATUS_SUCCESS)
+		errors++;
+	errors += dp_rx_defrag_ut_check_chain(ut, 1);
+
+	/* same when fragment 3 is stored before the last one arrives */
+	if (dp_rx_defrag_ut_insert(ut, 3, 1) != QDF_STATUS_SUCCESS)
+		errors++;
+	if (dp_rx_defrag_ut_insert(ut, 1, 0) != QDF_STATUS_E_INVAL)
+		errors++;
+	if (ut->rx_tid.frag_complete_mask || ut->all_frag_present)
+		errors++;
+
+	QDF_BUG(!errors);
+	dp_rx_defrag_ut_destroy(ut);
+
+	return errors;
+}
+
+static uint32_t dp_rx_defrag_ut_max_fragno(void)
+{
+	struct dp_rx_defrag_ut *ut;
+	uint32_t errors = 0;
+	int fragno;
+
+	ut = dp_rx_defrag_ut_create();
+	if (!ut)
+		return 1;
+
+	/* all 16 fragments, last first, complete on fragment 0 */
+	for (fragno = DP_RX_DEFRAG_MAX_FRAGS - 1; fragno >= 0; fragno--) {
+		if (dp_rx_defrag_ut_insert(ut, fragno,
+					   fragno != DP_RX_DEFRAG_MAX_FRAGS - 1)
+		    != QDF_STATUS_SUCCESS)
+			errors++;
+		if (ut->all_frag_present != !fragno)
+			errors++;
+	}
+
+	errors += dp_rx_defrag_ut_check_chain(ut, DP_RX_DEFRAG_MAX_FRAGS - 1);
+
+	QDF_BUG(!errors);
+	dp_rx_defrag_ut_destroy(ut);
+
+	return errors;
+}
+
+struct dp_rx_defrag_ut_peer {
+	struct dp_soc *soc;
+	struct dp_pdev pdev;
+	struct dp_vdev vdev;
+	struct dp_txrx_peer txrx_peer;
+};
+
+/*
+ * A soc with an empty peer map, so the flush finds no peer to take a
+ * reference on and only unlinks the TIDs, without touching their frags.
+ */
+static struct dp_rx_defrag_ut_peer *dp_rx_defrag_ut_peer_create(void)
+{
+	struct dp_rx_defrag_ut_peer *ut;
+	struct dp_rx_tid_defrag *rx_tid;
+	uint8_t tid;
+
+	ut = qdf_mem_malloc(sizeof(*ut));
+	if (!ut)
+		return NULL;
+
+	ut->soc = qdf_mem_malloc(sizeof(*ut->soc));
+	if (!ut->soc) {
+		qdf_mem_free(ut);
+		return NULL;
+	}
+
+	qdf_spinlock_create(&ut->soc->peer_map_lock);
+	qdf_spinlock_create(&ut->soc->rx.defrag.defrag_lock);
+	TAILQ_INIT(&ut->soc->rx.defrag.waitlist);
+
+	ut->pdev.soc = ut->soc;
+	ut->vdev.pdev = &ut->pdev;
+	ut->txrx_peer.vdev = &ut->vdev;
+
+	for (tid = 0; tid < DP_MAX_TIDS; tid++) {
+		rx_tid = &ut->txrx_peer.rx_tid[tid];
+		rx_tid->tid = tid;
+		rx_tid->defrag_peer = &ut->txrx_peer;
+		qdf_spinlock_create(&rx_tid->defrag_tid_lock);
+	}
+
+	return ut;
+}
+
+static void dp_rx_defrag_ut_peer_destroy(struct dp_rx_defrag_ut_peer *ut)
+{
+	struct dp_rx_tid_defrag *rx_tid = ut->txrx_peer.rx_tid;
+	uint8_t tid;
+
+	for (tid = 0; tid < DP_MAX_TIDS; tid++)
+		qdf_spinlock_destroy(&rx_tid[tid].defrag_tid_lock);
+
+	qdf_spinlock_destroy(&ut->soc->rx.defrag.defrag_lock);
+	qdf_spinlock_destroy(&ut->soc->peer_map_lock);
+	qdf_mem_free(ut->soc);
+	qdf_mem_free(ut);
+}
+
+static uint32_t dp_rx_defrag_ut_waitlist(void)
+{
+	struct dp_rx_defrag_ut_peer *ut;
+	struct dp_rx_tid_defrag *rx_tid;
+	struct dp_soc *soc;
+	uint32_t now_ms = qdf_system_ticks_to_msecs(qdf_system_ticks());
+	uint32_t errors = 0;
+
+	ut = dp_rx_defrag_ut_peer_create();
+	if (!ut)
+		return 1;
+
+	soc = ut->soc;
+	rx_tid = ut->txrx_peer.rx_tid;
+
+	/* TIDs 0 and 2 have timed out, TID 1 has an hour left */
+	rx_tid[0].defrag_timeout_ms = now_ms;
+	rx_tid[2].defrag_timeout_ms = now_ms;
+	rx_tid[1].defrag_timeout_ms = now_ms + 3600 * 1000;
+
+	dp_rx_defrag_waitlist_add(&ut->txrx_peer, 0);
+	dp_rx_defrag_waitlist_add(&ut->txrx_peer, 2);
+	dp_rx_defrag_waitlist_add(&ut->txrx_peer, 1);
+	if (!rx_tid[0].on_waitlist || !rx_tid[1].on_waitlist ||
+	    !rx_tid[2].on_waitlist || rx_tid[3].on_waitlist)
+		errors++;
+	if (dp_rx_defrag_ut_frag_wait(soc) != 3)
+		errors++;
+
+	/* removing from the middle unlinks only that TID, and only once */
+	dp_rx_defrag_waitlist_remove(&ut->txrx_peer, 2);
+	if (rx_tid[2].on_waitlist || dp_rx_defrag_ut_frag_wait(soc) != 2)
+		errors++;
+	dp_rx_defrag_waitlist_remove(&ut->txrx_peer, 2);
+	if (dp_rx_defrag_ut_frag_wait(soc) != 2)
+		errors++;
+	if (TAILQ_FIRST(&soc->rx.defrag.waitlist) != &rx_tid[0] ||
+	    TAILQ_NEXT(&rx_tid[0], defrag_waitlist_elem) != &rx_tid[1] ||
+	    TAILQ_NEXT(&rx_tid[1], defrag_waitlist_elem))
+		errors++;
+
+	/* the flush takes TID 0 and stops at the first one still waiting */
+	dp_rx_defrag_waitlist_flush(soc);
+	if (rx_tid[0].on_waitlist || !rx_tid[1].on_waitlist)
+		errors++;
+	if (dp_rx_defrag_ut_frag_wait(soc) != 1)
+		errors++;
+	if (TAILQ_FIRST(&soc->rx.defrag.waitlist) != &rx_tid[1] ||
+	    TAILQ_NEXT(&rx_tid[1], defrag_waitlist_elem))
+		errors++;
+	if (soc->rx.defrag.next_flush_ms != rx_tid[1].defrag_timeout_ms)
+		errors++;
+
+	dp_rx_defrag_waitlist_remove(&ut->txrx_peer, 1);
+	if (rx_tid[1].on_waitlist || dp_rx_defrag_ut_frag_wait(soc) ||
+	    !TAILQ_EMPTY(&soc->rx.defrag.waitlist))
+		errors++;
+
+	QDF_BUG(!errors);
+	dp_rx_defrag_ut_peer_destroy(ut);
+
+	return errors;
+}
+
+uint32_t dp_rx_defrag_unit_test(void)
+{
+	uint32_t errors = 0;
+
+	errors += dp_rx_defrag_ut_out_of_order();
+	errors += dp_rx_defrag_ut_duplicate();
+	errors += dp_rx_defrag_ut_beyond_last();
+	errors += dp_rx_defrag_ut_max_fragno();
+	errors += dp_rx_defrag_ut_waitlist();
+
+	return errors;
+}
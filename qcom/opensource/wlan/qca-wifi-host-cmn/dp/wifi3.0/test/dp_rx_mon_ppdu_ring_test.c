@@ -0,0 +1,314 @@
+/*
+ * Copyright (c) 2026 Qualcomm Innovation Center, Inc. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted, provided that the
+ * above copyright notice and this permission notice appear in all
+ * copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#include <queue.h>
+#include "dp_rx_mon_ppdu_ring.h"
+#include "dp_rx_mon_ppdu_ring_test.h"
+#include "qdf_lock.h"
+#include "qdf_mem.h"
+#include "qdf_threads.h"
+#include "qdf_time.h"
+#include "qdf_trace.h"
+
+#define dp_rx_mon_ppdu_ring_ut_size DP_RX_MON_PPDU_RING_SIZE
+#define dp_rx_mon_ppdu_ring_ut_entries (2 * dp_rx_mon_ppdu_ring_ut_size)
+#define dp_rx_mon_ppdu_ring_ut_laps 3
+#define dp_rx_mon_ppdu_ring_ut_stress_ppdus (16 * dp_rx_mon_ppdu_ring_ut_size)
+/* the Rx mon work is kicked once this many PPDUs are queued */
+#define dp_rx_mon_ppdu_ring_ut_batch 16
+#define dp_rx_mon_ppdu_ring_ut_bench_ppdus (1 << 20)
+
+struct dp_rx_mon_ppdu_ring_ut_entry {
+	TAILQ_ENTRY(dp_rx_mon_ppdu_ring_ut_entry) elem;
+};
+
+struct dp_rx_mon_ppdu_ring_ut {
+	struct dp_rx_mon_ppdu_ring ring;
+	struct dp_rx_mon_ppdu_ring_ut_entry
+			entries[dp_rx_mon_ppdu_ring_ut_entries];
+	TAILQ_HEAD(, dp_rx_mon_ppdu_ring_ut_entry) list;
+	qdf_spinlock_t lock;
+	uint32_t errors;
+};
+
+/* the n-th PPDU queued, cycling through the entries */
+static struct hal_rx_ppdu_info *
+dp_rx_mon_ppdu_ring_ut_ppdu(struct dp_rx_mon_ppdu_ring_ut *ut, uint32_t n)
+{
+	return (struct hal_rx_ppdu_info *)
+		&ut->entries[n % dp_rx_mon_ppdu_ring_ut_entries];
+}
+
+static struct dp_rx_mon_ppdu_ring_ut *dp_rx_mon_ppdu_ring_ut_create(void)
+{
+	struct dp_rx_mon_ppdu_ring_ut *ut;
+
+	ut = qdf_mem_malloc(sizeof(*ut));
+	if (!ut)
+		return NULL;
+
+	dp_rx_mon_ppdu_ring_init(&ut->ring);
+	TAILQ_INIT(&ut->list);
+	qdf_spinlock_create(&ut->lock);
+
+	return ut;
+}
+
+static void dp_rx_mon_ppdu_ring_ut_destroy(struct dp_rx_mon_ppdu_ring_ut *ut)
+{
+	qdf_spinlock_destroy(&ut->lock);
+	qdf_mem_free(ut);
+}
+
+/* pop @count PPDUs, which must be PPDUs @*next onwards in order */
+static uint32_t dp_rx_mon_ppdu_ring_ut_pop(struct dp_rx_mon_ppdu_ring_ut *ut,
+					   uint32_t *next, uint32_t count)
+{
+	uint32_t errors = 0;
+
+	while (count--) {
+		if (dp_rx_mon_ppdu_ring_pop(&ut->ring) !=
+		    dp_rx_mon_ppdu_ring_ut_ppdu(ut, (*next)++))
+			errors++;
+	}
+
+	return errors;
+}
+
+static uint32_t dp_rx_mon_ppdu_ring_ut_wrap_full_drain(void)
+{
+	struct dp_rx_mon_ppdu_ring_ut *ut;
+	struct dp_rx_mon_ppdu_ring *ring;
+	uint32_t start = -(dp_rx_mon_ppdu_ring_ut_size / 2);
+	uint32_t pushed = 0, popped = 0;
+	uint32_t errors = 0;
+	uint32_t lap, count;
+
+	ut = dp_rx_mon_ppdu_ring_ut_create();
+	if (!ut)
+		return 1;
+
+	ring = &ut->ring;
+
+	/* start half a ring before the indices wrap around 32 bits */
+	qdf_atomic_set(&ring->hp, start);
+	qdf_atomic_set(&ring->tp, start);
+
+	for (lap = 0; lap < dp_rx_mon_ppdu_ring_ut_laps; lap++) {
+		/* the ring fills up to its size, empty or half full ... */
+		count = 0;
+		while (count <= dp_rx_mon_ppdu_ring_ut_size &&
+		       dp_rx_mon_ppdu_ring_push(ring,
+				dp_rx_mon_ppdu_ring_ut_ppdu(ut, pushed))) {
+			pushed++;
+			count++;
+		}
+		if (count != (lap ? dp_rx_mon_ppdu_ring_ut_size / 2 :
+				    dp_rx_mon_ppdu_ring_ut_size))
+			errors++;
+		if (dp_rx_mon_ppdu_ring_depth(ring) !=
+		    dp_rx_mon_ppdu_ring_ut_size)
+			errors++;
+
+		/* ... and gives back half of it in FIFO order */
+		errors += dp_rx_mon_ppdu_ring_ut_pop(ut, &popped,
+					dp_rx_mon_ppdu_ring_ut_size / 2);
+		if (dp_rx_mon_ppdu_ring_depth(ring) !=
+		    dp_rx_mon_ppdu_ring_ut_size / 2)
+			errors++;
+	}
+
+	/* the drain empties the ring and then finds nothing */
+	errors += dp_rx_mon_ppdu_ring_ut_pop(ut, &popped,
+					     dp_rx_mon_ppdu_ring_ut_size / 2);
+	if (dp_rx_mon_ppdu_ring_pop(ring) || dp_rx_mon_ppdu_ring_depth(ring) ||
+	    popped != pushed)
+		errors++;
+
+	/* and both indices went past the wrap */
+	if ((uint32_t)qdf_atomic_read(&ring->hp) != start + pushed ||
+	    (uint32_t)qdf_atomic_read(&ring->tp) != start + popped ||
+	    start + popped >= start)
+		errors++;
+
+	QDF_BUG(!errors);
+	dp_rx_mon_ppdu_ring_ut_destroy(ut);
+
+	return errors;
+}
+
+/* Rx mon ring processing, backing off while the ring is full */
+static QDF_STATUS dp_rx_mon_ppdu_ring_ut_producer(void *context)
+{
+	struct dp_rx_mon_ppdu_ring_ut *ut = context;
+	uint32_t n = 0;
+
+	while (n < dp_rx_mon_ppdu_ring_ut_stress_ppdus) {
+		if (dp_rx_mon_ppdu_ring_push(&ut->ring,
+				dp_rx_mon_ppdu_ring_ut_ppdu(ut, n)))
+			n++;
+		else
+			qdf_sleep_us(1);
+	}
+
+	return QDF_STATUS_SUCCESS;
+}
+
+/* the Rx mon work, which must see every PPDU once and in order */
+static QDF_STATUS dp_rx_mon_ppdu_ring_ut_consumer(void *context)
+{
+	struct dp_rx_mon_ppdu_ring_ut *ut = context;
+	struct hal_rx_ppdu_info *ppdu_info;
+	uint32_t n = 0;
+
+	while (n < dp_rx_mon_ppdu_ring_ut_stress_ppdus) {
+		ppdu_info = dp_rx_mon_ppdu_ring_pop(&ut->ring);
+		if (!ppdu_info) {
+			qdf_sleep_us(1);
+			continue;
+		}
+
+		if (ppdu_info != dp_rx_mon_ppdu_ring_ut_ppdu(ut, n))
+			ut->errors++;
+		n++;
+	}
+
+	return QDF_STATUS_SUCCESS;
+}
+
+static uint32_t dp_rx_mon_ppdu_ring_ut_stress(void)
+{
+	struct dp_rx_mon_ppdu_ring_ut *ut;
+	qdf_thread_t *producer, *consumer;
+	uint32_t errors;
+
+	ut = dp_rx_mon_ppdu_ring_ut_create();
+	if (!ut)
+		return 1;
+
+	consumer = qdf_thread_run(dp_rx_mon_ppdu_ring_ut_consumer, ut);
+	QDF_BUG(consumer);
+	producer = qdf_thread_run(dp_rx_mon_ppdu_ring_ut_producer, ut);
+	QDF_BUG(producer);
+
+	if (producer)
+		qdf_thread_join(producer);
+	if (consumer)
+		qdf_thread_join(consumer);
+
+	errors = ut->errors;
+	if (!producer || !consumer || dp_rx_mon_ppdu_ring_depth(&ut->ring))
+		errors++;
+
+	QDF_BUG(!errors);
+	dp_rx_mon_ppdu_ring_ut_destroy(ut);
+
+	return errors;
+}
+
+/* per PPDU handoff cost through the ring, in ps */
+static uint64_t
+dp_rx_mon_ppdu_ring_ut_bench_ring(struct dp_rx_mon_ppdu_ring_ut *ut)
+{
+	int64_t start_ns, elapsed_ns;
+	uint32_t n, i;
+
+	start_ns = qdf_ktime_to_ns(qdf_ktime_get());
+	for (n = 0; n < dp_rx_mon_ppdu_ring_ut_bench_ppdus;
+	     n += dp_rx_mon_ppdu_ring_ut_batch) {
+		for (i = 0; i < dp_rx_mon_ppdu_ring_ut_batch; i++)
+			dp_rx_mon_ppdu_ring_push(&ut->ring,
+				dp_rx_mon_ppdu_ring_ut_ppdu(ut, n + i));
+		while (dp_rx_mon_ppdu_ring_pop(&ut->ring))
+			;
+	}
+	elapsed_ns = qdf_ktime_to_ns(qdf_ktime_get()) - start_ns;
+
+	return qdf_do_div((uint64_t)elapsed_ns * 1000,
+			  dp_rx_mon_ppdu_ring_ut_bench_ppdus);
+}
+
+/*
+ * Per PPDU handoff cost through the locked queue the ring replaced, in ps:
+ * the producer takes the lock for each PPDU and the work takes it once
+ * for the whole batch.
+ */
+static uint64_t
+dp_rx_mon_ppdu_ring_ut_bench_list(struct dp_rx_mon_ppdu_ring_ut *ut)
+{
+	struct dp_rx_mon_ppdu_ring_ut_entry *entry, *tmp;
+	int64_t start_ns, elapsed_ns;
+	uint32_t n, i;
+
+	start_ns = qdf_ktime_to_ns(qdf_ktime_get());
+	for (n = 0; n < dp_rx_mon_ppdu_ring_ut_bench_ppdus;
+	     n += dp_rx_mon_ppdu_ring_ut_batch) {
+		for (i = 0; i < dp_rx_mon_ppdu_ring_ut_batch; i++) {
+			entry = &ut->entries[(n + i) %
+					     dp_rx_mon_ppdu_ring_ut_entries];
+			qdf_spin_lock_bh(&ut->lock);
+			TAILQ_INSERT_TAIL(&ut->list, entry, elem);
+			qdf_spin_unlock_bh(&ut->lock);
+		}
+
+		qdf_spin_lock_bh(&ut->lock);
+		TAILQ_FOREACH_SAFE(entry, &ut->list, elem, tmp)
+			TAILQ_REMOVE(&ut->list, entry, elem);
+		qdf_spin_unlock_bh(&ut->lock);
+	}
+	elapsed_ns = qdf_ktime_to_ns(qdf_ktime_get()) - start_ns;
+
+	return qdf_do_div((uint64_t)elapsed_ns * 1000,
+			  dp_rx_mon_ppdu_ring_ut_bench_ppdus);
+}
+
+static uint32_t dp_rx_mon_ppdu_ring_ut_bench(void)
+{
+	struct dp_rx_mon_ppdu_ring_ut *ut;
+	uint64_t ring_ps, list_ps;
+	uint32_t errors = 0;
+
+	ut = dp_rx_mon_ppdu_ring_ut_create();
+	if (!ut)
+		return 1;
+
+	ring_ps = dp_rx_mon_ppdu_ring_ut_bench_ring(ut);
+	list_ps = dp_rx_mon_ppdu_ring_ut_bench_list(ut);
+
+	qdf_info("PPDU handoff, batches of %u: ring %llu ps, locked list %llu ps",
+		 dp_rx_mon_ppdu_ring_ut_batch, ring_ps, list_ps);
+
+	if (dp_rx_mon_ppdu_ring_depth(&ut->ring) || !TAILQ_EMPTY(&ut->list))
+		errors++;
+
+	QDF_BUG(!errors);
+	dp_rx_mon_ppdu_ring_ut_destroy(ut);
+
+	return errors;
+}
+
+uint32_t dp_rx_mon_ppdu_ring_unit_test(void)
+{
+	uint32_t errors = 0;
+
+	errors += dp_rx_mon_ppdu_ring_ut_wrap_full_drain();
+	errors += dp_rx_mon_ppdu_ring_ut_stress();
+	errors += dp_rx_mon_ppdu_ring_ut_bench();
+
+	return errors;
+}
@@ -3386,6 +3386,30 @@ void *hal_srng_dst_get_next_32_byte_desc(hal_soc_handle_t hal_soc_hdl,
 	return (void *)last_prefetched_hw_desc;
 }
 
+/**
+ * hal_srng_dst_get_ahead() - Get the destination ring desc a number of
+ *			      entries past the tail pointer
+ * @hal_soc_hdl: HAL SOC handle
+ * @hal_ring_hdl: Destination ring pointer
+ * @offset: number of entries past the tail pointer, must be less than
+ *	    the number of valid entries in the ring
+ *
+ * return: destination ring descriptor
+ */
+static inline
+void *hal_srng_dst_get_ahead(hal_soc_handle_t hal_soc_hdl,
+			     hal_ring_handle_t hal_ring_hdl,
+			     uint32_t offset)
+{
+	struct hal_srng *srng = (struct hal_srng *)hal_ring_hdl;
+	uint32_t idx = srng->u.dst_ring.tp + offset * srng->entry_size;
+
+	if (idx >= srng->ring_size)
+		idx -= srng->ring_size;
+
+	return (void *)&srng->ring_base_vaddr[idx];
+}
+
 /**
  * hal_srng_src_set_hp() - set head idx.
  * @hal_soc_hdl: HAL SOC handle
@@ -231,7 +231,7 @@ hal_rx_flow_delete_entry(hal_soc_handle_t hal_soc_hdl,
 
 qdf_export_symbol(hal_rx_flow_delete_entry);
 
-#ifndef WLAN_SUPPORT_RX_FISA
+#ifdef HAL_RX_FST_HOST_HASH
 /**
  * hal_rx_fst_key_configure() - Configure the Toeplitz key in the FST
  * @fst: Pointer to the Rx Flow Search Table
@@ -315,7 +315,7 @@ hal_rx_flow_get_tuple_info(hal_soc_handle_t hal_soc_hdl,
 	return NULL;
 }
 
-#ifndef WLAN_SUPPORT_RX_FISA
+#ifdef HAL_RX_FST_HOST_HASH
 /**
  * hal_flow_toeplitz_create_cache() - Calculate hashes for each possible
  * byte value with the key taken as is
@@ -490,43 +490,56 @@ void hal_rx_fst_detach(hal_soc_handle_t hal_soc_hdl, struct hal_rx_fst *rx_fst,
 }
 qdf_export_symbol(hal_rx_fst_detach);
 
-#ifndef WLAN_SUPPORT_RX_FISA
+#ifdef HAL_RX_FST_HOST_HASH
 /**
  * hal_flow_toeplitz_hash() - Calculate Toeplitz hash by using the cached key
  *
  * @hal_fst: FST Handle
  * @flow: Flow Parameters
  *
+ * key_cache[i][0] is 0 for every i, so zero input bytes do not change the
+ * hash. The input is walked a word at a time and only non-zero bytes of
+ * non-zero words are looked up; for IPv4 flows the six upper address
+ * words are all zero and most of the 37 lookups are skipped.
+ *
  * Return: Success/Failure
  */
 uint32_t
 hal_flow_toeplitz_hash(void *hal_fst, struct hal_rx_flow *flow)
 {
-	int i, j;
+	int w, j;
 	uint32_t hash = 0;
 	struct hal_rx_fst *fst = (struct hal_rx_fst *)hal_fst;
 	uint32_t input[HAL_FST_HASH_KEY_SIZE_WORDS];
 	uint8_t *tuple;
 
-	qdf_mem_zero(input, HAL_FST_HASH_KEY_SIZE_BYTES);
-	*(uint32_t *)&input[0] = qdf_htonl(flow->tuple_info.src_ip_127_96);
-	*(uint32_t *)&input[1] = qdf_htonl(flow->tuple_info.src_ip_95_64);
-	*(uint32_t *)&input[2] = qdf_htonl(flow->tuple_info.src_ip_63_32);
-	*(uint32_t *)&input[3] = qdf_htonl(flow->tuple_info.src_ip_31_0);
-	*(uint32_t *)&input[4] = qdf_htonl(flow->tuple_info.dest_ip_127_96);
-	*(uint32_t *)&input[5] = qdf_htonl(flow->tuple_info.dest_ip_95_64);
-	*(uint32_t *)&input[6] = qdf_htonl(flow->tuple_info.dest_ip_63_32);
-	*(uint32_t *)&input[7] = qdf_htonl(flow->tuple_info.dest_ip_31_0);
-	*(uint32_t *)&input[8] = (flow->tuple_info.dest_port << 16) |
-				 (flow->tuple_info.src_port);
-	*(uint32_t *)&input[9] = flow->tuple_info.l4_protocol;
+	input[0] = qdf_htonl(flow->tuple_info.src_ip_127_96);
+	input[1] = qdf_htonl(flow->tuple_info.src_ip_95_64);
+	input[2] = qdf_htonl(flow->tuple_info.src_ip_63_32);
+	input[3] = qdf_htonl(flow->tuple_info.src_ip_31_0);
+	input[4] = qdf_htonl(flow->tuple_info.dest_ip_127_96);
+	input[5] = qdf_htonl(flow->tuple_info.dest_ip_95_64);
+	input[6] = qdf_htonl(flow->tuple_info.dest_ip_63_32);
+	input[7] = qdf_htonl(flow->tuple_info.dest_ip_31_0);
+	input[8] = ((uint32_t)flow->tuple_info.dest_port << 16) |
+		   (flow->tuple_info.src_port);
+	input[9] = flow->tuple_info.l4_protocol;
 
 	tuple = (uint8_t *)input;
 	QDF_TRACE_HEX_DUMP(QDF_MODULE_ID_DP, QDF_TRACE_LEVEL_DEBUG,
 			   tuple, sizeof(input));
-	for (i = 0, j = HAL_FST_HASH_DATA_SIZE - 1;
-	     i < HAL_FST_HASH_KEY_SIZE_BYTES && j >= 0; i++, j--) {
-		hash ^= fst->key_cache[i][tuple[j]];
+
+	/* Input byte j is hashed with key_cache[DATA_SIZE - 1 - j] */
+	for (w = 0; w < HAL_FST_HASH_KEY_SIZE_WORDS; w++) {
+		if (!input[w])
+			continue;
+
+		for (j = w * 4; j < (w + 1) * 4 && j < HAL_FST_HASH_DATA_SIZE;
+		     j++) {
+			if (tuple[j])
+				hash ^= fst->key_cache[HAL_FST_HASH_DATA_SIZE -
+						       1 - j][tuple[j]];
+		}
 	}
 
 	QDF_TRACE(QDF_MODULE_ID_DP, QDF_TRACE_LEVEL_INFO_LOW,
@@ -27,6 +27,14 @@
 
 #define HAL_RX_FST_ENTRY_SIZE (NUM_OF_DWORDS_RX_FLOW_SEARCH_ENTRY * 4)
 
+/*
+ * With FISA the FSE hashes flows and the host Toeplitz key cache is not
+ * needed, but unit test builds keep it so the host hash can be checked.
+ */
+#if !defined(WLAN_SUPPORT_RX_FISA) || defined(WLAN_HAL_RX_FLOW_TEST)
+#define HAL_RX_FST_HOST_HASH
+#endif
+
 /**
  * struct hal_rx_flow - Rx Flow parameters to be sent to HW
  * @tuple_info: Rx Flow 5-tuple (src & dest IP, src & dest ports, L4 protocol)
@@ -64,7 +72,7 @@ struct hal_rx_fst {
 	uint8_t *base_vaddr;
 	qdf_dma_addr_t base_paddr;
 	uint8_t *key;
-#ifndef WLAN_SUPPORT_RX_FISA
+#ifdef HAL_RX_FST_HOST_HASH
 	uint8_t  shifted_key[HAL_FST_HASH_KEY_SIZE_BYTES];
 	uint32_t key_cache[HAL_FST_HASH_KEY_SIZE_BYTES][1 << 8];
 #endif
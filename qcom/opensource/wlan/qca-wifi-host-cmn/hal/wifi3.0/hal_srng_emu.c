@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) 2026 Qualcomm Innovation Center, Inc. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted, provided that the
+ * above copyright notice and this permission notice appear in all
+ * copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#include "qdf_module.h"
+#include "hal_api.h"
+#include "hal_srng_emu.h"
+
+static inline uint32_t hal_srng_emu_next(struct hal_srng *srng, uint32_t idx)
+{
+	idx += srng->entry_size;
+	if (idx == srng->ring_size)
+		idx = 0;
+
+	return idx;
+}
+
+/* Tail pointer of a destination ring as the target sees it */
+static inline uint32_t hal_srng_emu_dst_sw_tp(struct hal_srng *srng)
+{
+	if (srng->flags & HAL_SRNG_LMAC_RING)
+		return qdf_le32_to_cpu(*(volatile uint32_t *)
+				       srng->u.dst_ring.tp_addr);
+
+	return srng->u.dst_ring.tp;
+}
+
+/* Head pointer of a source ring as the target sees it */
+static inline uint32_t hal_srng_emu_src_sw_hp(struct hal_srng *srng)
+{
+	if (srng->flags & HAL_SRNG_LMAC_RING)
+		return qdf_le32_to_cpu(*(volatile uint32_t *)
+				       srng->u.src_ring.hp_addr);
+
+	return srng->u.src_ring.hp;
+}
+
+QDF_STATUS hal_srng_emu_dst_produce(hal_ring_handle_t hal_ring_hdl,
+				    const void *desc)
+{
+	struct hal_srng *srng = (struct hal_srng *)hal_ring_hdl;
+	uint32_t hp;
+
+	if (qdf_unlikely(srng->ring_dir != HAL_SRNG_DST_RING))
+		return QDF_STATUS_E_INVAL;
+
+	hp = *srng->u.dst_ring.hp_addr;
+
+	/* One slot is kept empty so that hp == tp always means empty */
+	if (hal_srng_emu_next(srng, hp) == hal_srng_emu_dst_sw_tp(srng))
+		return QDF_STATUS_E_RESOURCES;
+
+	qdf_mem_copy(&srng->ring_base_vaddr[hp], desc,
+		     srng->entry_size << 2);
+
+	/* Entry must be visible before SW can see the new head pointer */
+	qdf_wmb();
+	*srng->u.dst_ring.hp_addr = hal_srng_emu_next(srng, hp);
+
+	return QDF_STATUS_SUCCESS;
+}
+
+qdf_export_symbol(hal_srng_emu_dst_produce);
+
+QDF_STATUS hal_srng_emu_src_consume(hal_ring_handle_t hal_ring_hdl,
+				    void *desc)
+{
+	struct hal_srng *srng = (struct hal_srng *)hal_ring_hdl;
+	uint32_t tp;
+
+	if (qdf_unlikely(srng->ring_dir != HAL_SRNG_SRC_RING))
+		return QDF_STATUS_E_INVAL;
+
+	tp = *srng->u.src_ring.tp_addr;
+	if (tp == hal_srng_emu_src_sw_hp(srng))
+		return QDF_STATUS_E_EMPTY;
+
+	/* Pairs with the SW update of hp after writing the entry */
+	qdf_rmb();
+	if (desc)
+		qdf_mem_copy(desc, &srng->ring_base_vaddr[tp],
+			     srng->entry_size << 2);
+
+	*srng->u.src_ring.tp_addr = hal_srng_emu_next(srng, tp);
+
+	return QDF_STATUS_SUCCESS;
+}
+
+qdf_export_symbol(hal_srng_emu_src_consume);
@@ -0,0 +1,60 @@
+/*
+ * Copyright (c) 2026 Qualcomm Innovation Center, Inc. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted, provided that the
+ * above copyright notice and this permission notice appear in all
+ * copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#ifndef _HAL_SRNG_EMU_H_
+#define _HAL_SRNG_EMU_H_
+
+/*
+ * SRNG emulator
+ *
+ * Plays the hardware end of an SRNG ring, so ring handling can be
+ * driven without a target. On a destination ring (REO2SW, WBM2SW) the
+ * emulator writes entries and publishes the head pointer through the
+ * shadow hp_addr that SW reads from memory. On a source ring
+ * (SW2RXDMA, TCL data) it reads the entries SW posted and publishes the
+ * tail pointer through the shadow tp_addr.
+ *
+ * For LMAC rings SW publishes its own pointer to shared memory, and the
+ * emulator reads it from there. For other rings SW writes a register,
+ * so the emulator uses the SW copy in struct hal_srng instead.
+ */
+
+#ifdef HAL_SRNG_EMU
+#include "hal_api.h"
+
+/**
+ * hal_srng_emu_dst_produce() - Write one entry into a destination ring
+ * @hal_ring_hdl: destination ring
+ * @desc: entry of the ring's entry size
+ *
+ * Return: QDF_STATUS_SUCCESS or QDF_STATUS_E_RESOURCES if the ring is full
+ */
+QDF_STATUS hal_srng_emu_dst_produce(hal_ring_handle_t hal_ring_hdl,
+				    const void *desc);
+
+/**
+ * hal_srng_emu_src_consume() - Read one entry from a source ring
+ * @hal_ring_hdl: source ring
+ * @desc: buffer of the ring's entry size, may be NULL to drop the entry
+ *
+ * Return: QDF_STATUS_SUCCESS or QDF_STATUS_E_EMPTY if SW posted nothing
+ */
+QDF_STATUS hal_srng_emu_src_consume(hal_ring_handle_t hal_ring_hdl,
+				    void *desc);
+#endif /* HAL_SRNG_EMU */
+#endif /* _HAL_SRNG_EMU_H_ */
@@ -0,0 +1,346 @@
+/*
+ * Copyright (c) 2026 Qualcomm Innovation Center, Inc. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted, provided that the
+ * above copyright notice and this permission notice appear in all
+ * copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#include "dp_types.h"
+#include "hal_internal.h"
+#include "hal_rx_flow.h"
+#include "hal_rx_flow_test.h"
+#include "qdf_mem.h"
+#include "qdf_trace.h"
+
+/* Key of the Microsoft RSS verification suite */
+static const uint8_t hal_rx_flow_ut_ms_key[HAL_FST_HASH_KEY_SIZE_BYTES] = {
+	0x6d, 0x5a, 0x56, 0xda, 0x25, 0x5b, 0x0e, 0xc2,
+	0x41, 0x67, 0x25, 0x3d, 0x43, 0xa3, 0x8f, 0xb0,
+	0xd0, 0xca, 0x2b, 0xcb, 0xae, 0x7b, 0x30, 0xb4,
+	0x77, 0xcb, 0x2d, 0xa3, 0x80, 0x30, 0xf2, 0x0c,
+	0x6a, 0x42, 0xb7, 0x3b, 0xbe, 0xac, 0x01, 0xfa,
+};
+
+/**
+ * struct hal_rx_flow_ut_vector - Microsoft RSS verification vector
+ * @src_ip: source address, network order
+ * @dst_ip: destination address, network order
+ * @src_port: source port
+ * @dst_port: destination port
+ * @ip_hash: hash of the addresses only
+ * @tcp_hash: hash of the addresses and ports
+ */
+struct hal_rx_flow_ut_vector {
+	uint8_t src_ip[16];
+	uint8_t dst_ip[16];
+	uint16_t src_port;
+	uint16_t dst_port;
+	uint32_t ip_hash;
+	uint32_t tcp_hash;
+};
+
+static const struct hal_rx_flow_ut_vector hal_rx_flow_ut_ipv4[] = {
+	{ {66, 9, 149, 187}, {161, 142, 100, 80}, 2794, 1766,
+	  0x323e8fc2, 0x51ccc178 },
+	{ {199, 92, 111, 2}, {65, 69, 140, 83}, 14230, 4739,
+	  0xd718262a, 0xc626b0ea },
+	{ {24, 19, 198, 95}, {12, 22, 207, 184}, 12898, 38024,
+	  0xd2d0a5de, 0x5c2b394a },
+	{ {38, 27, 205, 30}, {209, 142, 163, 6}, 48228, 2217,
+	  0x82989176, 0xafc7327f },
+	{ {153, 39, 163, 191}, {202, 188, 127, 2}, 44251, 1303,
+	  0x5d1809c5, 0x10e828a2 },
+};
+
+static const struct hal_rx_flow_ut_vector hal_rx_flow_ut_ipv6[] = {
+	/* 3ffe:2501:200:1fff::7 -> 3ffe:2501:200:3::1 */
+	{ {0x3f, 0xfe, 0x25, 0x01, 0x02, 0x00, 0x1f, 0xff,
+	   0, 0, 0, 0, 0, 0, 0, 0x07},
+	  {0x3f, 0xfe, 0x25, 0x01, 0x02, 0x00, 0x00, 0x03,
+	   0, 0, 0, 0, 0, 0, 0, 0x01},
+	  2794, 1766, 0x2cc18cd5, 0x40207d3d },
+	/* 3ffe:501:8::260:97ff:fe40:efab -> ff02::1 */
+	{ {0x3f, 0xfe, 0x05, 0x01, 0x00, 0x08, 0x00, 0x00,
+	   0x02, 0x60, 0x97, 0xff, 0xfe, 0x40, 0xef, 0xab},
+	  {0xff, 0x02, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0x01},
+	  14230, 4739, 0x0f0c461c, 0xdde51bbf },
+	/* 3ffe:1900:4545:3:200:f8ff:fe21:67cf -> fe80::200:f8ff:fe21:67cf */
+	{ {0x3f, 0xfe, 0x19, 0x00, 0x45, 0x45, 0x00, 0x03,
+	   0x02, 0x00, 0xf8, 0xff, 0xfe, 0x21, 0x67, 0xcf},
+	  {0xfe, 0x80, 0, 0, 0, 0, 0, 0,
+	   0x02, 0x00, 0xf8, 0xff, 0xfe, 0x21, 0x67, 0xcf},
+	  44251, 38024, 0x4b61e985, 0x02d1feef },
+};
+
+/* Toeplitz hash as in the Microsoft spec, one input bit at a time */
+static uint32_t hal_rx_flow_ut_toeplitz(const uint8_t *key, uint32_t key_len,
+					const uint8_t *data, uint32_t len)
+{
+	uint32_t window = ((uint32_t)key[0] << 24) | (key[1] << 16) |
+			  (key[2] << 8) | key[3];
+	uint32_t hash = 0;
+	uint32_t i;
+	int bit;
+
+	for (i = 0; i < len; i++) {
+		for (bit = 7; bit >= 0; bit--) {
+			if (data[i] & (1 << bit))
+				hash ^= window;
+			window <<= 1;
+			if (i + 4 < key_len && (key[i + 4] & (1 << bit)))
+				window |= 1;
+		}
+	}
+
+	return hash;
+}
+
+static uint32_t
+hal_rx_flow_ut_check_vector(const struct hal_rx_flow_ut_vector *vector,
+			    uint8_t ip_len)
+{
+	uint8_t data[2 * 16 + 4];
+	uint32_t errors = 0;
+
+	qdf_mem_copy(data, vector->src_ip, ip_len);
+	qdf_mem_copy(data + ip_len, vector->dst_ip, ip_len);
+	data[2 * ip_len] = vector->src_port >> 8;
+	data[2 * ip_len + 1] = vector->src_port & 0xff;
+	data[2 * ip_len + 2] = vector->dst_port >> 8;
+	data[2 * ip_len + 3] = vector->dst_port & 0xff;
+
+	if (hal_rx_flow_ut_toeplitz(hal_rx_flow_ut_ms_key,
+				    sizeof(hal_rx_flow_ut_ms_key), data,
+				    2 * ip_len) != vector->ip_hash)
+		errors++;
+
+	if (hal_rx_flow_ut_toeplitz(hal_rx_flow_ut_ms_key,
+				    sizeof(hal_rx_flow_ut_ms_key), data,
+				    2 * ip_len + 4) != vector->tcp_hash)
+		errors++;
+
+	return errors;
+}
+
+/* the reference used below must reproduce the Microsoft vectors */
+static uint32_t hal_rx_flow_ut_ms_vectors(void)
+{
+	uint32_t errors = 0;
+	uint32_t i;
+
+	for (i = 0; i < QDF_ARRAY_SIZE(hal_rx_flow_ut_ipv4); i++)
+		errors += hal_rx_flow_ut_check_vector(&hal_rx_flow_ut_ipv4[i],
+						      4);
+
+	for (i = 0; i < QDF_ARRAY_SIZE(hal_rx_flow_ut_ipv6); i++)
+		errors += hal_rx_flow_ut_check_vector(&hal_rx_flow_ut_ipv6[i],
+						      16);
+
+	QDF_BUG(!errors);
+
+	return errors;
+}
+
+/* 2^15 entries, the largest power of two max_entries can hold */
+#define hal_rx_flow_ut_fst_entries (1 << 15)
+#define hal_rx_flow_ut_random_flows 4096
+/* any non-zero CMEM base keeps attach away from DMA memory */
+#define hal_rx_flow_ut_cmem_base 0x1000
+
+static uint32_t hal_rx_flow_ut_ip_word(const uint8_t *ip)
+{
+	return ((uint32_t)ip[0] << 24) | (ip[1] << 16) | (ip[2] << 8) | ip[3];
+}
+
+static void
+hal_rx_flow_ut_vector_to_flow(const struct hal_rx_flow_ut_vector *vector,
+			      bool ipv6, struct hal_rx_flow *flow)
+{
+	struct hal_flow_tuple_info *tuple = &flow->tuple_info;
+
+	qdf_mem_zero(flow, sizeof(*flow));
+
+	if (ipv6) {
+		tuple->src_ip_127_96 = hal_rx_flow_ut_ip_word(vector->src_ip);
+		tuple->src_ip_95_64 =
+			hal_rx_flow_ut_ip_word(vector->src_ip + 4);
+		tuple->src_ip_63_32 =
+			hal_rx_flow_ut_ip_word(vector->src_ip + 8);
+		tuple->src_ip_31_0 =
+			hal_rx_flow_ut_ip_word(vector->src_ip + 12);
+		tuple->dest_ip_127_96 = hal_rx_flow_ut_ip_word(vector->dst_ip);
+		tuple->dest_ip_95_64 =
+			hal_rx_flow_ut_ip_word(vector->dst_ip + 4);
+		tuple->dest_ip_63_32 =
+			hal_rx_flow_ut_ip_word(vector->dst_ip + 8);
+		tuple->dest_ip_31_0 =
+			hal_rx_flow_ut_ip_word(vector->dst_ip + 12);
+	} else {
+		tuple->src_ip_31_0 = hal_rx_flow_ut_ip_word(vector->src_ip);
+		tuple->dest_ip_31_0 = hal_rx_flow_ut_ip_word(vector->dst_ip);
+	}
+
+	tuple->src_port = vector->src_port;
+	tuple->dest_port = vector->dst_port;
+	/* TCP */
+	tuple->l4_protocol = 6;
+}
+
+/*
+ * FST hash of @flow, computed bit by bit: the 37 byte FST input, taken
+ * last byte first, hashed with the shifted key hal_rx_fst_attach() made
+ */
+static uint32_t hal_rx_flow_ut_fst_ref(struct hal_rx_fst *fst,
+				       struct hal_rx_flow *flow)
+{
+	struct hal_flow_tuple_info *tuple = &flow->tuple_info;
+	uint32_t input[HAL_FST_HASH_KEY_SIZE_WORDS];
+	uint8_t data[HAL_FST_HASH_DATA_SIZE];
+	uint8_t *bytes = (uint8_t *)input;
+	uint32_t hash;
+	int i;
+
+	input[0] = qdf_htonl(tuple->src_ip_127_96);
+	input[1] = qdf_htonl(tuple->src_ip_95_64);
+	input[2] = qdf_htonl(tuple->src_ip_63_32);
+	input[3] = qdf_htonl(tuple->src_ip_31_0);
+	input[4] = qdf_htonl(tuple->dest_ip_127_96);
+	input[5] = qdf_htonl(tuple->dest_ip_95_64);
+	input[6] = qdf_htonl(tuple->dest_ip_63_32);
+	input[7] = qdf_htonl(tuple->dest_ip_31_0);
+	input[8] = ((uint32_t)tuple->dest_port << 16) | tuple->src_port;
+	input[9] = tuple->l4_protocol;
+
+	for (i = 0; i < HAL_FST_HASH_DATA_SIZE; i++)
+		data[i] = bytes[HAL_FST_HASH_DATA_SIZE - 1 - i];
+
+	hash = hal_rx_flow_ut_toeplitz(fst->shifted_key,
+				       HAL_FST_HASH_KEY_SIZE_BYTES,
+				       data, HAL_FST_HASH_DATA_SIZE);
+
+	return (hash >> 12) & fst->hash_mask;
+}
+
+static uint32_t hal_rx_flow_ut_random(uint32_t *state)
+{
+	/* xorshift32 */
+	*state ^= *state << 13;
+	*state ^= *state >> 17;
+	*state ^= *state << 5;
+
+	return *state;
+}
+
+static void hal_rx_flow_ut_random_flow(uint32_t *state,
+				       struct hal_rx_flow *flow)
+{
+	struct hal_flow_tuple_info *tuple = &flow->tuple_info;
+	bool ipv6 = hal_rx_flow_ut_random(state) & 1;
+
+	qdf_mem_zero(flow, sizeof(*flow));
+
+	if (ipv6) {
+		tuple->src_ip_127_96 = hal_rx_flow_ut_random(state);
+		tuple->src_ip_95_64 = hal_rx_flow_ut_random(state);
+		tuple->src_ip_63_32 = hal_rx_flow_ut_random(state);
+		tuple->dest_ip_127_96 = hal_rx_flow_ut_random(state);
+		tuple->dest_ip_95_64 = hal_rx_flow_ut_random(state);
+		tuple->dest_ip_63_32 = hal_rx_flow_ut_random(state);
+	}
+
+	tuple->src_ip_31_0 = hal_rx_flow_ut_random(state);
+	tuple->dest_ip_31_0 = hal_rx_flow_ut_random(state);
+	/* mask bytes off at times, zero bytes are skipped by the cache walk */
+	if (!(hal_rx_flow_ut_random(state) & 3))
+		tuple->src_ip_31_0 &= 0xff00ff00;
+	tuple->src_port = hal_rx_flow_ut_random(state);
+	tuple->dest_port = hal_rx_flow_ut_random(state);
+	tuple->l4_protocol = (hal_rx_flow_ut_random(state) & 1) ? 6 : 17;
+}
+
+static uint32_t hal_rx_flow_ut_fst_hash(void)
+{
+	struct hal_hw_txrx_ops *ops;
+	struct hal_soc *hal_soc;
+	qdf_device_t qdf_dev;
+	struct hal_rx_fst *fst;
+	struct hal_rx_flow flow;
+	uint64_t fst_base;
+	uint32_t state = 0x12345678;
+	uint32_t errors = 0;
+	uint32_t i;
+
+	ops = qdf_mem_malloc(sizeof(*ops));
+	hal_soc = qdf_mem_malloc(sizeof(*hal_soc));
+	qdf_dev = qdf_mem_malloc(sizeof(*qdf_dev));
+	if (!ops || !hal_soc || !qdf_dev) {
+		errors++;
+		goto free_mem;
+	}
+	hal_soc->ops = ops;
+
+	fst = hal_rx_fst_attach((hal_soc_handle_t)hal_soc, qdf_dev, &fst_base,
+				hal_rx_flow_ut_fst_entries, 16,
+				(uint8_t *)hal_rx_flow_ut_ms_key,
+				hal_rx_flow_ut_cmem_base);
+	if (!fst) {
+		errors++;
+		goto free_mem;
+	}
+
+	/* the Microsoft tuples, and random ones, through the key cache */
+	for (i = 0; i < QDF_ARRAY_SIZE(hal_rx_flow_ut_ipv4); i++) {
+		hal_rx_flow_ut_vector_to_flow(&hal_rx_flow_ut_ipv4[i], false,
+					      &flow);
+		if (hal_flow_toeplitz_hash(fst, &flow) !=
+		    hal_rx_flow_ut_fst_ref(fst, &flow))
+			errors++;
+	}
+
+	for (i = 0; i < QDF_ARRAY_SIZE(hal_rx_flow_ut_ipv6); i++) {
+		hal_rx_flow_ut_vector_to_flow(&hal_rx_flow_ut_ipv6[i], true,
+					      &flow);
+		if (hal_flow_toeplitz_hash(fst, &flow) !=
+		    hal_rx_flow_ut_fst_ref(fst, &flow))
+			errors++;
+	}
+
+	for (i = 0; i < hal_rx_flow_ut_random_flows; i++) {
+		hal_rx_flow_ut_random_flow(&state, &flow);
+		if (hal_flow_toeplitz_hash(fst, &flow) !=
+		    hal_rx_flow_ut_fst_ref(fst, &flow))
+			errors++;
+	}
+
+	QDF_BUG(!errors);
+	hal_rx_fst_detach((hal_soc_handle_t)hal_soc, fst, qdf_dev,
+			  hal_rx_flow_ut_cmem_base);
+
+free_mem:
+	qdf_mem_free(qdf_dev);
+	qdf_mem_free(hal_soc);
+	qdf_mem_free(ops);
+
+	return errors;
+}
+
+uint32_t hal_rx_flow_unit_test(void)
+{
+	uint32_t errors = 0;
+
+	errors += hal_rx_flow_ut_ms_vectors();
+	errors += hal_rx_flow_ut_fst_hash();
+
+	return errors;
+}
@@ -0,0 +1,238 @@
+/*
+ * Copyright (c) 2026 Qualcomm Innovation Center, Inc. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted, provided that the
+ * above copyright notice and this permission notice appear in all
+ * copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#include "hal_api.h"
+#include "hal_srng_test.h"
+#include "hal_srng_emu.h"
+#include "qdf_mem.h"
+#include "qdf_trace.h"
+
+/* Odd entry count so the ring size is not a power of two */
+#define hal_srng_ut_entries 13
+/* Entry size of a REO destination ring, in words */
+#define hal_srng_ut_entry_size 8
+
+static struct hal_srng *hal_srng_ut_ring_create(void)
+{
+	struct hal_srng *srng;
+	uint32_t i;
+
+	srng = qdf_mem_malloc(sizeof(*srng));
+	if (!srng)
+		return NULL;
+
+	srng->ring_base_vaddr =
+		qdf_mem_malloc(hal_srng_ut_entries * hal_srng_ut_entry_size *
+			       sizeof(uint32_t));
+	if (!srng->ring_base_vaddr) {
+		qdf_mem_free(srng);
+		return NULL;
+	}
+
+	srng->ring_dir = HAL_SRNG_DST_RING;
+	srng->entry_size = hal_srng_ut_entry_size;
+	srng->num_entries = hal_srng_ut_entries;
+	srng->ring_size = hal_srng_ut_entries * hal_srng_ut_entry_size;
+
+	/* tag each entry with its index */
+	for (i = 0; i < hal_srng_ut_entries; i++)
+		srng->ring_base_vaddr[i * hal_srng_ut_entry_size] = i;
+
+	return srng;
+}
+
+static void hal_srng_ut_ring_destroy(struct hal_srng *srng)
+{
+	qdf_mem_free(srng->ring_base_vaddr);
+	qdf_mem_free(srng);
+}
+
+static uint32_t hal_srng_ut_get_ahead(void)
+{
+	hal_ring_handle_t hdl;
+	struct hal_srng *srng;
+	uint32_t *ahead[hal_srng_ut_entries - 1];
+	uint32_t *desc;
+	uint32_t errors = 0;
+	uint32_t start, off;
+
+	srng = hal_srng_ut_ring_create();
+	if (!srng)
+		return 1;
+
+	hdl = (hal_ring_handle_t)srng;
+
+	/* from every TP, with all but one entry valid, get_ahead() should ... */
+	for (start = 0; start < hal_srng_ut_entries; start++) {
+		srng->u.dst_ring.tp = start * hal_srng_ut_entry_size;
+		srng->u.dst_ring.cached_hp =
+			((start + hal_srng_ut_entries - 1) %
+			 hal_srng_ut_entries) * hal_srng_ut_entry_size;
+
+		/* ... return the entry at that offset, wrapping at the end */
+		for (off = 0; off < hal_srng_ut_entries - 1; off++) {
+			ahead[off] = hal_srng_dst_get_ahead(NULL, hdl, off);
+			if (*ahead[off] !=
+			    (start + off) % hal_srng_ut_entries)
+				errors++;
+		}
+
+		/* ... return what get_next() walks through, in order */
+		for (off = 0; off < hal_srng_ut_entries - 1; off++) {
+			desc = hal_srng_dst_get_next(NULL, hdl);
+			if (desc != ahead[off])
+				errors++;
+		}
+
+		/* ... and leave nothing past the HP */
+		QDF_BUG(!hal_srng_dst_get_next(NULL, hdl));
+	}
+
+	QDF_BUG(!errors);
+	hal_srng_ut_ring_destroy(srng);
+
+	return errors;
+}
+
+#ifdef HAL_SRNG_EMU
+/* Laps around the ring, so head and tail wrap several times */
+#define hal_srng_ut_emu_laps 3
+
+/* Consumes up to @num entries, checking they come in @seq order */
+static uint32_t hal_srng_ut_emu_reap(struct hal_srng *srng, uint32_t num,
+				     uint32_t *seq)
+{
+	hal_ring_handle_t hdl = (hal_ring_handle_t)srng;
+	uint32_t *desc;
+	uint32_t reaped = 0;
+	uint32_t errors = 0;
+
+	hal_srng_access_start_unlocked(NULL, hdl);
+	while (reaped < num && (desc = hal_srng_dst_get_next(NULL, hdl))) {
+		if (desc[0] != (*seq)++)
+			errors++;
+		reaped++;
+	}
+	hal_srng_access_end_unlocked(NULL, hdl);
+
+	/* the tail pointer is published for the producer to see */
+	if (*srng->u.dst_ring.tp_addr != srng->u.dst_ring.tp)
+		errors++;
+
+	return errors + (num - reaped);
+}
+
+static uint32_t hal_srng_ut_emu_dst(void)
+{
+	hal_ring_handle_t hdl;
+	struct hal_srng *srng;
+	uint32_t *shadow;
+	uint32_t desc[hal_srng_ut_entry_size] = { 0 };
+	uint32_t errors = 0;
+	uint32_t produced = 0, reaped = 0;
+	uint32_t lap, i;
+
+	srng = hal_srng_ut_ring_create();
+	if (!srng)
+		return 1;
+
+	shadow = qdf_mem_malloc(2 * sizeof(*shadow));
+	if (!shadow) {
+		hal_srng_ut_ring_destroy(srng);
+		return 1;
+	}
+
+	hdl = (hal_ring_handle_t)srng;
+
+	/* pointers are exchanged through memory, as with an LMAC ring */
+	srng->flags |= HAL_SRNG_LMAC_RING;
+	srng->u.dst_ring.hp_addr = &shadow[0];
+	srng->u.dst_ring.tp_addr = &shadow[1];
+
+	/* an empty ring has nothing to reap */
+	hal_srng_access_start_unlocked(NULL, hdl);
+	if (hal_srng_dst_get_next(NULL, hdl))
+		errors++;
+	hal_srng_access_end_unlocked(NULL, hdl);
+
+	for (lap = 0; lap < hal_srng_ut_emu_laps; lap++) {
+		/* fill: one slot stays empty, so a full ring is one short */
+		while (produced - reaped < hal_srng_ut_entries - 1) {
+			desc[0] = produced;
+			if (hal_srng_emu_dst_produce(hdl, desc) !=
+			    QDF_STATUS_SUCCESS) {
+				errors++;
+				break;
+			}
+			produced++;
+		}
+
+		desc[0] = produced;
+		if (hal_srng_emu_dst_produce(hdl, desc) !=
+		    QDF_STATUS_E_RESOURCES)
+			errors++;
+
+		/* reaping a few makes room for exactly that many more */
+		errors += hal_srng_ut_emu_reap(srng, 5, &reaped);
+
+		for (i = 0; i < 5; i++) {
+			desc[0] = produced;
+			if (hal_srng_emu_dst_produce(hdl, desc) !=
+			    QDF_STATUS_SUCCESS)
+				errors++;
+			else
+				produced++;
+		}
+
+		desc[0] = produced;
+		if (hal_srng_emu_dst_produce(hdl, desc) !=
+		    QDF_STATUS_E_RESOURCES)
+			errors++;
+
+		/* drain down to 2 outstanding entries */
+		errors += hal_srng_ut_emu_reap(srng, produced - reaped - 2,
+					       &reaped);
+	}
+
+	/* drain, after which head and tail meet again */
+	errors += hal_srng_ut_emu_reap(srng, produced - reaped, &reaped);
+	if (shadow[0] != shadow[1] || produced != reaped)
+		errors++;
+
+	QDF_BUG(!errors);
+	qdf_mem_free(shadow);
+	hal_srng_ut_ring_destroy(srng);
+
+	return errors;
+}
+#else
+static uint32_t hal_srng_ut_emu_dst(void)
+{
+	return 0;
+}
+#endif /* HAL_SRNG_EMU */
+
+uint32_t hal_srng_unit_test(void)
+{
+	uint32_t errors = 0;
+
+	errors += hal_srng_ut_get_ahead();
+	errors += hal_srng_ut_emu_dst();
+
+	return errors;
+}
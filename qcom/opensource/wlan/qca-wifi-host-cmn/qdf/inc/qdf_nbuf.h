@@ -3067,6 +3067,30 @@ qdf_nbuf_append_ext_list(qdf_nbuf_t head_buf, qdf_nbuf_t ext_list,
 	__qdf_nbuf_append_ext_list(head_buf, ext_list, ext_len);
 }
 
+/**
+ * qdf_nbuf_try_coalesce() - Append the data of a network buf to another
+ * @to: Network buf to extend, must not have an extension list
+ * @from: Network buf whose data is appended
+ *
+ * The data of @from is attached to @to as a page frag when its head can
+ * be shared, or copied when it fits in the tailroom of @to. Buffers from
+ * the platform pre-alloc pool and IPA owned buffers are left alone.
+ *
+ * Return: true if appended and @from freed, false if nothing was done
+ */
+static inline bool qdf_nbuf_try_coalesce(qdf_nbuf_t to, qdf_nbuf_t from)
+{
+	bool stolen;
+
+	if (!__qdf_nbuf_try_coalesce(to, from, &stolen))
+		return false;
+
+	qdf_net_buf_debug_release_skb(from);
+	__qdf_nbuf_free_coalesced(from, stolen);
+
+	return true;
+}
+
 /**
  * qdf_nbuf_get_ext_list() - Get the link to extended nbuf list.
  * @head_buf: Network buf holding head segment (single)
@@ -0,0 +1,205 @@
+/*
+ * Copyright (c) 2023 Qualcomm Innovation Center, Inc. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted, provided that the
+ * above copyright notice and this permission notice appear in all
+ * copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+/**
+ * DOC: qdf_rcu.h - Public APIs for read-copy-update protected lists
+ *
+ * Readers walk a qdf_hlist_head between qdf_rcu_read_lock() and
+ * qdf_rcu_read_unlock() without taking the writer's lock. Writers still
+ * serialize against each other, and an unlinked entry may only be freed
+ * once a grace period has elapsed (qdf_call_rcu() or qdf_synchronize_rcu()).
+ */
+
+#ifndef __QDF_RCU_H
+#define __QDF_RCU_H
+
+#include "i_qdf_rcu.h"
+
+/**
+ * struct qdf_rcu_head - opaque callback head for deferred frees
+ */
+#define qdf_rcu_head __qdf_rcu_head
+
+/**
+ * qdf_rcu_read_lock() - enter an RCU read-side critical section
+ *
+ * Return: None
+ */
+#define qdf_rcu_read_lock() __qdf_rcu_read_lock()
+
+/**
+ * qdf_rcu_read_unlock() - leave an RCU read-side critical section
+ *
+ * Return: None
+ */
+#define qdf_rcu_read_unlock() __qdf_rcu_read_unlock()
+
+/**
+ * qdf_synchronize_rcu() - wait for all pre-existing readers to finish
+ *
+ * May sleep; must not be called from atomic context.
+ *
+ * Return: None
+ */
+#define qdf_synchronize_rcu() __qdf_synchronize_rcu()
+
+/**
+ * qdf_call_rcu() - invoke @func once all pre-existing readers are done
+ * @head: qdf_rcu_head embedded in the object being retired
+ * @func: callback, typically freeing the containing object
+ *
+ * Safe to call from atomic context.
+ *
+ * Return: None
+ */
+#define qdf_call_rcu(head, func) __qdf_call_rcu(head, func)
+
+/**
+ * qdf_rcu_barrier() - wait for all queued qdf_call_rcu() callbacks to run
+ *
+ * Return: None
+ */
+#define qdf_rcu_barrier() __qdf_rcu_barrier()
+
+/**
+ * struct qdf_hlist_head - opaque head of an RCU capable hash bucket list
+ */
+#define qdf_hlist_head __qdf_hlist_head
+
+/**
+ * struct qdf_hlist_node - opaque entry for membership in a qdf_hlist_head
+ */
+#define qdf_hlist_node __qdf_hlist_node
+
+/**
+ * qdf_hlist_head_init() - initialize an empty qdf_hlist_head
+ * @head: pointer to the list head
+ */
+#define qdf_hlist_head_init(head) __qdf_hlist_head_init(head)
+
+/**
+ * qdf_hlist_node_init() - initialize a qdf_hlist_node as unhashed
+ * @node: pointer to the list node
+ */
+#define qdf_hlist_node_init(node) __qdf_hlist_node_init(node)
+
+/**
+ * qdf_hlist_empty() - check if a qdf_hlist_head has no entries
+ * @head: pointer to the list head
+ */
+#define qdf_hlist_empty(head) __qdf_hlist_empty(head)
+
+/**
+ * qdf_hlist_unhashed() - check if a qdf_hlist_node is on a list
+ * @node: pointer to the list node
+ */
+#define qdf_hlist_unhashed(node) __qdf_hlist_unhashed(node)
+
+/**
+ * qdf_hlist_add_tail_rcu() - publish @node at the tail of @head
+ * @node: pointer to the node to add
+ * @head: pointer to the list head
+ *
+ * Caller must hold the writer-side lock.
+ */
+#define qdf_hlist_add_tail_rcu(node, head) __qdf_hlist_add_tail_rcu(node, head)
+
+/**
+ * qdf_hlist_del_init_rcu() - unlink @node, leaving it walkable by readers
+ * @node: pointer to the node to remove
+ *
+ * Caller must hold the writer-side lock and defer freeing the containing
+ * object until a grace period has elapsed.
+ */
+#define qdf_hlist_del_init_rcu(node) __qdf_hlist_del_init_rcu(node)
+
+/**
+ * qdf_hlist_for_each_entry() - iterate a list under the writer-side lock
+ * @cursor: type * to use as the loop cursor
+ * @head: pointer to the list head
+ * @entry_field: name of the qdf_hlist_node field in the cursor type
+ */
+#define qdf_hlist_for_each_entry(cursor, head, entry_field) \
+	__qdf_hlist_for_each_entry(cursor, head, entry_field)
+
+/**
+ * qdf_hlist_for_each_entry_safe() - iterate a list, allowing removal
+ * @cursor: type * to use as the loop cursor
+ * @tmp: struct qdf_hlist_node * used as temporary storage
+ * @head: pointer to the list head
+ * @entry_field: name of the qdf_hlist_node field in the cursor type
+ */
+#define qdf_hlist_for_each_entry_safe(cursor, tmp, head, entry_field) \
+	__qdf_hlist_for_each_entry_safe(cursor, tmp, head, entry_field)
+
+/**
+ * qdf_hlist_for_each_entry_rcu() - iterate a list inside qdf_rcu_read_lock()
+ * @cursor: type * to use as the loop cursor
+ * @head: pointer to the list head
+ * @entry_field: name of the qdf_hlist_node field in the cursor type
+ */
+#define qdf_hlist_for_each_entry_rcu(cursor, head, entry_field) \
+	__qdf_hlist_for_each_entry_rcu(cursor, head, entry_field)
+
+/**
+ * struct qdf_seqcount - opaque sequence counter
+ *
+ * Lets lockless readers detect that a writer modified the protected data
+ * while they were looking at it.
+ */
+#define qdf_seqcount __qdf_seqcount
+
+/**
+ * qdf_seqcount_init() - initialize a qdf_seqcount
+ * @seq: pointer to the sequence counter
+ */
+#define qdf_seqcount_init(seq) __qdf_seqcount_init(seq)
+
+/**
+ * qdf_read_seqcount_begin() - sample a sequence counter before reading
+ * @seq: pointer to the sequence counter
+ *
+ * Return: value to pass to qdf_read_seqcount_retry()
+ */
+#define qdf_read_seqcount_begin(seq) __qdf_read_seqcount_begin(seq)
+
+/**
+ * qdf_read_seqcount_retry() - check if a read raced with a writer
+ * @seq: pointer to the sequence counter
+ * @start: value returned by qdf_read_seqcount_begin()
+ *
+ * Return: true if the read must be retried
+ */
+#define qdf_read_seqcount_retry(seq, start) \
+	__qdf_read_seqcount_retry(seq, start)
+
+/**
+ * qdf_write_seqcount_begin() - mark the start of a modification
+ * @seq: pointer to the sequence counter
+ *
+ * Caller must hold the writer-side lock.
+ */
+#define qdf_write_seqcount_begin(seq) __qdf_write_seqcount_begin(seq)
+
+/**
+ * qdf_write_seqcount_end() - mark the end of a modification
+ * @seq: pointer to the sequence counter
+ */
+#define qdf_write_seqcount_end(seq) __qdf_write_seqcount_end(seq)
+
+#endif /* __QDF_RCU_H */
@@ -1474,6 +1474,30 @@ __qdf_nbuf_append_ext_list(struct sk_buff *skb_head,
 	skb_head->len += ext_len;
 }
 
+/**
+ * __qdf_nbuf_try_coalesce() - Merge the data of an skb into another skb
+ * @to: skb to extend
+ * @from: skb whose data is merged
+ * @stolen: set if the head of @from is now referenced by @to
+ *
+ * Buffers that may belong to the platform pre-alloc pool or are owned by
+ * IPA are never merged.
+ *
+ * Return: true if merged, @from must then be freed with
+ *	   __qdf_nbuf_free_coalesced()
+ */
+bool __qdf_nbuf_try_coalesce(struct sk_buff *to, struct sk_buff *from,
+			     bool *stolen);
+
+/**
+ * __qdf_nbuf_free_coalesced() - Free an skb merged by __qdf_nbuf_try_coalesce
+ * @skb: skb to free
+ * @stolen: its head is referenced by another skb and must not be freed
+ *
+ * Return: none
+ */
+void __qdf_nbuf_free_coalesced(struct sk_buff *skb, bool stolen);
+
 /**
  * __qdf_nbuf_get_shinfo() - return the shared info of the skb
  * @skb: Pointer to network buffer
@@ -732,6 +732,53 @@ void __qdf_nbuf_free(struct sk_buff *skb)
 
 qdf_export_symbol(__qdf_nbuf_free);
 
+bool __qdf_nbuf_try_coalesce(struct sk_buff *to, struct sk_buff *from,
+			     bool *stolen)
+{
+	uint32_t nr_frags;
+	int delta_truesize;
+
+	if (pld_nbuf_may_be_pre_alloc(to) || pld_nbuf_may_be_pre_alloc(from))
+		return false;
+
+	if (qdf_nbuf_ipa_owned_get(from))
+		return false;
+
+	nr_frags = __qdf_nbuf_get_nr_frags(to) + __qdf_nbuf_get_nr_frags(from);
+
+	if (!skb_try_coalesce(to, from, stolen, &delta_truesize))
+		return false;
+
+	/* frags of @from may have moved to @to, the ones left on @from are
+	 * dropped again when it is freed
+	 */
+	qdf_frag_count_dec(nr_frags);
+	qdf_frag_count_inc(__qdf_nbuf_get_nr_frags(to) +
+			   __qdf_nbuf_get_nr_frags(from));
+
+	return true;
+}
+
+qdf_export_symbol(__qdf_nbuf_try_coalesce);
+
+void __qdf_nbuf_free_coalesced(struct sk_buff *skb, bool stolen)
+{
+	qdf_nbuf_frag_count_dec(skb);
+
+	qdf_nbuf_count_dec(skb);
+	/* a merged skb is never IPA owned, so the free callback would only
+	 * have released it to the kernel
+	 */
+	if (stolen)
+		kfree_skb_partial(skb, true);
+	else if (nbuf_free_cb)
+		nbuf_free_cb(skb);
+	else
+		dev_kfree_skb_any(skb);
+}
+
+qdf_export_symbol(__qdf_nbuf_free_coalesced);
+
 __qdf_nbuf_t __qdf_nbuf_clone(__qdf_nbuf_t skb)
 {
 	qdf_nbuf_t skb_new = NULL;
@@ -0,0 +1,184 @@
+/*
+ * Copyright (c) 2026 Qualcomm Innovation Center, Inc. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted, provided that the
+ * above copyright notice and this permission notice appear in all
+ * copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#include "qdf_defer.h"
+#include "qdf_mem.h"
+#include "qdf_nbuf.h"
+#include "qdf_nbuf_test.h"
+#include "qdf_trace.h"
+
+#define qdf_nbuf_test_size 1500
+#define qdf_nbuf_test_len 1000
+
+/* Rx buffers are allocated with bottom halves disabled, which gives them a
+ * page frag head that can be attached to another nbuf
+ */
+static qdf_nbuf_t qdf_nbuf_test_alloc(uint32_t len, uint8_t fill)
+{
+	qdf_nbuf_t nbuf;
+
+	qdf_local_bh_disable();
+	nbuf = qdf_nbuf_alloc(NULL, qdf_nbuf_test_size, 0, 4, false);
+	qdf_local_bh_enable();
+	if (!nbuf)
+		return NULL;
+
+	/* zero @len fills the whole buffer, leaving no tailroom */
+	if (!len)
+		len = qdf_nbuf_tailroom(nbuf);
+	qdf_mem_set(qdf_nbuf_put_tail(nbuf, len), len, fill);
+
+	return nbuf;
+}
+
+/* check @len bytes of @nbuf from @offset are @fill, across frags */
+static uint32_t qdf_nbuf_test_check(qdf_nbuf_t nbuf, uint32_t offset,
+				    uint32_t len, uint8_t fill)
+{
+	uint8_t byte;
+	uint32_t i;
+
+	for (i = offset; i < offset + len; i++) {
+		if (qdf_nbuf_copy_bits(nbuf, i, 1, &byte) || byte != fill)
+			return 1;
+	}
+
+	return 0;
+}
+
+static uint32_t qdf_nbuf_test_coalesce_copy(void)
+{
+	qdf_nbuf_t to, from;
+	uint32_t errors = 0;
+
+	to = qdf_nbuf_test_alloc(100, 0xa);
+	from = qdf_nbuf_test_alloc(50, 0xb);
+	if (!to || !from) {
+		qdf_nbuf_free(to);
+		qdf_nbuf_free(from);
+		return 1;
+	}
+
+	/* a small nbuf is copied into the tailroom and freed */
+	if (!qdf_nbuf_try_coalesce(to, from)) {
+		qdf_nbuf_free(from);
+		errors++;
+	}
+
+	if (qdf_nbuf_len(to) != 150 || qdf_nbuf_get_nr_frags(to))
+		errors++;
+	errors += qdf_nbuf_test_check(to, 0, 100, 0xa);
+	errors += qdf_nbuf_test_check(to, 100, 50, 0xb);
+
+	QDF_BUG(!errors);
+	qdf_nbuf_free(to);
+
+	return errors;
+}
+
+static uint32_t qdf_nbuf_test_coalesce_stolen(void)
+{
+	qdf_nbuf_t to, from;
+	uint32_t to_len;
+	uint32_t errors = 0;
+
+	to = qdf_nbuf_test_alloc(0, 0xa);
+	from = qdf_nbuf_test_alloc(qdf_nbuf_test_len, 0xb);
+	if (!to || !from) {
+		qdf_nbuf_free(to);
+		qdf_nbuf_free(from);
+		return 1;
+	}
+
+	/* without tailroom, the head of @from becomes a frag of @to */
+	to_len = qdf_nbuf_len(to);
+	if (!qdf_nbuf_try_coalesce(to, from)) {
+		qdf_nbuf_free(from);
+		errors++;
+	}
+
+	if (qdf_nbuf_len(to) != to_len + qdf_nbuf_test_len ||
+	    qdf_nbuf_get_nr_frags(to) != 1)
+		errors++;
+	errors += qdf_nbuf_test_check(to, 0, to_len, 0xa);
+	errors += qdf_nbuf_test_check(to, to_len, qdf_nbuf_test_len, 0xb);
+
+	QDF_BUG(!errors);
+	qdf_nbuf_free(to);
+
+	return errors;
+}
+
+static uint32_t qdf_nbuf_test_coalesce_fallback(void)
+{
+	qdf_nbuf_t to, first, second, clone;
+	uint32_t to_len;
+	uint32_t errors = 0;
+
+	to = qdf_nbuf_test_alloc(0, 0xa);
+	first = qdf_nbuf_test_alloc(qdf_nbuf_test_len, 0xb);
+	second = qdf_nbuf_test_alloc(qdf_nbuf_test_len, 0xc);
+	clone = second ? qdf_nbuf_clone(second) : NULL;
+	if (!to || !first || !second || !clone) {
+		qdf_nbuf_free(to);
+		qdf_nbuf_free(first);
+		qdf_nbuf_free(second);
+		qdf_nbuf_free(clone);
+		return 1;
+	}
+
+	to_len = qdf_nbuf_len(to);
+	if (!qdf_nbuf_try_coalesce(to, first)) {
+		qdf_nbuf_free(first);
+		errors++;
+	}
+
+	/* the head of a cloned nbuf is shared and can not be attached, so
+	 * it goes on the frag_list as the Rx scatter-gather path does
+	 */
+	if (qdf_nbuf_try_coalesce(to, second))
+		errors++;
+	else
+		qdf_nbuf_append_ext_list(to, second, qdf_nbuf_len(second));
+
+	if (qdf_nbuf_len(to) != to_len + 2 * qdf_nbuf_test_len ||
+	    qdf_nbuf_get_nr_frags(to) != 1 ||
+	    qdf_nbuf_get_ext_list(to) != second)
+		errors++;
+	errors += qdf_nbuf_test_check(to, 0, to_len, 0xa);
+	errors += qdf_nbuf_test_check(to, to_len, qdf_nbuf_test_len, 0xb);
+	errors += qdf_nbuf_test_check(to, to_len + qdf_nbuf_test_len,
+				      qdf_nbuf_test_len, 0xc);
+
+	QDF_BUG(!errors);
+	qdf_nbuf_free(clone);
+	qdf_nbuf_free(to);
+
+	return errors;
+}
+
+uint32_t qdf_nbuf_unit_test(void)
+{
+	uint32_t errors = 0;
+
+	errors += qdf_nbuf_test_coalesce_copy();
+	errors += qdf_nbuf_test_coalesce_stolen();
+	errors += qdf_nbuf_test_coalesce_fallback();
+
+	return errors;
+}
@@ -0,0 +1,290 @@
+/*
+ * Copyright (c) 2023 Qualcomm Innovation Center, Inc. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted, provided that the
+ * above copyright notice and this permission notice appear in all
+ * copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#include "qdf_atomic.h"
+#include "qdf_defer.h"
+#include "qdf_lock.h"
+#include "qdf_mem.h"
+#include "qdf_rcu.h"
+#include "qdf_rcu_test.h"
+#include "qdf_threads.h"
+#include "qdf_trace.h"
+
+/* 8 buckets, 32 keys; enough collisions to keep each bucket busy */
+#define qdf_rcu_ut_bins 8
+#define qdf_rcu_ut_keys 32
+#define qdf_rcu_ut_readers 2
+#define qdf_rcu_ut_iterations (625 * qdf_rcu_ut_keys)
+
+#define qdf_rcu_ut_magic_live 0x11ae11ae
+#define qdf_rcu_ut_magic_dead 0xdeaddead
+
+struct qdf_rcu_ut_item {
+	uint32_t key;
+	uint32_t magic;
+	qdf_atomic_t ref_cnt;
+	struct qdf_hlist_node node;
+	struct qdf_rcu_head rcu;
+};
+
+struct qdf_rcu_ut_bin {
+	struct qdf_hlist_head head;
+	struct qdf_seqcount seq;
+};
+
+struct qdf_rcu_ut_ctx {
+	qdf_spinlock_t lock;
+	struct qdf_rcu_ut_bin bins[qdf_rcu_ut_bins];
+	qdf_atomic_t errors;
+	qdf_atomic_t hits;
+};
+
+static void qdf_rcu_ut_free(struct qdf_rcu_head *head)
+{
+	struct qdf_rcu_ut_item *item =
+		qdf_container_of(head, struct qdf_rcu_ut_item, rcu);
+
+	qdf_mem_free(item);
+}
+
+static void qdf_rcu_ut_put(struct qdf_rcu_ut_item *item)
+{
+	if (!qdf_atomic_dec_and_test(&item->ref_cnt))
+		return;
+
+	item->magic = qdf_rcu_ut_magic_dead;
+	qdf_call_rcu(&item->rcu, qdf_rcu_ut_free);
+}
+
+static struct qdf_rcu_ut_item *
+qdf_rcu_ut_find(struct qdf_rcu_ut_ctx *ctx, uint32_t key)
+{
+	struct qdf_rcu_ut_bin *bin = &ctx->bins[key % qdf_rcu_ut_bins];
+	struct qdf_rcu_ut_item *item;
+	unsigned int seq;
+
+	qdf_rcu_read_lock();
+	do {
+		seq = qdf_read_seqcount_begin(&bin->seq);
+		qdf_hlist_for_each_entry_rcu(item, &bin->head, node) {
+			if (item->key != key)
+				continue;
+
+			if (!qdf_atomic_inc_not_zero(&item->ref_cnt))
+				continue;
+
+			qdf_rcu_read_unlock();
+			return item;
+		}
+	} while (qdf_read_seqcount_retry(&bin->seq, seq));
+	qdf_rcu_read_unlock();
+
+	return NULL;
+}
+
+/* the writer toggles each key in and out of the table */
+static void qdf_rcu_ut_toggle(struct qdf_rcu_ut_ctx *ctx, uint32_t key)
+{
+	struct qdf_rcu_ut_bin *bin = &ctx->bins[key % qdf_rcu_ut_bins];
+	struct qdf_rcu_ut_item *item, *new_item;
+
+	new_item = qdf_mem_malloc(sizeof(*new_item));
+	if (!new_item) {
+		qdf_atomic_inc(&ctx->errors);
+		return;
+	}
+
+	new_item->key = key;
+	new_item->magic = qdf_rcu_ut_magic_live;
+	qdf_atomic_init(&new_item->ref_cnt);
+	qdf_atomic_inc(&new_item->ref_cnt);
+
+	qdf_spin_lock_bh(&ctx->lock);
+	qdf_hlist_for_each_entry(item, &bin->head, node) {
+		if (item->key == key)
+			break;
+	}
+
+	qdf_write_seqcount_begin(&bin->seq);
+	if (item)
+		qdf_hlist_del_init_rcu(&item->node);
+	else
+		qdf_hlist_add_tail_rcu(&new_item->node, &bin->head);
+	qdf_write_seqcount_end(&bin->seq);
+	qdf_spin_unlock_bh(&ctx->lock);
+
+	if (item) {
+		qdf_rcu_ut_put(item);
+		qdf_mem_free(new_item);
+	}
+}
+
+static QDF_STATUS qdf_rcu_ut_writer(void *context)
+{
+	struct qdf_rcu_ut_ctx *ctx = context;
+	uint32_t i;
+
+	for (i = 0; i < qdf_rcu_ut_iterations; i++)
+		qdf_rcu_ut_toggle(ctx, (i * 7) % qdf_rcu_ut_keys);
+
+	return QDF_STATUS_SUCCESS;
+}
+
+static QDF_STATUS qdf_rcu_ut_reader(void *context)
+{
+	struct qdf_rcu_ut_ctx *ctx = context;
+	struct qdf_rcu_ut_item *item;
+	uint32_t i, key;
+
+	for (i = 0; i < qdf_rcu_ut_iterations; i++) {
+		key = i % qdf_rcu_ut_keys;
+
+		qdf_local_bh_disable();
+		item = qdf_rcu_ut_find(ctx, key);
+		qdf_local_bh_enable();
+		if (!item)
+			continue;
+
+		/* a referenced item must be the one asked for, and alive */
+		if (item->key != key || item->magic != qdf_rcu_ut_magic_live)
+			qdf_atomic_inc(&ctx->errors);
+
+		qdf_atomic_inc(&ctx->hits);
+		qdf_rcu_ut_put(item);
+	}
+
+	return QDF_STATUS_SUCCESS;
+}
+
+static uint32_t qdf_rcu_ut_drain(struct qdf_rcu_ut_ctx *ctx)
+{
+	struct qdf_rcu_ut_item *item;
+	struct qdf_hlist_node *tmp;
+	uint32_t count = 0;
+	int i;
+
+	qdf_spin_lock_bh(&ctx->lock);
+	for (i = 0; i < qdf_rcu_ut_bins; i++) {
+		qdf_hlist_for_each_entry_safe(item, tmp, &ctx->bins[i].head,
+					      node) {
+			qdf_hlist_del_init_rcu(&item->node);
+			qdf_rcu_ut_put(item);
+			count++;
+		}
+	}
+	qdf_spin_unlock_bh(&ctx->lock);
+
+	return count;
+}
+
+static uint32_t qdf_rcu_ut_stress(void)
+{
+	qdf_thread_t *readers[qdf_rcu_ut_readers];
+	qdf_thread_t *writer;
+	struct qdf_rcu_ut_ctx *ctx;
+	uint32_t errors;
+	int i;
+
+	ctx = qdf_mem_malloc(sizeof(*ctx));
+	if (!ctx)
+		return 1;
+
+	qdf_spinlock_create(&ctx->lock);
+	for (i = 0; i < qdf_rcu_ut_bins; i++) {
+		qdf_hlist_head_init(&ctx->bins[i].head);
+		qdf_seqcount_init(&ctx->bins[i].seq);
+	}
+	qdf_atomic_init(&ctx->errors);
+	qdf_atomic_init(&ctx->hits);
+
+	/* concurrent add/remove against lockless, refcounted finds */
+	writer = qdf_thread_run(qdf_rcu_ut_writer, ctx);
+	QDF_BUG(writer);
+	for (i = 0; i < qdf_rcu_ut_readers; i++) {
+		readers[i] = qdf_thread_run(qdf_rcu_ut_reader, ctx);
+		QDF_BUG(readers[i]);
+	}
+
+	for (i = 0; i < qdf_rcu_ut_readers; i++) {
+		if (readers[i])
+			qdf_thread_join(readers[i]);
+	}
+	if (writer)
+		qdf_thread_join(writer);
+
+	/* each key was toggled an odd number of times, so all are present */
+	QDF_BUG(qdf_rcu_ut_drain(ctx) == qdf_rcu_ut_keys);
+	for (i = 0; i < qdf_rcu_ut_bins; i++)
+		QDF_BUG(qdf_hlist_empty(&ctx->bins[i].head));
+
+	/* all retired items must be freed before the context goes */
+	qdf_rcu_barrier();
+
+	errors = qdf_atomic_read(&ctx->errors);
+	QDF_BUG(!errors);
+	qdf_debug("rcu stress: %d hits", qdf_atomic_read(&ctx->hits));
+
+	qdf_spinlock_destroy(&ctx->lock);
+	qdf_mem_free(ctx);
+
+	return errors;
+}
+
+static uint32_t qdf_rcu_ut_single(void)
+{
+	struct qdf_rcu_ut_ctx *ctx;
+	struct qdf_rcu_ut_item *item;
+
+	ctx = qdf_mem_malloc(sizeof(*ctx));
+	if (!ctx)
+		return 1;
+
+	qdf_spinlock_create(&ctx->lock);
+	qdf_hlist_head_init(&ctx->bins[1].head);
+	qdf_seqcount_init(&ctx->bins[1].seq);
+
+	/* a toggled-in key should ... */
+	qdf_rcu_ut_toggle(ctx, 1);
+
+	/* ... be found with an extra reference held */
+	item = qdf_rcu_ut_find(ctx, 1);
+	QDF_BUG(item);
+	QDF_BUG(qdf_atomic_read(&item->ref_cnt) == 2);
+	qdf_rcu_ut_put(item);
+
+	/* ... not be found once toggled out again */
+	qdf_rcu_ut_toggle(ctx, 1);
+	QDF_BUG(!qdf_rcu_ut_find(ctx, 1));
+	QDF_BUG(qdf_hlist_empty(&ctx->bins[1].head));
+
+	qdf_rcu_barrier();
+	qdf_spinlock_destroy(&ctx->lock);
+	qdf_mem_free(ctx);
+
+	return 0;
+}
+
+uint32_t qdf_rcu_unit_test(void)
+{
+	uint32_t errors = 0;
+
+	errors += qdf_rcu_ut_single();
+	errors += qdf_rcu_ut_stress();
+
+	return errors;
+}
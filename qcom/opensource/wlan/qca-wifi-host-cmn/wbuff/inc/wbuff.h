@@ -114,6 +114,13 @@ qdf_nbuf_t wbuff_buff_get(struct wbuff_mod_handle *hdl, uint32_t len,
  */
 qdf_nbuf_t wbuff_buff_put(qdf_nbuf_t buf);
 
+/**
+ * wbuff_stats_print() - print pool watermarks and refill statistics
+ *
+ * Return: None
+ */
+void wbuff_stats_print(void);
+
 #else
 
 static inline QDF_STATUS wbuff_module_init(void)
@@ -151,5 +158,9 @@ wbuff_buff_put(qdf_nbuf_t buf)
 	return buf;
 }
 
+static inline void wbuff_stats_print(void)
+{
+}
+
 #endif
 #endif /* _WBUFF_H */
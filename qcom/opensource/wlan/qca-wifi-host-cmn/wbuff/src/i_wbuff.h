@@ -57,11 +57,14 @@
 #define WBUFF_PSLOT_SHIFT 1
 #define WBUFF_PSLOT_BITMASK 0xE
 
-/* Comparison array for maximum allocation per pool*/
-uint16_t wbuff_alloc_max[WBUFF_MAX_POOLS] = {WBUFF_POOL_0_MAX,
-					     WBUFF_POOL_1_MAX,
-					     WBUFF_POOL_2_MAX,
-					     WBUFF_POOL_3_MAX};
+/* Buffers a per-CPU magazine can hold */
+#define WBUFF_MAG_SIZE 8
+/* Buffers moved between a magazine and its pool at a time */
+#define WBUFF_MAG_BATCH (WBUFF_MAG_SIZE / 2)
+/* CPUs beyond this use the pool directly */
+#define WBUFF_MAG_MAX_CPUS 8
+/* Pools smaller than this are not worth caching in front of */
+#define WBUFF_MAG_MIN_POOL_SIZE (2 * WBUFF_MAG_SIZE * WBUFF_MAG_MAX_CPUS)
 
 /**
  * struct wbuff_handle - wbuff handle to the registered module
@@ -71,6 +74,40 @@ struct wbuff_handle {
 	uint8_t id;
 };
 
+/**
+ * struct wbuff_mag - per-CPU cache of free buffers of one pool
+ * @lock: magazine lock, only contended on deregistration
+ * @count: number of buffers in @bufs
+ * @bufs: cached buffers, used as a stack
+ *
+ * Buffers in a magazine have already been taken off the pool, so the
+ * module accounts them as pending returns. Each magazine has its own
+ * cache line so CPUs do not bounce each other's.
+ */
+struct wbuff_mag {
+	qdf_spinlock_t lock;
+	uint16_t count;
+	qdf_nbuf_t bufs[WBUFF_MAG_SIZE];
+} qdf_cacheline_aligned;
+
+/**
+ * struct wbuff_pool_stats - statistics of one pool of a module
+ * @size: number of buffers the pool was registered with
+ * @free: number of buffers currently in the pool
+ * @low_wm: lowest value @free has reached since registration
+ * @empty: requests that found the pool empty
+ * @mag_refill: magazine refills from the pool
+ * @mag_flush: magazine flushes back to the pool
+ */
+struct wbuff_pool_stats {
+	uint16_t size;
+	uint16_t free;
+	uint16_t low_wm;
+	uint32_t empty;
+	uint32_t mag_refill;
+	uint32_t mag_flush;
+};
+
 /**
  * struct wbuff_module - allocation holder for wbuff registered module
  * @registered: To identify whether module is registered
@@ -81,6 +118,8 @@ struct wbuff_handle {
  * @reserve: nbuf headroom to start with
  * @align: alignment for the nbuf
  * @pool[]: pools for all available buffers for the module
+ * @stats: per pool statistics, protected by @lock
+ * @mag: per-CPU magazines in front of each pool
  */
 struct wbuff_module {
 	bool registered;
@@ -90,6 +129,8 @@ struct wbuff_module {
 	int reserve;
 	int align;
 	qdf_nbuf_t pool[WBUFF_MAX_POOLS];
+	struct wbuff_pool_stats stats[WBUFF_MAX_POOLS];
+	struct wbuff_mag mag[WBUFF_MAX_POOLS][WBUFF_MAG_MAX_CPUS];
 };
 
 /**
@@ -100,4 +141,7 @@ struct wbuff_holder {
 	bool initialized;
 	struct wbuff_module mod[WBUFF_MAX_MODULES];
 };
+
+/* Allocation holder for all wbuff registered modules */
+extern struct wbuff_holder wbuff;
 #endif /* _WBUFF_H */
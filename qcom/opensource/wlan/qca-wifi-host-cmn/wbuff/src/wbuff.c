@@ -30,6 +30,12 @@
  */
 struct wbuff_holder wbuff;
 
+/* Comparison array for maximum allocation per pool*/
+static const uint16_t wbuff_alloc_max[WBUFF_MAX_POOLS] = {WBUFF_POOL_0_MAX,
+							  WBUFF_POOL_1_MAX,
+							  WBUFF_POOL_2_MAX,
+							  WBUFF_POOL_3_MAX};
+
 /**
  * wbuff_get_pool_slot_from_len() - get pool_slot from length
  * @len: length of the buffer
@@ -170,10 +176,150 @@ static bool wbuff_is_valid_handle(struct wbuff_handle *handle)
 	return false;
 }
 
+/**
+ * wbuff_pool_pop() - take buffers off a pool
+ * @mod: registered module
+ * @pslot: pool slot
+ * @bufs: array to fill with buffers
+ * @num: number of buffers wanted
+ *
+ * Caller must hold @mod->lock.
+ *
+ * Return: number of buffers placed in @bufs
+ */
+static uint16_t wbuff_pool_pop(struct wbuff_module *mod, uint8_t pslot,
+			       qdf_nbuf_t *bufs, uint16_t num)
+{
+	struct wbuff_pool_stats *stats = &mod->stats[pslot];
+	uint16_t cnt = 0;
+
+	while (cnt < num && mod->pool[pslot]) {
+		bufs[cnt] = mod->pool[pslot];
+		mod->pool[pslot] = qdf_nbuf_next(bufs[cnt]);
+		cnt++;
+	}
+
+	if (cnt < num)
+		stats->empty++;
+	stats->free -= cnt;
+	if (stats->free < stats->low_wm)
+		stats->low_wm = stats->free;
+	mod->pending_returns += cnt;
+
+	return cnt;
+}
+
+/**
+ * wbuff_pool_push() - give a chain of buffers back to a pool
+ * @mod: registered module
+ * @pslot: pool slot
+ * @head: first buffer of the chain
+ * @tail: last buffer of the chain
+ * @cnt: number of buffers in the chain
+ *
+ * Caller must hold @mod->lock.
+ *
+ * Return: None
+ */
+static void wbuff_pool_push(struct wbuff_module *mod, uint8_t pslot,
+			    qdf_nbuf_t head, qdf_nbuf_t tail, uint16_t cnt)
+{
+	qdf_nbuf_set_next(tail, mod->pool[pslot]);
+	mod->pool[pslot] = head;
+	mod->stats[pslot].free += cnt;
+	mod->pending_returns -= cnt;
+}
+
+/**
+ * wbuff_mag_get() - get the magazine of the current CPU for a pool
+ * @mod: registered module
+ * @pslot: pool slot
+ *
+ * Return: magazine or NULL if the pool is served without one
+ */
+static struct wbuff_mag *wbuff_mag_get(struct wbuff_module *mod,
+				       uint8_t pslot)
+{
+	int cpu;
+
+	if (mod->stats[pslot].size < WBUFF_MAG_MIN_POOL_SIZE)
+		return NULL;
+
+	cpu = qdf_get_cpu();
+	if (qdf_unlikely(cpu >= WBUFF_MAG_MAX_CPUS))
+		return NULL;
+
+	return &mod->mag[pslot][cpu];
+}
+
+/**
+ * wbuff_mag_flush() - give the older half of a full magazine to its pool
+ * @mod: registered module
+ * @pslot: pool slot
+ * @mag: full magazine
+ *
+ * Caller must hold @mag->lock.
+ *
+ * Return: true if the magazine has room again
+ *         false if the module went away and nothing was flushed
+ */
+static bool wbuff_mag_flush(struct wbuff_module *mod, uint8_t pslot,
+			    struct wbuff_mag *mag)
+{
+	uint16_t idx = 0;
+	bool flushed = false;
+
+	for (idx = 0; idx < WBUFF_MAG_BATCH - 1; idx++)
+		qdf_nbuf_set_next(mag->bufs[idx], mag->bufs[idx + 1]);
+
+	qdf_spin_lock_bh(&mod->lock);
+	if (mod->registered) {
+		wbuff_pool_push(mod, pslot, mag->bufs[0],
+				mag->bufs[WBUFF_MAG_BATCH - 1],
+				WBUFF_MAG_BATCH);
+		mod->stats[pslot].mag_flush++;
+		flushed = true;
+	}
+	qdf_spin_unlock_bh(&mod->lock);
+
+	if (!flushed)
+		return false;
+
+	mag->count -= WBUFF_MAG_BATCH;
+	qdf_mem_move(mag->bufs, &mag->bufs[WBUFF_MAG_BATCH],
+		     mag->count * sizeof(mag->bufs[0]));
+
+	return true;
+}
+
+/**
+ * wbuff_mag_drain() - free the buffers held in the magazines of a module
+ * @mod: module being deregistered
+ *
+ * Return: None
+ */
+static void wbuff_mag_drain(struct wbuff_module *mod)
+{
+	struct wbuff_mag *mag;
+	uint8_t pslot = 0;
+	int cpu;
+
+	for (pslot = 0; pslot < WBUFF_MAX_POOLS; pslot++) {
+		for (cpu = 0; cpu < WBUFF_MAG_MAX_CPUS; cpu++) {
+			mag = &mod->mag[pslot][cpu];
+			qdf_spin_lock_bh(&mag->lock);
+			while (mag->count)
+				qdf_nbuf_free(mag->bufs[--mag->count]);
+			qdf_spin_unlock_bh(&mag->lock);
+		}
+	}
+}
+
 QDF_STATUS wbuff_module_init(void)
 {
 	struct wbuff_module *mod = NULL;
 	uint8_t mslot = 0, pslot = 0;
+	int cpu;
 
 	if (!qdf_nbuf_is_dev_scratch_supported()) {
 		wbuff.initialized = false;
@@ -183,8 +329,13 @@ QDF_STATUS wbuff_module_init(void)
 	for (mslot = 0; mslot < WBUFF_MAX_MODULES; mslot++) {
 		mod = &wbuff.mod[mslot];
 		qdf_spinlock_create(&mod->lock);
-		for (pslot = 0; pslot < WBUFF_MAX_POOLS; pslot++)
+		for (pslot = 0; pslot < WBUFF_MAX_POOLS; pslot++) {
 			mod->pool[pslot] = NULL;
+			for (cpu = 0; cpu < WBUFF_MAG_MAX_CPUS; cpu++) {
+				qdf_spinlock_create(&mod->mag[pslot][cpu].lock);
+				mod->mag[pslot][cpu].count = 0;
+			}
+		}
 		mod->registered = false;
 	}
 	wbuff.initialized = true;
@@ -195,7 +346,8 @@ QDF_STATUS wbuff_module_init(void)
 QDF_STATUS wbuff_module_deinit(void)
 {
 	struct wbuff_module *mod = NULL;
-	uint8_t mslot = 0;
+	uint8_t mslot = 0, pslot = 0;
+	int cpu;
 
 	if (!wbuff.initialized)
 		return QDF_STATUS_E_INVAL;
@@ -206,6 +358,9 @@ QDF_STATUS wbuff_module_deinit(void)
 		if (mod->registered)
 			wbuff_module_deregister((struct wbuff_mod_handle *)
 						&mod->handle);
+		for (pslot = 0; pslot < WBUFF_MAX_POOLS; pslot++)
+			for (cpu = 0; cpu < WBUFF_MAG_MAX_CPUS; cpu++)
+				qdf_spinlock_destroy(&mod->mag[pslot][cpu].lock);
 		qdf_spinlock_destroy(&mod->lock);
 	}
 
@@ -238,6 +393,8 @@ wbuff_module_register(struct wbuff_alloc_request *req, uint8_t num,
 	mod = &wbuff.mod[mslot];
 
 	mod->handle.id = mslot;
+	mod->pending_returns = 0;
+	qdf_mem_zero(mod->stats, sizeof(mod->stats));
 
 	for (alloc = 0; alloc < num; alloc++) {
 		pslot = req[alloc].slot;
@@ -259,8 +416,13 @@ wbuff_module_register(struct wbuff_alloc_request *req, uint8_t num,
 				qdf_nbuf_set_next(buf, mod->pool[pslot]);
 				mod->pool[pslot] = buf;
 			}
+			mod->stats[pslot].size++;
 		}
 	}
+	for (pslot = 0; pslot < WBUFF_MAX_POOLS; pslot++) {
+		mod->stats[pslot].free = mod->stats[pslot].size;
+		mod->stats[pslot].low_wm = mod->stats[pslot].size;
+	}
 	mod->reserve = reserve;
 	mod->align = align;
 
@@ -290,10 +452,16 @@ QDF_STATUS wbuff_module_deregister(struct wbuff_mod_handle *hdl)
 			first = qdf_nbuf_next(buf);
 			qdf_nbuf_free(buf);
 		}
+		mod->pool[pslot] = NULL;
 	}
 	mod->registered = false;
 	qdf_spin_unlock_bh(&mod->lock);
 
+	/* puts check @registered under the magazine lock, so none can
+	 * park a buffer in a magazine once it has been drained
+	 */
+	wbuff_mag_drain(mod);
+
 	return QDF_STATUS_SUCCESS;
 }
 
@@ -302,6 +470,7 @@ qdf_nbuf_t wbuff_buff_get(struct wbuff_mod_handle *hdl, uint32_t len,
 {
 	struct wbuff_handle *handle;
 	struct wbuff_module *mod = NULL;
+	struct wbuff_mag *mag;
 	uint8_t mslot = 0;
 	uint8_t pslot = 0;
 	qdf_nbuf_t buf = NULL;
@@ -316,13 +485,25 @@ qdf_nbuf_t wbuff_buff_get(struct wbuff_mod_handle *hdl, uint32_t len,
 	pslot = wbuff_get_pool_slot_from_len(len);
 	mod = &wbuff.mod[mslot];
 
-	qdf_spin_lock_bh(&mod->lock);
-	if (mod->pool[pslot]) {
-		buf = mod->pool[pslot];
-		mod->pool[pslot] = qdf_nbuf_next(buf);
-		mod->pending_returns++;
+	mag = wbuff_mag_get(mod, pslot);
+	if (mag) {
+		qdf_spin_lock_bh(&mag->lock);
+		if (!mag->count) {
+			qdf_spin_lock_bh(&mod->lock);
+			mag->count = wbuff_pool_pop(mod, pslot, mag->bufs,
+						    WBUFF_MAG_BATCH);
+			mod->stats[pslot].mag_refill++;
+			qdf_spin_unlock_bh(&mod->lock);
+		}
+		if (mag->count)
+			buf = mag->bufs[--mag->count];
+		qdf_spin_unlock_bh(&mag->lock);
+	} else {
+		qdf_spin_lock_bh(&mod->lock);
+		if (!wbuff_pool_pop(mod, pslot, &buf, 1))
+			buf = NULL;
+		qdf_spin_unlock_bh(&mod->lock);
 	}
-	qdf_spin_unlock_bh(&mod->lock);
 	if (buf) {
 		qdf_nbuf_set_next(buf, NULL);
 		qdf_net_buf_debug_update_node(buf, func_name, line_num);
@@ -334,6 +515,8 @@ qdf_nbuf_t wbuff_buff_get(struct wbuff_mod_handle *hdl, uint32_t len,
 qdf_nbuf_t wbuff_buff_put(qdf_nbuf_t buf)
 {
 	qdf_nbuf_t buffer = buf;
+	struct wbuff_module *mod = NULL;
+	struct wbuff_mag *mag;
 	unsigned long slot_info = 0;
 	uint8_t mslot = 0, pslot = 0;
 
@@ -350,16 +533,65 @@ qdf_nbuf_t wbuff_buff_put(qdf_nbuf_t buf)
 	if (mslot >= WBUFF_MAX_MODULES || pslot >= WBUFF_MAX_POOLS)
 		return NULL;
 
-	qdf_nbuf_reset(buffer, wbuff.mod[mslot].reserve, wbuff.mod[mslot].
-		       align);
-	qdf_spin_lock_bh(&wbuff.mod[mslot].lock);
-	if (wbuff.mod[mslot].registered) {
-		qdf_nbuf_set_next(buffer, wbuff.mod[mslot].pool[pslot]);
-		wbuff.mod[mslot].pool[pslot] = buffer;
-		wbuff.mod[mslot].pending_returns--;
+	mod = &wbuff.mod[mslot];
+	qdf_nbuf_reset(buffer, mod->reserve, mod->align);
+
+	mag = wbuff_mag_get(mod, pslot);
+	if (mag) {
+		qdf_spin_lock_bh(&mag->lock);
+		if (mod->registered &&
+		    (mag->count < WBUFF_MAG_SIZE ||
+		     wbuff_mag_flush(mod, pslot, mag))) {
+			mag->bufs[mag->count++] = buffer;
+			buffer = NULL;
+		}
+		qdf_spin_unlock_bh(&mag->lock);
+
+		return buffer;
+	}
+
+	qdf_spin_lock_bh(&mod->lock);
+	if (mod->registered) {
+		wbuff_pool_push(mod, pslot, buffer, buffer, 1);
 		buffer = NULL;
 	}
-	qdf_spin_unlock_bh(&wbuff.mod[mslot].lock);
+	qdf_spin_unlock_bh(&mod->lock);
 
 	return buffer;
 }
+
+void wbuff_stats_print(void)
+{
+	struct wbuff_pool_stats stats[WBUFF_MAX_POOLS];
+	struct wbuff_module *mod = NULL;
+	uint16_t pending_returns = 0;
+	uint8_t mslot = 0, pslot = 0;
+
+	if (!wbuff.initialized)
+		return;
+
+	for (mslot = 0; mslot < WBUFF_MAX_MODULES; mslot++) {
+		mod = &wbuff.mod[mslot];
+		qdf_spin_lock_bh(&mod->lock);
+		if (!mod->registered) {
+			qdf_spin_unlock_bh(&mod->lock);
+			continue;
+		}
+		qdf_mem_copy(stats, mod->stats, sizeof(stats));
+		pending_returns = mod->pending_returns;
+		qdf_spin_unlock_bh(&mod->lock);
+
+		qdf_nofl_info("wbuff module %u: pending_returns %u", mslot,
+			      pending_returns);
+		for (pslot = 0; pslot < WBUFF_MAX_POOLS; pslot++) {
+			if (!stats[pslot].size)
+				continue;
+			qdf_nofl_info("  pool %u: size %u free %u low_wm %u empty %u mag_refill %u mag_flush %u",
+				      pslot, stats[pslot].size,
+				      stats[pslot].free, stats[pslot].low_wm,
+				      stats[pslot].empty,
+				      stats[pslot].mag_refill,
+				      stats[pslot].mag_flush);
+		}
+	}
+}
@@ -0,0 +1,221 @@
+/*
+ * Copyright (c) 2026 Qualcomm Innovation Center, Inc. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted, provided that the
+ * above copyright notice and this permission notice appear in all
+ * copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#include <qdf_defer.h>
+#include <qdf_mem.h>
+#include <qdf_nbuf.h>
+#include <qdf_trace.h>
+#include <qdf_util.h>
+#include <wbuff.h>
+#include "../src/i_wbuff.h"
+#include "wbuff_test.h"
+
+/* magazines are only put in front of pools of this size */
+#define wbuff_ut_mag_pool_size WBUFF_MAG_MIN_POOL_SIZE
+#define wbuff_ut_pool_size 8
+#define wbuff_ut_len WBUFF_LEN_POOL0
+
+static struct wbuff_module *wbuff_ut_mod(struct wbuff_mod_handle *hdl)
+{
+	return &wbuff.mod[((struct wbuff_handle *)hdl)->id];
+}
+
+static struct wbuff_mod_handle *wbuff_ut_register(uint16_t size)
+{
+	struct wbuff_alloc_request req = {
+		.slot = WBUFF_POOL_0,
+		.size = size,
+	};
+	struct wbuff_mod_handle *hdl;
+
+	hdl = wbuff_module_register(&req, 1, 0, 4);
+	if (!hdl)
+		return NULL;
+
+	if (wbuff_ut_mod(hdl)->stats[WBUFF_POOL_0].size != size) {
+		wbuff_module_deregister(hdl);
+		return NULL;
+	}
+
+	return hdl;
+}
+
+static uint32_t wbuff_ut_mag_refill_flush(void)
+{
+	qdf_nbuf_t bufs[WBUFF_MAG_SIZE + 2];
+	struct wbuff_mod_handle *hdl;
+	struct wbuff_module *mod;
+	struct wbuff_pool_stats *stats;
+	struct wbuff_mag *mag;
+	qdf_nbuf_t left;
+	uint32_t errors = 0;
+	uint16_t i;
+	int cpu;
+
+	hdl = wbuff_ut_register(wbuff_ut_mag_pool_size);
+	if (!hdl)
+		return 1;
+
+	mod = wbuff_ut_mod(hdl);
+	stats = &mod->stats[WBUFF_POOL_0];
+
+	/* stay on one CPU so every get and put sees the same magazine */
+	qdf_local_bh_disable();
+	cpu = qdf_get_cpu();
+	if (cpu >= WBUFF_MAG_MAX_CPUS) {
+		qdf_local_bh_enable();
+		wbuff_module_deregister(hdl);
+		return 0;
+	}
+	mag = &mod->mag[WBUFF_POOL_0][cpu];
+
+	for (i = 0; i < QDF_ARRAY_SIZE(bufs); i++) {
+		bufs[i] = wbuff_buff_get(hdl, wbuff_ut_len, __func__,
+					 __LINE__);
+		if (!bufs[i])
+			errors++;
+	}
+
+	/* each empty magazine takes a batch off the pool */
+	if (stats->mag_refill != 3 ||
+	    stats->free != wbuff_ut_mag_pool_size - 3 * WBUFF_MAG_BATCH ||
+	    mag->count != 3 * WBUFF_MAG_BATCH - QDF_ARRAY_SIZE(bufs))
+		errors++;
+
+	/* a put into a full magazine gives its older half to the pool */
+	for (i = 0; i < QDF_ARRAY_SIZE(bufs) - 1; i++) {
+		if (bufs[i] && wbuff_buff_put(bufs[i]))
+			errors++;
+	}
+	left = bufs[i];
+	qdf_local_bh_enable();
+
+	if (stats->mag_flush != 1 ||
+	    stats->free != wbuff_ut_mag_pool_size - 2 * WBUFF_MAG_BATCH ||
+	    mag->count != WBUFF_MAG_SIZE - 1 ||
+	    mod->pending_returns != mag->count + 1)
+		errors++;
+
+	/* deregistration frees the buffers parked in the magazines */
+	if (wbuff_module_deregister(hdl) != QDF_STATUS_SUCCESS)
+		errors++;
+	if (mag->count)
+		errors++;
+
+	/* and a buffer still out is no longer taken back */
+	if (left && wbuff_buff_put(left) != left)
+		errors++;
+
+	QDF_BUG(!errors);
+	qdf_nbuf_free(left);
+
+	return errors;
+}
+
+static uint32_t wbuff_ut_put_unregistered(void)
+{
+	qdf_nbuf_t a[4], b[2];
+	struct wbuff_mod_handle *hdl_a, *hdl_b;
+	qdf_nbuf_t foreign;
+	uint32_t errors = 0;
+	uint16_t i;
+
+	qdf_mem_zero(a, sizeof(a));
+	qdf_mem_zero(b, sizeof(b));
+	hdl_a = wbuff_ut_register(wbuff_ut_pool_size);
+	hdl_b = wbuff_ut_register(wbuff_ut_pool_size);
+	foreign = qdf_nbuf_alloc(NULL, wbuff_ut_len, 0, 4, false);
+	if (!hdl_a || !hdl_b || !foreign)
+		goto fail;
+
+	for (i = 0; i < QDF_ARRAY_SIZE(a); i++) {
+		a[i] = wbuff_buff_get(hdl_a, wbuff_ut_len, __func__, __LINE__);
+		if (!a[i])
+			goto fail;
+	}
+
+	for (i = 0; i < QDF_ARRAY_SIZE(b); i++) {
+		b[i] = wbuff_buff_get(hdl_b, wbuff_ut_len, __func__, __LINE__);
+		if (!b[i])
+			goto fail;
+	}
+
+	/* buffers of module b come back while it is gone */
+	wbuff_module_deregister(hdl_b);
+	hdl_b = NULL;
+
+	/* only the buffers of module a are consumed */
+	if (wbuff_buff_put(foreign) != foreign)
+		errors++;
+
+	for (i = 0; i < QDF_ARRAY_SIZE(b); i++) {
+		if (wbuff_buff_put(b[i]) != b[i])
+			errors++;
+	}
+
+	for (i = 0; i < QDF_ARRAY_SIZE(a); i++) {
+		if (wbuff_buff_put(a[i]))
+			errors++;
+		a[i] = NULL;
+	}
+
+	if (wbuff_ut_mod(hdl_a)->stats[WBUFF_POOL_0].free !=
+	    wbuff_ut_pool_size || wbuff_ut_mod(hdl_a)->pending_returns)
+		errors++;
+
+	QDF_BUG(!errors);
+	for (i = 0; i < QDF_ARRAY_SIZE(b); i++)
+		qdf_nbuf_free(b[i]);
+	qdf_nbuf_free(foreign);
+	wbuff_module_deregister(hdl_a);
+
+	return errors;
+
+fail:
+	for (i = 0; i < QDF_ARRAY_SIZE(a); i++) {
+		if (a[i])
+			wbuff_buff_put(a[i]);
+	}
+	if (hdl_b) {
+		for (i = 0; i < QDF_ARRAY_SIZE(b); i++) {
+			if (b[i])
+				wbuff_buff_put(b[i]);
+		}
+		wbuff_module_deregister(hdl_b);
+	}
+	if (foreign)
+		qdf_nbuf_free(foreign);
+	if (hdl_a)
+		wbuff_module_deregister(hdl_a);
+
+	return 1;
+}
+
+uint32_t wbuff_unit_test(void)
+{
+	uint32_t errors = 0;
+
+	/* wbuff is not brought up on platforms without dev_scratch */
+	if (!wbuff.initialized)
+		return 0;
+
+	errors += wbuff_ut_mag_refill_flush();
+	errors += wbuff_ut_put_unregistered();
+
+	return errors;
+}
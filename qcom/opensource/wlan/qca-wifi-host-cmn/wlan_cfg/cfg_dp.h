@@ -162,6 +162,10 @@
 #define WLAN_CFG_RX_PENDING_LO_THRESHOLD_MIN 100
 #define WLAN_CFG_RX_PENDING_LO_THRESHOLD_MAX 0x200000
 
+#define WLAN_CFG_RX_PREFETCH_DEPTH 6
+#define WLAN_CFG_RX_PREFETCH_DEPTH_MIN 3
+#define WLAN_CFG_RX_PREFETCH_DEPTH_MAX 32
+
 #define WLAN_CFG_INT_TIMER_THRESHOLD_WBM_RELEASE_RING 256
 #define WLAN_CFG_INT_TIMER_THRESHOLD_REO_RING 512
 #define WLAN_CFG_INT_BATCH_THRESHOLD_REO_RING 0
@@ -788,6 +792,29 @@
 		WLAN_CFG_RX_PENDING_LO_THRESHOLD, \
 		CFG_VALUE_OR_DEFAULT, "DP rx pending lo threshold")
 
+/*
+ * <ini>
+ * dp_rx_prefetch_depth - Number of REO ring entries prefetched ahead
+ * of the entry being reaped
+ * @Min: 3
+ * @Max: 32
+ * @Default: 6
+ *
+ * The ring descriptor, the SW Rx descriptor and the nbuf of an entry are
+ * prefetched in turn as it gets closer to the reap point, so a larger
+ * depth gives each stage more time to complete.
+ *
+ * Usage: Internal
+ *
+ * </ini>
+ */
+#define CFG_DP_RX_PREFETCH_DEPTH \
+		CFG_INI_UINT("dp_rx_prefetch_depth", \
+		WLAN_CFG_RX_PREFETCH_DEPTH_MIN, \
+		WLAN_CFG_RX_PREFETCH_DEPTH_MAX, \
+		WLAN_CFG_RX_PREFETCH_DEPTH, \
+		CFG_VALUE_OR_DEFAULT, "DP rx prefetch depth")
+
 #define CFG_DP_BASE_HW_MAC_ID \
 		CFG_INI_UINT("dp_base_hw_macid", \
 		0, 1, 1, \
@@ -1453,6 +1480,26 @@
 	CFG_INI_BOOL("dp_rx_refill_buff_pool", false, \
 		     "Enable/Disable DP RX refill buffer pool support")
 
+/*
+ * <ini>
+ * dp_rx_sg_page_frag - Attach continuation buffers of a scattered MSDU
+ * as page frags of the first buffer
+ * @Default: false
+ *
+ * When an MSDU spans several Rx buffers, the buffers after the first one
+ * are normally chained on the frag_list of the first. With this set, their
+ * data pages are attached as page frags instead, so the stack gets a
+ * single nbuf it can pull headers from and GRO can merge. Buffers that
+ * can not be attached without a copy are still chained on the frag_list.
+ *
+ * Usage: Internal
+ *
+ * </ini>
+ */
+#define CFG_DP_RX_SG_PAGE_FRAG \
+	CFG_INI_BOOL("dp_rx_sg_page_frag", false, \
+		     "Enable/Disable DP RX scattered MSDU page frags")
+
 #define CFG_DP_POLL_MODE_ENABLE \
 		CFG_INI_BOOL("dp_poll_mode_enable", false, \
 		"Enable/Disable Polling mode for data path")
@@ -1915,6 +1962,8 @@
 		CFG(CFG_DP_RX_REFILL_BUFF_POOL_ENABLE) \
 		CFG(CFG_DP_RX_PENDING_HL_THRESHOLD) \
 		CFG(CFG_DP_RX_PENDING_LO_THRESHOLD) \
+		CFG(CFG_DP_RX_PREFETCH_DEPTH) \
+		CFG(CFG_DP_RX_SG_PAGE_FRAG) \
 		CFG(CFG_DP_LEGACY_MODE_CSUM_DISABLE) \
 		CFG(CFG_DP_POLL_MODE_ENABLE) \
 		CFG(CFG_DP_SWLM_ENABLE) \
@@ -3034,6 +3034,9 @@ wlan_cfg_soc_attach(struct cdp_ctrl_objmgr_psoc *psoc)
 			cfg_get(psoc, CFG_DP_RX_PENDING_HL_THRESHOLD);
 	wlan_cfg_ctx->rx_pending_low_threshold =
 			cfg_get(psoc, CFG_DP_RX_PENDING_LO_THRESHOLD);
+	wlan_cfg_ctx->rx_prefetch_depth =
+			cfg_get(psoc, CFG_DP_RX_PREFETCH_DEPTH);
+	wlan_cfg_ctx->rx_sg_page_frag = cfg_get(psoc, CFG_DP_RX_SG_PAGE_FRAG);
 	wlan_cfg_ctx->is_poll_mode_enabled =
 			cfg_get(psoc, CFG_DP_POLL_MODE_ENABLE);
 	wlan_cfg_ctx->is_swlm_enabled = cfg_get(psoc, CFG_DP_SWLM_ENABLE);
@@ -3419,6 +3422,16 @@ wlan_cfg_rx_pending_lo_threshold(struct wlan_cfg_dp_soc_ctxt *cfg)
 	return cfg->rx_pending_low_threshold;
 }
 
+uint8_t wlan_cfg_get_rx_prefetch_depth(struct wlan_cfg_dp_soc_ctxt *cfg)
+{
+	return cfg->rx_prefetch_depth;
+}
+
+bool wlan_cfg_is_rx_sg_page_frag_enabled(struct wlan_cfg_dp_soc_ctxt *cfg)
+{
+	return cfg->rx_sg_page_frag;
+}
+
 int wlan_cfg_per_pdev_lmac_ring(struct wlan_cfg_dp_soc_ctxt *cfg)
 {
 	return cfg->per_pdev_lmac_ring;
@@ -283,6 +283,10 @@ struct wlan_srng_cfg {
  *                           pool support
  * @rx_pending_high_threshold: threshold of starting pkt drop
  * @rx_pending_low_threshold: threshold of stopping pkt drop
+ * @rx_prefetch_depth: number of REO ring entries prefetched ahead of the
+ *                     entry being reaped
+ * @rx_sg_page_frag: attach continuation buffers of scattered MSDUs as
+ *                   page frags instead of a frag_list
  * @is_poll_mode_enabled:
  * @is_swlm_enabled: flag to enable/disable SWLM
  * @fst_in_cmem:
@@ -458,6 +462,8 @@ struct wlan_cfg_dp_soc_ctxt {
 	bool is_rx_refill_buff_pool_enabled;
 	uint32_t rx_pending_high_threshold;
 	uint32_t rx_pending_low_threshold;
+	uint8_t rx_prefetch_depth;
+	bool rx_sg_page_frag;
 	bool is_poll_mode_enabled;
 	uint8_t is_swlm_enabled;
 	bool fst_in_cmem;
@@ -1289,6 +1295,23 @@ wlan_cfg_rx_pending_hl_threshold(struct wlan_cfg_dp_soc_ctxt *cfg);
 uint32_t
 wlan_cfg_rx_pending_lo_threshold(struct wlan_cfg_dp_soc_ctxt *cfg);
 
+/**
+ * wlan_cfg_get_rx_prefetch_depth() - Return the REO ring prefetch depth
+ * @cfg: soc configuration context
+ *
+ * Return: rx_prefetch_depth
+ */
+uint8_t wlan_cfg_get_rx_prefetch_depth(struct wlan_cfg_dp_soc_ctxt *cfg);
+
+/**
+ * wlan_cfg_is_rx_sg_page_frag_enabled() - Check if scattered MSDUs are
+ * assembled with page frags
+ * @cfg: soc configuration context
+ *
+ * Return: true if enabled, false otherwise
+ */
+bool wlan_cfg_is_rx_sg_page_frag_enabled(struct wlan_cfg_dp_soc_ctxt *cfg);
+
 /**
  * wlan_cfg_get_num_mac_rings() - Return the number of MAC RX DMA rings
  * per pdev
@@ -11208,6 +11208,7 @@ static void hdd_display_stats_help(void)
 	HDD_DUMP_STAT_HELP(CDP_NAPI_STATS);
 	HDD_DUMP_STAT_HELP(CDP_DP_NAPI_STATS);
 	HDD_DUMP_STAT_HELP(CDP_DP_RX_THREAD_STATS);
+	HDD_DUMP_STAT_HELP(CDP_WBUFF_STATS);
 }
 
 int hdd_wlan_dump_stats(struct hdd_adapter *adapter, int stats_id)
@@ -11242,6 +11243,9 @@ int hdd_wlan_dump_stats(struct hdd_adapter *adapter, int stats_id)
 		sme_display_disconnect_stats(hdd_ctx->mac_handle,
 					     adapter->vdev_id);
 		break;
+	case CDP_WBUFF_STATS:
+		wbuff_stats_print();
+		break;
 	default:
 		status = cdp_display_stats(cds_get_context(QDF_MODULE_ID_SOC),
 					   stats_id,
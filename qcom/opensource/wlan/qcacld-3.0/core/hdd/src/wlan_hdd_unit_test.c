@@ -23,16 +23,24 @@
  * debugfs unit_test_host
  */
 #include "wlan_hdd_main.h"
+#include "dp_peer_rx_stats_test.h"
+#include "dp_rx_defrag_test.h"
+#include "dp_rx_mon_ppdu_ring_test.h"
+#include "hal_rx_flow_test.h"
+#include "hal_srng_test.h"
 #include "qdf_delayed_work_test.h"
 #include "qdf_hashtable_test.h"
+#include "qdf_nbuf_test.h"
 #include "qdf_periodic_work_test.h"
 #include "qdf_ptr_hash_test.h"
+#include "qdf_rcu_test.h"
 #include "qdf_slist_test.h"
 #include "qdf_talloc_test.h"
 #include "qdf_str.h"
 #include "qdf_trace.h"
 #include "qdf_tracker_test.h"
 #include "qdf_types_test.h"
+#include "wbuff_test.h"
 #include "wlan_dsc_test.h"
 #include "wlan_hdd_unit_test.h"
 
@@ -45,15 +53,25 @@ struct hdd_ut_entry {
 
 struct hdd_ut_entry hdd_ut_entries[] = {
 	{ .name = "dsc", .callback = dsc_unit_test },
+	{ .name = "dp_peer_rx_stats",
+	  .callback = dp_peer_rx_stats_unit_test },
+	{ .name = "dp_rx_defrag", .callback = dp_rx_defrag_unit_test },
+	{ .name = "dp_rx_mon_ppdu_ring",
+	  .callback = dp_rx_mon_ppdu_ring_unit_test },
+	{ .name = "hal_rx_flow", .callback = hal_rx_flow_unit_test },
+	{ .name = "hal_srng", .callback = hal_srng_unit_test },
 	{ .name = "qdf_delayed_work", .callback = qdf_delayed_work_unit_test },
 	{ .name = "qdf_ht", .callback = qdf_ht_unit_test },
+	{ .name = "qdf_nbuf", .callback = qdf_nbuf_unit_test },
 	{ .name = "qdf_periodic_work",
 	  .callback = qdf_periodic_work_unit_test },
 	{ .name = "qdf_ptr_hash", .callback = qdf_ptr_hash_unit_test },
+	{ .name = "qdf_rcu", .callback = qdf_rcu_unit_test },
 	{ .name = "qdf_slist", .callback = qdf_slist_unit_test },
 	{ .name = "qdf_talloc", .callback = qdf_talloc_unit_test },
 	{ .name = "qdf_tracker", .callback = qdf_tracker_unit_test },
 	{ .name = "qdf_types", .callback = qdf_types_unit_test },
+	{ .name = "wbuff", .callback = wbuff_unit_test },
 };
 
 #define hdd_for_each_ut_entry(cursor) \
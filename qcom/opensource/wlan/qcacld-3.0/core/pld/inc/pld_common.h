@@ -1198,6 +1198,20 @@ static inline int pld_nbuf_pre_alloc_free(struct sk_buff *skb)
 {
 	return wcnss_skb_prealloc_put(skb);
 }
+
+/**
+ * pld_nbuf_may_be_pre_alloc() - check if an nbuf may be from platform driver
+ * @skb: Pointer to network buffer
+ *
+ * Only requests of at least WCNSS_PRE_SKB_ALLOC_GET_THRESHOLD bytes are
+ * served by the platform driver, so a smaller buffer never is.
+ *
+ * Return: true if @skb may have been allocated in platform driver
+ */
+static inline bool pld_nbuf_may_be_pre_alloc(struct sk_buff *skb)
+{
+	return skb_end_offset(skb) >= WCNSS_PRE_SKB_ALLOC_GET_THRESHOLD;
+}
 #else
 static inline struct sk_buff *pld_nbuf_pre_alloc(size_t size)
 {
@@ -1207,6 +1221,10 @@ static inline int pld_nbuf_pre_alloc_free(struct sk_buff *skb)
 {
 	return 0;
 }
+static inline bool pld_nbuf_may_be_pre_alloc(struct sk_buff *skb)
+{
+	return false;
+}
 #endif
 /**
  * pld_get_bus_type() - Bus type of the device